@@ -0,0 +1,463 @@
+// Benchmarks for the kernels behind multiallele_utils.cpp, run without R.
+//
+// Each kernel is timed over a sweep of ploidy 2 to 12 and 2 to 10 alleles,
+// and for the probability functions, read depths from 10 to 10000.  Gamete
+// and selfing kernels only run for even ploidies.  For every case the number
+// of calls per batch is calibrated so that a batch takes at least --min-time
+// seconds, and the median time per call over --reps batches is reported,
+// along with heap allocations per call (counted by replacing operator new),
+// calls per second, and items per second, where an item is one genotype for
+// enumeration and selfing, one gamete for makeGametes, and one call
+// otherwise.
+//
+// Results are written as CSV.  With --baseline, the results are compared
+// with an earlier CSV from this program, and the exit status is 1 if any
+// case is slower, or allocates more, by more than --threshold.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ploidyverse/genotype_tables.h"
+#include "ploidyverse/gamete_kernels.h"
+#include "ploidyverse/likelihood_kernels.h"
+#include "ploidyverse/selfing_kernels.h"
+
+static std::atomic<unsigned long long> allocCount(0);
+static std::atomic<unsigned long long> allocBytes(0);
+
+// Counting allocator.  The array and sized forms are replaced as well, so
+// that every new and delete pair goes through the same functions.  malloc and
+// free are kept out of line, since otherwise GCC's -Wmismatched-new-delete
+// sees free called on memory from operator new once these are inlined.
+__attribute__((noinline)) void* countedAlloc(std::size_t n){
+  allocCount++;
+  allocBytes += n;
+  void* p = std::malloc(n > 0 ? n : 1);
+  if(p == NULL) throw std::bad_alloc();
+  return p;
+}
+
+__attribute__((noinline)) void countedFree(void* p) noexcept { std::free(p); }
+
+void* operator new(std::size_t n){ return countedAlloc(n); }
+void* operator new[](std::size_t n){ return countedAlloc(n); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+
+namespace {
+
+struct Options {
+  double minTime = 0.01;
+  int reps = 5;
+  std::string filter;
+  std::string output;
+  std::string baseline;
+  double threshold = 0.10;
+  unsigned long long maxGenotypes = 1000000;
+  unsigned long long maxSelfingGenotypes = 5000;
+  unsigned long long maxDenseSelfingGenotypes = 1000;
+};
+
+struct Result {
+  std::string kernel;
+  int ploidy;
+  int nalleles;
+  int depth;             // 0 where read depth does not apply
+  double nsPerCall;
+  double allocsPerCall;
+  double bytesPerCall;
+  double callsPerSec;
+  double itemsPerSec;
+};
+
+volatile double sink;
+
+// One benchmark case: run(n) makes n calls and returns the number of items
+// processed.
+struct Case {
+  std::string kernel;
+  int ploidy;
+  int nalleles;
+  int depth;
+  std::function<double(long)> run;
+};
+
+double seconds(std::chrono::steady_clock::time_point a,
+               std::chrono::steady_clock::time_point b){
+  return std::chrono::duration<double>(b - a).count();
+}
+
+Result measure(const Case& c, const Options& opt){
+  c.run(1); // warm up caches and lookup tables
+  long n = 1;
+  for(;;){
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    c.run(n);
+    double t = seconds(t0, std::chrono::steady_clock::now());
+    if(t >= opt.minTime || n >= (1L << 30)) break;
+    n = t > 0 ? std::max(n * 2, (long)(n * 1.2 * opt.minTime / t)) : n * 10;
+  }
+  std::vector<double> times;
+  double items = 0;
+  unsigned long long count0 = 0, bytes0 = 0, count1 = 0, bytes1 = 0;
+  for(int r = 0; r < opt.reps; r++){
+    count0 = allocCount;
+    bytes0 = allocBytes;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    items = c.run(n);
+    times.push_back(seconds(t0, std::chrono::steady_clock::now()));
+    count1 = allocCount;
+    bytes1 = allocBytes;
+  }
+  std::sort(times.begin(), times.end());
+  const double t = times[times.size() / 2];
+  Result out;
+  out.kernel = c.kernel;
+  out.ploidy = c.ploidy;
+  out.nalleles = c.nalleles;
+  out.depth = c.depth;
+  out.nsPerCall = t * 1e9 / n;
+  out.allocsPerCall = (double)(count1 - count0) / n;
+  out.bytesPerCall = (double)(bytes1 - bytes0) / n;
+  out.callsPerSec = n / t;
+  out.itemsPerSec = items / t;
+  return out;
+}
+
+// A random genotype with alleles in ascending order.
+std::vector<int> randomGenotype(int ploidy, int nalleles, std::mt19937& rng){
+  std::uniform_int_distribution<int> allele(0, nalleles - 1);
+  std::vector<int> out(ploidy);
+  for(int i = 0; i < ploidy; i++) out[i] = allele(rng);
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+// Read counts and expected allele proportions for samples of one genotype,
+// as used when computing genotype likelihoods.
+void readCounts(int ploidy, int nalleles, int depth, int nsets, std::mt19937& rng,
+                std::vector<double>& x, std::vector<double>& prob){
+  x.assign((std::size_t)nsets * nalleles, 0);
+  prob.assign((std::size_t)nsets * nalleles, 0);
+  const double error = 0.001;
+  for(int s = 0; s < nsets; s++){
+    std::vector<int> geno = randomGenotype(ploidy, nalleles, rng);
+    double* p = &prob[(std::size_t)s * nalleles];
+    for(int i = 0; i < ploidy; i++) p[geno[i]] += 1.0 / ploidy;
+    for(int a = 0; a < nalleles; a++) p[a] = (1 - error) * p[a] + error / nalleles;
+    std::discrete_distribution<int> read(p, p + nalleles);
+    for(int d = 0; d < depth; d++) x[(std::size_t)s * nalleles + read(rng)]++;
+  }
+}
+
+std::vector<Case> makeCases(const Options& opt){
+  static const int depths[] = {10, 100, 1000, 10000};
+  const int nsets = 64;
+  std::vector<Case> out;
+  for(int ploidy = 2; ploidy <= 12; ploidy++){
+    for(int nal = 2; nal <= 10; nal++){
+      const unsigned long long ngen = ploidyverse::countGenotypes(ploidy, nal);
+      std::mt19937 rng(1000 * ploidy + nal);
+
+      for(int d = 0; d < 4; d++){
+        const int depth = depths[d];
+        std::shared_ptr<std::vector<double> > x(new std::vector<double>());
+        std::shared_ptr<std::vector<double> > prob(new std::vector<double>());
+        readCounts(ploidy, nal, depth, nsets, rng, *x, *prob);
+        out.push_back(Case{"dmultinom", ploidy, nal, depth, [=](long n){
+          double s = 0;
+          for(long i = 0; i < n; i++){
+            const std::size_t k = (std::size_t)(i % nsets) * nal;
+            s += std::exp(ploidyverse::logMultinom(&(*x)[k], &(*prob)[k], nal));
+          }
+          sink = s;
+          return (double)n;
+        }});
+        out.push_back(Case{"dDirichletMultinom", ploidy, nal, depth, [=](long n){
+          double s = 0;
+          for(long i = 0; i < n; i++){
+            const std::size_t k = (std::size_t)(i % nsets) * nal;
+            s += std::exp(ploidyverse::logDirichletMultinom(&(*x)[k], &(*prob)[k],
+                                                            nal, 9));
+          }
+          sink = s;
+          return (double)n;
+        }});
+      }
+
+      if(ngen <= opt.maxGenotypes){
+        // as called from R: a cached table copied into a new matrix
+        out.push_back(Case{"enumerateGenotypes", ploidy, nal, 0, [=](long n){
+          for(long i = 0; i < n; i++){
+            ploidyverse::GenotypeTable tab = ploidyverse::genotypeTable(ploidy, nal);
+            std::vector<int> m(tab.row(0), tab.row(0) + (std::size_t)tab.ngen * ploidy);
+            sink = m.back();
+          }
+          return (double)n * ngen;
+        }});
+        // the enumeration itself, bypassing the cache
+        std::shared_ptr<std::vector<int> > buf(new std::vector<int>(ngen * ploidy));
+        out.push_back(Case{"enumerateGenotypesInto", ploidy, nal, 0, [=](long n){
+          for(long i = 0; i < n; i++){
+            ploidyverse::enumerateGenotypesInto(ploidy, nal, buf->data());
+            sink = buf->back();
+          }
+          return (double)n * ngen;
+        }});
+      }
+
+      if(ploidyverse::canRankGenotypes(ploidy, nal - 1)){
+        std::shared_ptr<std::vector<int> > genos(new std::vector<int>());
+        std::shared_ptr<std::vector<unsigned long long> >
+          index(new std::vector<unsigned long long>());
+        std::uniform_int_distribution<unsigned long long> rank(0, ngen - 1);
+        for(int s = 0; s < nsets; s++){
+          std::vector<int> g = randomGenotype(ploidy, nal, rng);
+          genos->insert(genos->end(), g.begin(), g.end());
+          index->push_back(rank(rng));
+        }
+        out.push_back(Case{"indexGenotype", ploidy, nal, 0, [=](long n){
+          unsigned long long s = 0;
+          for(long i = 0; i < n; i++){
+            s += ploidyverse::rankGenotype(&(*genos)[(std::size_t)(i % nsets) * ploidy],
+                                           ploidy);
+          }
+          sink = s;
+          return (double)n;
+        }});
+        out.push_back(Case{"genotypeFromIndex", ploidy, nal, 0, [=](long n){
+          std::vector<int> g(ploidy);
+          long s = 0;
+          for(long i = 0; i < n; i++){
+            ploidyverse::unrankGenotype((*index)[i % nsets], ploidy, g.data());
+            s += g[0];
+          }
+          sink = s;
+          return (double)n;
+        }});
+      }
+
+      if(ploidy % 2 == 0){
+        std::shared_ptr<std::vector<int> >
+          geno(new std::vector<int>(randomGenotype(ploidy, nal, rng)));
+        const double ngametes = (double)ploidyverse::binomialTable()(ploidy, ploidy / 2);
+        out.push_back(Case{"makeGametes", ploidy, nal, 0, [=](long n){
+          for(long i = 0; i < n; i++){
+            std::vector<int> g = ploidyverse::gameteCombinations(geno->data(), ploidy);
+            sink = g.back();
+          }
+          return n * ngametes;
+        }});
+        if(ngen <= opt.maxDenseSelfingGenotypes){
+          // dense ngen x ngen matrix filled row by row, as selfingMatrix does
+          out.push_back(Case{"selfingMatrix", ploidy, nal, 0, [=](long n){
+            ploidyverse::GenotypeTable allgen =
+              ploidyverse::genotypeTable(ploidy, nal);
+            ploidyverse::SparseRow row;
+            for(long i = 0; i < n; i++){
+              std::vector<double> m((std::size_t)ngen * ngen, 0.0);
+              for(int g = 0; g < (int)ngen; g++){
+                ploidyverse::selfingRow(allgen.row(g), ploidy, row);
+                for(std::size_t e = 0; e < row.size(); e++){
+                  m[(std::size_t)g * ngen + row[e].first] = row[e].second;
+                }
+              }
+              sink = m.back();
+            }
+            return (double)n * ngen;
+          }});
+        }
+        if(ngen <= opt.maxSelfingGenotypes){
+          // CSR matrix built directly, as on the first call to
+          // selfingMatrixCSR for a ploidy and allele count
+          out.push_back(Case{"selfingMatrixCSR", ploidy, nal, 0, [=](long n){
+            for(long i = 0; i < n; i++){
+              ploidyverse::SparseMatrix m = ploidyverse::buildSelfingMatrix(ploidy, nal, 1);
+              sink = m.val.back();
+            }
+            return (double)n * ngen;
+          }});
+        }
+      }
+    }
+  }
+  return out;
+}
+
+std::string key(const Result& r){
+  std::ostringstream ss;
+  ss << r.kernel << ',' << r.ploidy << ',' << r.nalleles << ',' << r.depth;
+  return ss.str();
+}
+
+const char* csvHeader =
+  "kernel,ploidy,nalleles,depth,ns_per_call,allocs_per_call,bytes_per_call,"
+  "calls_per_sec,items_per_sec";
+
+void writeCsv(std::ostream& out, const std::vector<Result>& results){
+  out << csvHeader << '\n';
+  char buf[256];
+  for(std::size_t i = 0; i < results.size(); i++){
+    const Result& r = results[i];
+    std::snprintf(buf, sizeof(buf), "%s,%.4g,%.4g,%.4g,%.4g,%.4g", key(r).c_str(),
+                  r.nsPerCall, r.allocsPerCall, r.bytesPerCall, r.callsPerSec,
+                  r.itemsPerSec);
+    out << buf << '\n';
+  }
+}
+
+std::map<std::string, Result> readCsv(const std::string& file){
+  std::ifstream in(file.c_str());
+  if(!in) throw std::runtime_error("Unable to open " + file);
+  std::map<std::string, Result> out;
+  std::string line;
+  std::getline(in, line);
+  if(line != csvHeader) throw std::runtime_error(file + " is not a results file.");
+  while(std::getline(in, line)){
+    std::istringstream ss(line);
+    std::vector<std::string> f;
+    std::string s;
+    while(std::getline(ss, s, ',')) f.push_back(s);
+    if(f.size() != 9) continue;
+    Result r;
+    r.kernel = f[0];
+    r.ploidy = std::atoi(f[1].c_str());
+    r.nalleles = std::atoi(f[2].c_str());
+    r.depth = std::atoi(f[3].c_str());
+    r.nsPerCall = std::atof(f[4].c_str());
+    r.allocsPerCall = std::atof(f[5].c_str());
+    r.bytesPerCall = std::atof(f[6].c_str());
+    r.callsPerSec = std::atof(f[7].c_str());
+    r.itemsPerSec = std::atof(f[8].c_str());
+    out[key(r)] = r;
+  }
+  return out;
+}
+
+// Print the cases that got slower or allocate more than in the baseline, and
+// a summary of the timing ratios for each kernel.  Returns the number of
+// regressions.
+int compare(const std::vector<Result>& results,
+            const std::map<std::string, Result>& baseline, double threshold){
+  int regressions = 0;
+  std::map<std::string, std::vector<double> > ratios;
+  for(std::size_t i = 0; i < results.size(); i++){
+    const Result& r = results[i];
+    std::map<std::string, Result>::const_iterator b = baseline.find(key(r));
+    if(b == baseline.end()) continue;
+    const double ratio = r.nsPerCall / b->second.nsPerCall;
+    ratios[r.kernel].push_back(ratio);
+    const bool slower = ratio > 1 + threshold;
+    // allocations made once per batch are amortized over a number of calls
+    // that varies between runs, so small differences are ignored
+    const bool allocs = r.allocsPerCall > b->second.allocsPerCall * (1 + threshold) + 0.01;
+    if(slower || allocs){
+      std::printf("REGRESSION %-24s ploidy %2d alleles %2d depth %5d: "
+                  "%.4g ns (was %.4g, x%.2f), %.4g allocs (was %.4g)\n",
+                  r.kernel.c_str(), r.ploidy, r.nalleles, r.depth, r.nsPerCall,
+                  b->second.nsPerCall, ratio, r.allocsPerCall,
+                  b->second.allocsPerCall);
+      regressions++;
+    }
+  }
+  for(std::map<std::string, std::vector<double> >::iterator it = ratios.begin();
+      it != ratios.end(); ++it){
+    std::vector<double>& v = it->second;
+    std::sort(v.begin(), v.end());
+    std::printf("%-24s %4d cases, time relative to baseline: median %.3f, "
+                "range %.3f to %.3f\n", it->first.c_str(), (int)v.size(),
+                v[v.size() / 2], v.front(), v.back());
+  }
+  return regressions;
+}
+
+void usage(){
+  std::fprintf(stderr,
+    "Usage: bench_multiallele [options]\n"
+    "  --output FILE         write results as CSV to FILE (default stdout)\n"
+    "  --baseline FILE       compare with results from an earlier run\n"
+    "  --threshold X         slowdown reported as a regression (default 0.10)\n"
+    "  --filter NAME         only run kernels whose name contains NAME\n"
+    "  --min-time SECONDS    minimum time per batch (default 0.01)\n"
+    "  --reps N              batches per case; the median is used (default 5)\n"
+    "  --max-genotypes N     largest table to enumerate (default 1000000)\n"
+    "  --max-selfing N       largest CSR selfing matrix to build (default 5000)\n"
+    "  --max-selfing-dense N largest dense selfing matrix to build (default 1000)\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+  Options opt;
+  for(int i = 1; i < argc; i++){
+    std::string a = argv[i];
+    if(a == "--help" || a == "-h"){
+      usage();
+      return 0;
+    }
+    if(i + 1 >= argc){
+      usage();
+      return 2;
+    }
+    std::string v = argv[++i];
+    if(a == "--output") opt.output = v;
+    else if(a == "--baseline") opt.baseline = v;
+    else if(a == "--threshold") opt.threshold = std::atof(v.c_str());
+    else if(a == "--filter") opt.filter = v;
+    else if(a == "--min-time") opt.minTime = std::atof(v.c_str());
+    else if(a == "--reps") opt.reps = std::max(1, std::atoi(v.c_str()));
+    else if(a == "--max-genotypes") opt.maxGenotypes = std::strtoull(v.c_str(), NULL, 10);
+    else if(a == "--max-selfing") opt.maxSelfingGenotypes = std::strtoull(v.c_str(), NULL, 10);
+    else if(a == "--max-selfing-dense"){
+      opt.maxDenseSelfingGenotypes = std::strtoull(v.c_str(), NULL, 10);
+    }
+    else {
+      usage();
+      return 2;
+    }
+  }
+
+  try {
+    std::map<std::string, Result> baseline;
+    if(!opt.baseline.empty()) baseline = readCsv(opt.baseline);
+
+    std::vector<Case> cases = makeCases(opt);
+    std::vector<Result> results;
+    for(std::size_t i = 0; i < cases.size(); i++){
+      if(cases[i].kernel.find(opt.filter) == std::string::npos) continue;
+      results.push_back(measure(cases[i], opt));
+    }
+
+    if(opt.output.empty()){
+      if(opt.baseline.empty()) writeCsv(std::cout, results);
+    } else {
+      std::ofstream out(opt.output.c_str());
+      writeCsv(out, results);
+      if(!out) throw std::runtime_error("Unable to write " + opt.output);
+    }
+    if(!opt.baseline.empty()){
+      return compare(results, baseline, opt.threshold) > 0 ? 1 : 0;
+    }
+  } catch(std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,169 @@
+#ifndef PLOIDYVERSE_CROSS_KERNELS_H
+#define PLOIDYVERSE_CROSS_KERNELS_H
+
+// Plain C++ kernels for progeny genotype distributions from a cross between
+// two parents, such as an F1 or backcross.  Parents may differ in ploidy, in
+// which case the progeny ploidy is the sum of the two gamete ploidies.
+// Polysomic inheritance without double reduction is assumed.
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+#include "gamete_kernels.h"
+#include "genotype_tables.h"
+#include "threads.h"
+
+namespace ploidyverse {
+
+// Progeny genotype distribution from crossing two parent genotypes (each
+// sorted, of length motherPloidy and fatherPloidy).  out must hold
+// countGenotypes(motherPloidy / 2 + fatherPloidy / 2, nalleles) values, where
+// nalleles is above every allele in either parent.
+inline void crossGenotypesInto(const int* mother, int motherPloidy,
+                               const int* father, int fatherPloidy,
+                               int nalleles, double* out){
+  GameteDistribution gm;
+  GameteDistribution gf;
+  gameteDistribution(mother, motherPloidy, gm);
+  gameteDistribution(father, fatherPloidy, gf);
+  const int ploidy = gm.gamploidy + gf.gamploidy;
+  const std::size_t ngen = countGenotypes(ploidy, nalleles);
+  std::fill(out, out + ngen, 0.0);
+
+  std::vector<int> prog(ploidy);
+  for(int g1 = 0; g1 < gm.size(); g1++){
+    const int* gam1 = gm.gamete(g1);
+    for(int g2 = 0; g2 < gf.size(); g2++){
+      const int* gam2 = gf.gamete(g2);
+      std::merge(gam1, gam1 + gm.gamploidy, gam2, gam2 + gf.gamploidy,
+                 prog.begin());
+      out[rankGenotype(prog.data(), ploidy)] += gm.prob[g1] * gf.prob[g2];
+    }
+  }
+}
+
+// Gamete distribution of a parent whose genotype is only known as a
+// distribution.  freq holds countGenotypes(ploidy, nalleles) genotype
+// probabilities in VCF order; out gets countGenotypes(ploidy / 2, nalleles)
+// gamete probabilities in VCF order.
+inline void gameteFrequencies(const double* freq, int ploidy, int nalleles,
+                              double* out){
+  GenotypeTable tab = genotypeTable(ploidy, nalleles);
+  const int gamploidy = ploidy / 2;
+  std::fill(out, out + countGenotypes(gamploidy, nalleles), 0.0);
+  GameteDistribution gam;
+  for(int g = 0; g < tab.ngen; g++){
+    if(freq[g] == 0) continue;
+    gameteDistribution(tab.row(g), ploidy, gam);
+    for(int i = 0; i < gam.size(); i++){
+      out[rankGenotype(gam.gamete(i), gamploidy)] += freq[g] * gam.prob[i];
+    }
+  }
+}
+
+// Progeny genotype distribution from crossing two parents given as genotype
+// distributions (VCF order).  The gametes of each parent are pooled first, so
+// the cost depends on the number of possible gametes rather than on the
+// number of pairs of parent genotypes.
+inline void crossFrequenciesInto(const double* mother, int motherPloidy,
+                                 const double* father, int fatherPloidy,
+                                 int nalleles, double* out){
+  const int gpm = motherPloidy / 2;
+  const int gpf = fatherPloidy / 2;
+  GenotypeTable tm = genotypeTable(gpm, nalleles);
+  GenotypeTable tf = genotypeTable(gpf, nalleles);
+  std::vector<double> fm(tm.ngen);
+  std::vector<double> ff(tf.ngen);
+  gameteFrequencies(mother, motherPloidy, nalleles, fm.data());
+  gameteFrequencies(father, fatherPloidy, nalleles, ff.data());
+
+  const int ploidy = gpm + gpf;
+  std::fill(out, out + countGenotypes(ploidy, nalleles), 0.0);
+  std::vector<int> prog(ploidy);
+  for(int g1 = 0; g1 < tm.ngen; g1++){
+    if(fm[g1] == 0) continue;
+    const int* gam1 = tm.row(g1);
+    for(int g2 = 0; g2 < tf.ngen; g2++){
+      if(ff[g2] == 0) continue;
+      const int* gam2 = tf.row(g2);
+      std::merge(gam1, gam1 + gpm, gam2, gam2 + gpf, prog.begin());
+      out[rankGenotype(prog.data(), ploidy)] += fm[g1] * ff[g2];
+    }
+  }
+}
+
+// Progeny genotype distributions for many loci at once.  mother and father
+// hold parent genotype indices in VCF order, one per locus, with negative
+// values for missing genotypes.  nalleles gives the number of alleles at each
+// locus.  Output is flat, with progeny genotypes varying fastest, then loci;
+// loci with a missing parent are NaN.
+//
+// Most loci in a mapping population share a few parent genotype
+// combinations, so each distinct (nalleles, mother, father) combination is
+// computed once, in parallel, and then copied to every locus that has it.
+inline void crossProgenyBatch(const int* mother, const int* father,
+                              const int* nalleles, std::size_t nloci,
+                              int motherPloidy, int fatherPloidy,
+                              double* out, int nthreads){
+  const int ploidy = motherPloidy / 2 + fatherPloidy / 2;
+  typedef std::pair<int, std::pair<int, int> > Key;
+
+  // output offsets and the distinct combination used at each locus
+  std::vector<std::size_t> offset(nloci + 1, 0);
+  std::vector<int> which(nloci, -1);
+  std::vector<Key> keys;
+  std::map<Key, int> lookup;
+  for(std::size_t L = 0; L < nloci; L++){
+    offset[L + 1] = offset[L] + countGenotypes(ploidy, nalleles[L]);
+    if(mother[L] < 0 || father[L] < 0) continue;
+    Key key(nalleles[L], std::make_pair(mother[L], father[L]));
+    std::map<Key, int>::iterator it = lookup.find(key);
+    if(it == lookup.end()){
+      it = lookup.insert(std::make_pair(key, (int)keys.size())).first;
+      keys.push_back(key);
+    }
+    which[L] = it->second;
+  }
+
+  const long long nkeys = keys.size();
+  std::vector<std::vector<double> > results(nkeys);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<int> gm(motherPloidy);
+    std::vector<int> gf(fatherPloidy);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for(long long k = 0; k < nkeys; k++){
+      const int nal = keys[k].first;
+      unrankGenotype(keys[k].second.first, motherPloidy, gm.data());
+      unrankGenotype(keys[k].second.second, fatherPloidy, gf.data());
+      results[k].resize(countGenotypes(ploidy, nal));
+      crossGenotypesInto(gm.data(), motherPloidy, gf.data(), fatherPloidy,
+                         nal, results[k].data());
+    }
+  }
+
+  const long long nl = nloci;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(static)
+#endif
+  for(long long L = 0; L < nl; L++){
+    double* dest = out + offset[L];
+    if(which[L] < 0){
+      std::fill(dest, out + offset[L + 1], std::numeric_limits<double>::quiet_NaN());
+    } else {
+      const std::vector<double>& res = results[which[L]];
+      std::copy(res.begin(), res.end(), dest);
+    }
+  }
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_CROSS_KERNELS_H
@@ -0,0 +1,152 @@
+#ifndef PLOIDYVERSE_FIXED_GENOTYPES_H
+#define PLOIDYVERSE_FIXED_GENOTYPES_H
+
+// Genotype tables built at compile time for the ploidies and numbers of
+// alleles that make up nearly all data: diploid, tetraploid and hexaploid,
+// with two to four alleles.  Kernels templated on the ploidy and number of
+// alleles get loops with constant bounds, which the compiler unrolls, scratch
+// arrays on the stack, and ranking and unranking by table lookup.
+//
+// dispatchFixed picks the specialization for a ploidy and number of alleles
+// at run time.  It returns false for anything else, and the caller then uses
+// the generic kernels in genotype_tables.h.  Results are identical either way.
+
+#include <cstddef>
+#include <cstring>
+
+namespace ploidyverse {
+
+// Largest number of alleles with compile-time tables.  Because genotypes
+// for fewer alleles are a prefix of those for more in VCF order, the tables
+// for this many alleles also serve ranking and unranking for fewer.
+static const int fixedMaxAlleles = 4;
+
+// C(n, k), exactly, since C(n - 1, k - 1) * n is always divisible by k.
+constexpr unsigned long long fixedChoose(int n, int k){
+  return k < 0 || k > n ? 0 :
+    (k == 0 ? 1 : fixedChoose(n - 1, k - 1) * n / k);
+}
+
+// Highest allele of the genotype at index among those of ploidy p: the
+// largest g with C(g + p - 1, p) <= index, searching upward from g.
+constexpr int fixedTopAllele(unsigned long long index, int p, int g){
+  return fixedChoose(g + p, p) <= index ? fixedTopAllele(index, p, g + 1) : g;
+}
+
+// Allele at position i of the genotype at index, as from unrankGenotype.
+constexpr int fixedAllele(unsigned long long index, int p, int i){
+  return i == p - 1 ? fixedTopAllele(index, p, 0) :
+    fixedAllele(index - fixedChoose(fixedTopAllele(index, p, 0) + p - 1, p),
+                p - 1, i);
+}
+
+// Copies of allele a in the genotype at index, from position i onward.
+constexpr int fixedCopies(unsigned long long index, int p, int a, int i){
+  return i == p ? 0 :
+    (fixedAllele(index, p, i) == a ? 1 : 0) + fixedCopies(index, p, a, i + 1);
+}
+
+// 0, 1, ..., N - 1 as a parameter pack, for filling the tables below.
+template<int... I> struct IndexList {};
+template<int N, int... I>
+struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+template<int... I> struct MakeIndexList<0, I...> { typedef IndexList<I...> type; };
+
+// Tables for ploidy P and A alleles.  Only the first two parameters are given;
+// the rest are filled in by default.
+template<int P, int A, int G = (int)fixedChoose(P + A - 1, P),
+         class Alleles = typename MakeIndexList<G * P>::type,
+         class Copies = typename MakeIndexList<G * A>::type,
+         class Terms = typename MakeIndexList<P * A>::type>
+struct FixedGenotypes;
+
+template<int P, int A, int G, int... I, int... J, int... K>
+struct FixedGenotypes<P, A, G, IndexList<I...>, IndexList<J...>, IndexList<K...> > {
+  static const int ploidy = P;
+  static const int nalleles = A;
+  static const int ngen = G;
+  // all genotypes in VCF order, as from enumerateGenotypesInto (G x P)
+  static constexpr int alleles[G * P] = { fixedAllele(I / P, P, I % P)... };
+  // copy number of each allele in each genotype, as from alleleCopyTable
+  // (G x A)
+  static constexpr int copies[G * A] = { fixedCopies(J / A, P, J % A, 0)... };
+  // C(a + m - 1, m) for m from 1 to P and allele a, the terms summed by
+  // rankGenotype (P x A)
+  static constexpr unsigned long long rankTerms[P * A] = {
+    fixedChoose(K % A + K / A, K / A + 1)...
+  };
+};
+
+template<int P, int A, int G, int... I, int... J, int... K>
+constexpr int FixedGenotypes<P, A, G, IndexList<I...>, IndexList<J...>,
+                             IndexList<K...> >::alleles[G * P];
+template<int P, int A, int G, int... I, int... J, int... K>
+constexpr int FixedGenotypes<P, A, G, IndexList<I...>, IndexList<J...>,
+                             IndexList<K...> >::copies[G * A];
+template<int P, int A, int G, int... I, int... J, int... K>
+constexpr unsigned long long FixedGenotypes<P, A, G, IndexList<I...>,
+                                            IndexList<J...>,
+                                            IndexList<K...> >::rankTerms[P * A];
+
+// enumerateGenotypesInto for ploidy P and A alleles.
+template<int P, int A>
+inline void enumerateGenotypesFixed(int* out){
+  typedef FixedGenotypes<P, A> T;
+  std::memcpy(out, T::alleles, sizeof(T::alleles));
+}
+
+// rankGenotype for ploidy P.  geno must be sorted, with every allele below
+// fixedMaxAlleles.
+template<int P>
+inline unsigned long long rankGenotypeFixed(const int* geno){
+  typedef FixedGenotypes<P, fixedMaxAlleles> T;
+  unsigned long long out = 0;
+  for(int m = 0; m < P; m++){
+    out += T::rankTerms[m * fixedMaxAlleles + geno[m]];
+  }
+  return out;
+}
+
+// unrankGenotype for ploidy P.  index must be below
+// FixedGenotypes<P, fixedMaxAlleles>::ngen.
+template<int P>
+inline void unrankGenotypeFixed(unsigned long long index, int* out){
+  typedef FixedGenotypes<P, fixedMaxAlleles> T;
+  const int* row = T::alleles + (std::size_t)index * P;
+  for(int i = 0; i < P; i++) out[i] = row[i];
+}
+
+// Copy number of each of A alleles in a genotype of ploidy P, in any order.
+template<int P, int A>
+inline void alleleCopyFixed(const int* geno, int* out){
+  int copies[A] = {0};
+  for(int i = 0; i < P; i++) copies[geno[i]]++;
+  for(int a = 0; a < A; a++) out[a] = copies[a];
+}
+
+// Calls f.template run<P, A>() with P and A equal to ploidy and nalleles and
+// returns true, if there is a specialization for them.  Otherwise returns
+// false without calling f.
+template<int P, class F>
+inline bool dispatchFixedAlleles(int nalleles, F& f){
+  switch(nalleles){
+  case 2: f.template run<P, 2>(); return true;
+  case 3: f.template run<P, 3>(); return true;
+  case 4: f.template run<P, 4>(); return true;
+  default: return false;
+  }
+}
+
+template<class F>
+inline bool dispatchFixed(int ploidy, int nalleles, F& f){
+  switch(ploidy){
+  case 2: return dispatchFixedAlleles<2>(nalleles, f);
+  case 4: return dispatchFixedAlleles<4>(nalleles, f);
+  case 6: return dispatchFixedAlleles<6>(nalleles, f);
+  default: return false;
+  }
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_FIXED_GENOTYPES_H
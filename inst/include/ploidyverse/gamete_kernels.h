@@ -0,0 +1,120 @@
+#ifndef PLOIDYVERSE_GAMETE_KERNELS_H
+#define PLOIDYVERSE_GAMETE_KERNELS_H
+
+// Plain C++ kernels for gametes produced under polysomic inheritance with no
+// double reduction, where a gamete receives ploidy/2 of the parent's
+// chromosome copies chosen at random.
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "genotype_tables.h"
+
+namespace ploidyverse {
+
+// Each distinct gamete genotype that a parent can produce, with its
+// probability.  Gametes are stored one after another, gamploidy values each,
+// with alleles in ascending order, and are listed in VCF order.
+struct GameteDistribution {
+  int gamploidy;
+  std::vector<int> alleles;
+  std::vector<double> prob;
+
+  GameteDistribution() : gamploidy(0) {}
+
+  int size() const { return prob.size(); }
+  const int* gamete(int g) const { return alleles.data() + (std::size_t)g * gamploidy; }
+};
+
+// Distinct gametes of a genotype (ploidy values, sorted).  If allele a has c_a
+// copies in the parent, a gamete with k_a copies of each allele has probability
+// prod(C(c_a, k_a)) / C(ploidy, ploidy/2).  Each gamete is therefore found once,
+// rather than once for every way of drawing it.
+inline void gameteDistribution(const int* geno, int ploidy, GameteDistribution& out){
+  const BinomialTable& choose = binomialTable();
+  const int gamploidy = ploidy / 2;
+  out.gamploidy = gamploidy;
+  out.alleles.clear();
+  out.prob.clear();
+
+  // distinct alleles and their copy numbers
+  std::vector<int> allele;
+  std::vector<int> copies;
+  for(int i = 0; i < ploidy; i++){
+    if(i > 0 && geno[i] == geno[i - 1]){
+      copies.back()++;
+    } else {
+      allele.push_back(geno[i]);
+      copies.push_back(1);
+    }
+  }
+  const int nal = allele.size();
+  const double total = (double)choose(ploidy, gamploidy);
+
+  if(gamploidy == 0){
+    out.prob.push_back(1.0);
+    return;
+  }
+
+  // Copies k drawn of each allele, with sum(k) == gamploidy.  Gametes are
+  // in VCF order when k is ordered by its last element, then the one before
+  // it, and so on, so start with as many copies of low alleles as possible.
+  std::vector<int> k(nal, 0);
+  int remaining = gamploidy;
+  for(int i = 0; i < nal; i++){
+    k[i] = std::min(copies[i], remaining);
+    remaining -= k[i];
+  }
+  for(;;){
+    double p = 1;
+    for(int i = 0; i < nal; i++){
+      p *= (double)choose(copies[i], k[i]);
+      for(int j = 0; j < k[i]; j++) out.alleles.push_back(allele[i]);
+    }
+    out.prob.push_back(p / total);
+
+    // Next gamete: find the lowest allele i + 1 that can take another copy
+    // from the alleles below it, move one copy there, and put the rest of the
+    // copies from below back on the lowest alleles.
+    int moved = 0;
+    int i = 0;
+    for(; i < nal - 1; i++){
+      moved += k[i];
+      k[i] = 0;
+      if(moved > 0 && k[i + 1] < copies[i + 1]) break;
+    }
+    if(i >= nal - 1) break;
+    k[i + 1]++;
+    moved--;
+    for(int j = 0; moved > 0; j++){
+      k[j] = std::min(copies[j], moved);
+      moved -= k[j];
+    }
+  }
+}
+
+// All gametes, with duplicates for each way of drawing them, as produced by
+// choosing every combination of gamploidy chromosome copies.  Combinations are
+// in lexicographic order of position.  Output is stored row by row.
+inline std::vector<int> gameteCombinations(const int* geno, int ploidy){
+  const int gamploidy = ploidy / 2;
+  std::vector<int> out;
+  std::vector<int> pos(gamploidy);
+  for(int i = 0; i < gamploidy; i++) pos[i] = i;
+  for(;;){
+    for(int i = 0; i < gamploidy; i++){
+      out.push_back(geno[pos[i]]);
+    }
+    int i = gamploidy - 1;
+    while(i >= 0 && pos[i] == ploidy - gamploidy + i) i--;
+    if(i < 0) break;
+    pos[i]++;
+    for(int j = i + 1; j < gamploidy; j++) pos[j] = pos[j - 1] + 1;
+  }
+  return out;
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_GAMETE_KERNELS_H
@@ -0,0 +1,370 @@
+#ifndef PLOIDYVERSE_GENOTYPE_TABLES_H
+#define PLOIDYVERSE_GENOTYPE_TABLES_H
+
+// Enumeration, ranking and unranking of genotypes in VCF order, backed by an
+// exact table of binomial coefficients and a process-wide genotype cache.
+//
+// In VCF order the genotypes for nalleles alleles are always the first rows of
+// the genotypes for more alleles at the same ploidy (every genotype using
+// alleles below a comes before any genotype containing allele a).  The cache
+// therefore keeps one table per ploidy, grown when more alleles are requested,
+// and any (ploidy, nalleles) pair is served as a prefix of it.
+
+#include <climits>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "fixed_genotypes.h"
+#include "threads.h"
+
+namespace ploidyverse {
+
+// Binomial coefficients C(n, k) for n up to 67, which is as far as they all
+// fit in an unsigned 64-bit integer.  Built once, by Pascal's rule, so that
+// every value is exact.
+class BinomialTable {
+public:
+  static const int maxN = 67;
+
+  BinomialTable(){
+    for(int n = 0; n <= maxN; n++){
+      tab_[n][0] = 1;
+      for(int k = 1; k <= maxN; k++){
+        tab_[n][k] = n == 0 ? 0 : tab_[n - 1][k - 1] + tab_[n - 1][k];
+      }
+    }
+  }
+
+  // Zero if k is below zero or above n.  For n above maxN, where the value
+  // may not fit, ULLONG_MAX is returned rather than reading past the table.
+  unsigned long long operator()(int n, int k) const {
+    if(k < 0 || k > n) return 0;
+    if(n > maxN) return ULLONG_MAX;
+    return tab_[n][k];
+  }
+
+private:
+  unsigned long long tab_[maxN + 1][maxN + 1];
+};
+
+inline const BinomialTable& binomialTable(){
+  static const BinomialTable table;
+  return table;
+}
+
+// Number of genotypes, (ploidy + nalleles - 1)! / (ploidy! (nalleles - 1)!),
+// computed exactly.  Returns ULLONG_MAX if the count is beyond the table,
+// which is far more genotypes than could ever be enumerated.
+inline unsigned long long countGenotypes(int ploidy, int nalleles){
+  if(nalleles < 1) return 0;
+  if(ploidy < 1) return 1;
+  if(ploidy + nalleles - 1 > BinomialTable::maxN) return ULLONG_MAX;
+  return binomialTable()(ploidy + nalleles - 1, ploidy);
+}
+
+// Whether genotypes with alleles up to maxallele can be ranked exactly, i.e.
+// whether every binomial coefficient needed is in the table.
+inline bool canRankGenotypes(int ploidy, int maxallele){
+  return maxallele + ploidy - 1 <= BinomialTable::maxN;
+}
+
+// Index of a genotype in VCF order (its row in enumerateGenotypes), using the
+// combinatorial number system.  geno must be sorted in ascending order, and
+// canRankGenotypes must be true for it.
+inline unsigned long long rankGenotype(const int* geno, int ploidy){
+  const BinomialTable& choose = binomialTable();
+  unsigned long long out = 0;
+  for(int m = 1; m <= ploidy; m++){
+    out += choose(geno[m - 1] + m - 1, m);
+  }
+  return out;
+}
+
+// Genotype at a given index in VCF order, written to out (ploidy values).
+// Works backwards from the last allele; each allele can be no higher than the
+// one after it, so the search for each position continues downward from the
+// previous one rather than starting over.
+inline void unrankGenotype(unsigned long long index, int ploidy, int* out){
+  const BinomialTable& choose = binomialTable();
+  if(ploidy < 1) return;
+  // highest allele: largest g with C(g + ploidy - 1, ploidy) <= index
+  int g = 0;
+  while(g + ploidy <= BinomialTable::maxN && choose(g + ploidy, ploidy) <= index){
+    g++;
+  }
+  for(int p = ploidy; p > 0; p--){
+    while(g > 0 && choose(g + p - 1, p) > index){
+      g--;
+    }
+    out[p - 1] = g;
+    index -= choose(g + p - 1, p);
+  }
+}
+
+// rankGenotypesBatch for ploidy P, with the genotype on the stack and table
+// lookups for genotypes with only the first fixedMaxAlleles alleles.
+template<int P>
+inline void rankGenotypesBatchFixed(const int* genos, std::size_t n,
+                                    unsigned long long* out, int nthreads){
+  const long long nn = n;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(static)
+#endif
+  for(long long i = 0; i < nn; i++){
+    int geno[P];
+    bool missing = false;
+    for(int c = 0; c < P; c++){
+      geno[c] = genos[i + (std::size_t)c * n];
+      if(geno[c] < 0) missing = true;
+    }
+    if(missing){
+      out[i] = ULLONG_MAX;
+      continue;
+    }
+    for(int c = 1; c < P; c++){
+      int v = geno[c];
+      int j = c - 1;
+      while(j >= 0 && geno[j] > v){
+        geno[j + 1] = geno[j];
+        j--;
+      }
+      geno[j + 1] = v;
+    }
+    out[i] = geno[P - 1] < fixedMaxAlleles ? rankGenotypeFixed<P>(geno) :
+      rankGenotype(geno, P);
+  }
+}
+
+// rankGenotype for n genotypes stored column by column, as in an R matrix
+// with genotypes in rows.  Alleles within a genotype need not be sorted.
+// Genotypes with a negative (missing) allele get ULLONG_MAX.  The caller must
+// check canRankGenotypes for the highest allele.  Parallel over genotypes.
+inline void rankGenotypesBatch(const int* genos, std::size_t n, int ploidy,
+                               unsigned long long* out, int nthreads){
+  switch(ploidy){
+  case 2: rankGenotypesBatchFixed<2>(genos, n, out, nthreads); return;
+  case 4: rankGenotypesBatchFixed<4>(genos, n, out, nthreads); return;
+  case 6: rankGenotypesBatchFixed<6>(genos, n, out, nthreads); return;
+  }
+  const long long nn = n;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<int> geno(ploidy);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(long long i = 0; i < nn; i++){
+      bool missing = false;
+      for(int c = 0; c < ploidy; c++){
+        geno[c] = genos[i + (std::size_t)c * n];
+        if(geno[c] < 0) missing = true;
+      }
+      if(missing){
+        out[i] = ULLONG_MAX;
+        continue;
+      }
+      // insertion sort; genotypes are short and usually already in order
+      for(int c = 1; c < ploidy; c++){
+        int v = geno[c];
+        int j = c - 1;
+        while(j >= 0 && geno[j] > v){
+          geno[j + 1] = geno[j];
+          j--;
+        }
+        geno[j + 1] = v;
+      }
+      out[i] = rankGenotype(geno.data(), ploidy);
+    }
+  }
+}
+
+// unrankGenotypesBatch for ploidy P, copying rows of the compile-time table
+// for indices within it.
+template<int P>
+inline void unrankGenotypesBatchFixed(const unsigned long long* index,
+                                      std::size_t n, int missingValue, int* out,
+                                      int nthreads){
+  const unsigned long long ntab = FixedGenotypes<P, fixedMaxAlleles>::ngen;
+  const long long nn = n;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(static)
+#endif
+  for(long long i = 0; i < nn; i++){
+    int geno[P];
+    if(index[i] == ULLONG_MAX){
+      for(int c = 0; c < P; c++) geno[c] = missingValue;
+    } else if(index[i] < ntab){
+      unrankGenotypeFixed<P>(index[i], geno);
+    } else {
+      unrankGenotype(index[i], P, geno);
+    }
+    for(int c = 0; c < P; c++){
+      out[i + (std::size_t)c * n] = geno[c];
+    }
+  }
+}
+
+// unrankGenotype for n indices, writing genotypes column by column as in an
+// R matrix with genotypes in rows.  Indices of ULLONG_MAX are missing and
+// give alleles of missingValue.  Parallel over genotypes.
+inline void unrankGenotypesBatch(const unsigned long long* index, std::size_t n,
+                                 int ploidy, int missingValue, int* out,
+                                 int nthreads){
+  switch(ploidy){
+  case 2:
+    unrankGenotypesBatchFixed<2>(index, n, missingValue, out, nthreads);
+    return;
+  case 4:
+    unrankGenotypesBatchFixed<4>(index, n, missingValue, out, nthreads);
+    return;
+  case 6:
+    unrankGenotypesBatchFixed<6>(index, n, missingValue, out, nthreads);
+    return;
+  }
+  const long long nn = n;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<int> geno(ploidy);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(long long i = 0; i < nn; i++){
+      if(index[i] == ULLONG_MAX){
+        for(int c = 0; c < ploidy; c++) geno[c] = missingValue;
+      } else {
+        unrankGenotype(index[i], ploidy, geno.data());
+      }
+      for(int c = 0; c < ploidy; c++){
+        out[i + (std::size_t)c * n] = geno[c];
+      }
+    }
+  }
+}
+
+// Write all genotypes in VCF order to out, which must hold ngen * ploidy
+// values.  Each row is one genotype, with allele indices in ascending order.
+// Rows are written one after another, without recursion.
+inline void enumerateGenotypesInto(int ploidy, int nalleles, int* out){
+  if(ploidy < 1 || nalleles < 1) return;
+  std::vector<int> geno(ploidy, 0);
+  int* row = out;
+  for(;;){
+    for(int i = 0; i < ploidy; i++){
+      row[i] = geno[i];
+    }
+    row += ploidy;
+    // advance to the next genotype: increment the first allele that is
+    // allowed to grow, and reset everything before it
+    int i = 0;
+    while(i < ploidy && geno[i] == (i == ploidy - 1 ? nalleles - 1 : geno[i + 1])){
+      i++;
+    }
+    if(i == ploidy) break;
+    geno[i]++;
+    for(int j = 0; j < i; j++){
+      geno[j] = 0;
+    }
+  }
+}
+
+// A read-only view of the genotypes for one ploidy and number of alleles.
+// Holding it keeps the underlying table alive even if the cache is cleared.
+struct GenotypeTable {
+  int ploidy;
+  int nalleles;
+  int ngen;
+  std::shared_ptr<const std::vector<int> > owner;
+
+  // allele indices of genotype g, ploidy values
+  const int* row(int g) const { return owner->data() + (std::size_t)g * ploidy; }
+};
+
+class GenotypeCache {
+public:
+  // Tables larger than this many integers are built but not kept.
+  static const std::size_t maxCached = (std::size_t)1 << 26;
+
+  GenotypeTable get(int ploidy, int nalleles){
+    GenotypeTable out;
+    out.ploidy = ploidy;
+    out.nalleles = nalleles;
+    unsigned long long ngen = countGenotypes(ploidy, nalleles);
+    if(ngen > (unsigned long long)INT_MAX / (ploidy > 0 ? ploidy : 1)){
+      throw std::length_error("Too many genotypes to enumerate.");
+    }
+    out.ngen = (int)ngen;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::map<int, Entry>::iterator it = tables_.find(ploidy);
+      if(it != tables_.end() && it->second.nalleles >= nalleles){
+        out.owner = it->second.table;
+        return out;
+      }
+    }
+
+    // build outside of the lock; a second thread building the same table
+    // at the same time is harmless
+    std::vector<int>* tab = new std::vector<int>((std::size_t)ngen * ploidy);
+    enumerateGenotypesInto(ploidy, nalleles, tab->data());
+    out.owner.reset(tab);
+    if(tab->size() <= maxCached){
+      std::lock_guard<std::mutex> lock(mutex_);
+      Entry& e = tables_[ploidy];
+      if(!e.table || e.nalleles < nalleles){
+        e.nalleles = nalleles;
+        e.table = out.owner;
+      }
+    }
+    return out;
+  }
+
+  void clear(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_.clear();
+  }
+
+private:
+  struct Entry {
+    int nalleles;
+    std::shared_ptr<const std::vector<int> > table;
+    Entry() : nalleles(0) {}
+  };
+  std::map<int, Entry> tables_;
+  std::mutex mutex_;
+};
+
+inline GenotypeCache& genotypeCache(){
+  static GenotypeCache cache;
+  return cache;
+}
+
+// Cached genotypes for a ploidy and number of alleles.
+inline GenotypeTable genotypeTable(int ploidy, int nalleles){
+  return genotypeCache().get(ploidy, nalleles);
+}
+
+// Copy number of each allele for every genotype, in VCF order.
+// Output is ngen x nalleles, stored row by row.
+inline std::vector<int> alleleCopyTable(int ploidy, int nalleles){
+  GenotypeTable tab = genotypeTable(ploidy, nalleles);
+  std::vector<int> out((std::size_t)tab.ngen * nalleles, 0);
+  for(int g = 0; g < tab.ngen; g++){
+    const int* geno = tab.row(g);
+    for(int i = 0; i < ploidy; i++){
+      out[(std::size_t)g * nalleles + geno[i]]++;
+    }
+  }
+  return out;
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_GENOTYPE_TABLES_H
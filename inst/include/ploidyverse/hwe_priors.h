@@ -0,0 +1,379 @@
+#ifndef PLOIDYVERSE_HWE_PRIORS_H
+#define PLOIDYVERSE_HWE_PRIORS_H
+
+// Genotype frequencies expected under Hardy-Weinberg equilibrium, for use as
+// genotype priors, and estimation of allele frequencies from read depths by
+// EM.  Under HWE the copy numbers of the alleles in a genotype are
+// multinomial, so the frequency of genotype g with c[g, a] copies of allele a
+// is
+//
+//   ploidy! / prod_a c[g, a]! * prod_a freq[a]^c[g, a]
+//
+// which is what alleleCopy and dmultinom give for one genotype at a time.
+// Here the copy numbers and multinomial coefficients come from the cached
+// genotype enumeration, once for each number of alleles, and the loci are
+// done in parallel.  Nothing here touches the R API, so these can run inside
+// OpenMP threads.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "genotype_tables.h"
+#include "likelihood_kernels.h"
+#include "ploidy_classes.h"
+#include "threads.h"
+
+namespace ploidyverse {
+
+// Copy numbers and log multinomial coefficients of all genotypes for one
+// ploidy and number of alleles, in VCF order.
+struct HweTable {
+  int ploidy;
+  int ngen;
+  int nalleles;
+  std::vector<int> copies;     // ngen x nalleles
+  std::vector<double> logcoef; // log(ploidy! / prod(copies!))
+
+  HweTable() : ploidy(0), ngen(0), nalleles(0) {}
+  HweTable(int p, int nal) : ploidy(p), nalleles(nal) {
+    copies = alleleCopyTable(p, nal);
+    ngen = copies.size() / nal;
+    logcoef.assign(ngen, std::lgamma(p + 1.0));
+    for(int g = 0; g < ngen; g++){
+      for(int a = 0; a < nal; a++){
+        logcoef[g] -= std::lgamma(copies[(std::size_t)g * nal + a] + 1.0);
+      }
+    }
+  }
+};
+
+// HWE genotype frequencies at one locus from the frequency of each allele.
+// freq is rescaled to sum to one; if it has negative or missing values, or
+// sums to zero, the output is NaN.  logfreq is scratch space for nalleles
+// values, and out receives tab.ngen values, which are logs if logout is true.
+inline void hwePrior(const double* freq, const HweTable& tab, bool logout,
+                     double* logfreq, double* out){
+  const int nal = tab.nalleles;
+  double tot = 0;
+  for(int a = 0; a < nal; a++){
+    if(!(freq[a] >= 0)) tot = std::numeric_limits<double>::quiet_NaN();
+    tot += freq[a];
+  }
+  if(!(tot > 0)){
+    for(int g = 0; g < tab.ngen; g++){
+      out[g] = std::numeric_limits<double>::quiet_NaN();
+    }
+    return;
+  }
+  for(int a = 0; a < nal; a++){
+    logfreq[a] = freq[a] > 0 ? std::log(freq[a] / tot) :
+      -std::numeric_limits<double>::infinity();
+  }
+  for(int g = 0; g < tab.ngen; g++){
+    const int* c = &tab.copies[(std::size_t)g * nal];
+    double s = tab.logcoef[g];
+    for(int a = 0; a < nal; a++){
+      // skipping absent alleles keeps 0 * log(0) out of the sum
+      if(c[a] > 0) s += c[a] * logfreq[a];
+    }
+    out[g] = logout ? s : std::exp(s);
+  }
+}
+
+// Check that every class is autopolyploid.  For an allopolyploid, HWE
+// holds within each subgenome, with allele frequencies that generally differ
+// between subgenomes and cannot be told apart from reads, so it has no prior
+// from one set of frequencies.  Throws std::invalid_argument otherwise.
+inline void checkHweClasses(const std::vector<PloidyClass>& classes){
+  for(std::size_t c = 0; c < classes.size(); c++){
+    if(!classes[c].autopolyploid()){
+      throw std::invalid_argument(
+        "HWE priors and allele frequencies need autopolyploid samples.");
+    }
+  }
+}
+
+// One HweTable for each class and number of alleles present, at
+// class * (maxal + 1) + nalleles, as in LogLikSetup.
+inline std::vector<HweTable> hweTables(const int* nalleles, std::size_t nloci,
+                                       const std::vector<PloidyClass>& classes,
+                                       int maxal){
+  const int stride = maxal + 1;
+  std::vector<HweTable> tabs(classes.size() * stride);
+  for(std::size_t L = 0; L < nloci; L++){
+    const int nal = nalleles[L];
+    for(std::size_t c = 0; c < classes.size(); c++){
+      HweTable& tab = tabs[c * stride + nal];
+      if(tab.nalleles == 0) tab = HweTable(classes[c].ploidy, nal);
+    }
+  }
+  return tabs;
+}
+
+// HWE genotype frequencies for many loci and samples of different ploidies.
+// freq holds allele frequencies with alleles varying fastest, so locus L
+// occupies nalleles[L] values.  Sample s gets the nGen(ploidy, nalleles[L])
+// frequencies for the ploidy of classes[sampleClass[s]], so out is laid out
+// as the output of genotypeLogLikMixed and can be used as a per-block prior
+// for it.  Every class must be autopolyploid; see checkHweClasses.  Parallel
+// over loci.
+inline void hwePriorsMixed(const double* freq, const int* nalleles,
+                           std::size_t nloci, int nsamples,
+                           const std::vector<PloidyClass>& classes,
+                           const int* sampleClass, bool logout, double* out,
+                           int nthreads){
+  checkHweClasses(classes);
+  int maxal = 0;
+  for(std::size_t L = 0; L < nloci; L++){
+    if(nalleles[L] > maxal) maxal = nalleles[L];
+  }
+  const int stride = maxal + 1;
+  const int ncls = classes.size();
+  const std::vector<HweTable> tabs = hweTables(nalleles, nloci, classes, maxal);
+  std::vector<std::size_t> classSize(ncls, 0);
+  for(int s = 0; s < nsamples; s++) classSize[sampleClass[s]]++;
+  std::vector<std::size_t> inoff(nloci + 1, 0);
+  std::vector<std::size_t> outoff(nloci + 1, 0);
+  for(std::size_t L = 0; L < nloci; L++){
+    const int nal = nalleles[L];
+    std::size_t ncell = 0;
+    for(int c = 0; c < ncls; c++){
+      ncell += (std::size_t)tabs[c * stride + nal].ngen * classSize[c];
+    }
+    inoff[L + 1] = inoff[L] + nal;
+    outoff[L + 1] = outoff[L] + ncell;
+  }
+
+  const long long n = nloci;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<double> logfreq(maxal);
+    std::vector<const double*> first(ncls);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+    for(long long L = 0; L < n; L++){
+      const int nal = nalleles[L];
+      double* o = out + outoff[L];
+      // each class's priors are computed for its first sample and copied
+      // to the rest
+      for(int c = 0; c < ncls; c++) first[c] = NULL;
+      for(int s = 0; s < nsamples; s++){
+        const int c = sampleClass[s];
+        const HweTable& tab = tabs[c * stride + nal];
+        if(first[c] == NULL){
+          hwePrior(freq + inoff[L], tab, logout, logfreq.data(), o);
+          first[c] = o;
+        } else {
+          std::copy(first[c], first[c] + tab.ngen, o);
+        }
+        o += tab.ngen;
+      }
+    }
+  }
+}
+
+// hwePriorsMixed for nsamples samples of one ploidy: each locus's
+// nGen(ploidy, nalleles[L]) values are written nsamples times in a row, so
+// that out is laid out as the output of genotypeLogLikBatch.
+inline void hwePriorsBatch(const double* freq, const int* nalleles,
+                           std::size_t nloci, int ploidy, int nsamples,
+                           bool logout, double* out, int nthreads){
+  const std::vector<PloidyClass> classes(1, PloidyClass(ploidy));
+  const std::vector<int> sampleClass(nsamples, 0);
+  hwePriorsMixed(freq, nalleles, nloci, nsamples, classes, sampleClass.data(),
+                 logout, out, nthreads);
+}
+
+// EM estimate of allele frequencies at one locus from genotype
+// log-likelihoods ll, assuming HWE.  Sample s has tabs[sampleClass[s]]->ngen
+// values in ll, one sample after another as from genotypeLogLikMixed, and
+// samples flagged as missing are skipped.  freq holds starting values on
+// input and estimates on output.  Iterates until no frequency changes by
+// more than tol, or maxit times, and returns the number of iterations.  ll is
+// overwritten with relative likelihoods, and prior and post are scratch space
+// for the number of genotypes summed over the tables.
+inline int alleleFreqEM(double* ll, const char* missing, int nsamples,
+                        const int* sampleClass,
+                        const std::vector<const HweTable*>& tabs, double tol,
+                        int maxit, double* prior, double* post, double* freq){
+  const int ncls = tabs.size();
+  const int nal = tabs[0]->nalleles;
+  // start of each class's genotypes in prior and post
+  std::vector<std::size_t> classoff(ncls + 1, 0);
+  for(int c = 0; c < ncls; c++){
+    classoff[c + 1] = classoff[c] + tabs[c]->ngen;
+  }
+  // likelihoods relative to the best genotype of each sample, so that the
+  // posteriors below do not underflow at high depth
+  double* l = ll;
+  for(int s = 0; s < nsamples; s++){
+    const int ngen = tabs[sampleClass[s]]->ngen;
+    if(!missing[s]){
+      double mx = -std::numeric_limits<double>::infinity();
+      for(int g = 0; g < ngen; g++){
+        if(l[g] > mx) mx = l[g];
+      }
+      for(int g = 0; g < ngen; g++) l[g] = std::exp(l[g] - mx);
+    }
+    l += ngen;
+  }
+
+  std::vector<double> logfreq(nal);
+  std::vector<double> expected(nal);
+  int it = 0;
+  while(it < maxit){
+    it++;
+    for(int c = 0; c < ncls; c++){
+      hwePrior(freq, *tabs[c], false, logfreq.data(), prior + classoff[c]);
+    }
+    // E step: posterior genotype probabilities, summed over the samples of
+    // each class
+    for(std::size_t g = 0; g < classoff[ncls]; g++) post[g] = 0;
+    l = ll;
+    for(int s = 0; s < nsamples; s++){
+      const int c = sampleClass[s];
+      const int ngen = tabs[c]->ngen;
+      const double* pr = prior + classoff[c];
+      double* po = post + classoff[c];
+      if(!missing[s]){
+        double tot = 0;
+        for(int g = 0; g < ngen; g++) tot += pr[g] * l[g];
+        if(tot > 0){
+          for(int g = 0; g < ngen; g++) po[g] += pr[g] * l[g] / tot;
+        }
+      }
+      l += ngen;
+    }
+    // M step: expected allele copies, as a proportion of all copies
+    double tot = 0;
+    for(int a = 0; a < nal; a++) expected[a] = 0;
+    for(int c = 0; c < ncls; c++){
+      for(int g = 0; g < tabs[c]->ngen; g++){
+        const int* cp = &tabs[c]->copies[(std::size_t)g * nal];
+        const double w = post[classoff[c] + g];
+        for(int a = 0; a < nal; a++) expected[a] += w * cp[a];
+      }
+    }
+    for(int a = 0; a < nal; a++) tot += expected[a];
+    if(!(tot > 0)) break;
+    double change = 0;
+    for(int a = 0; a < nal; a++){
+      const double f = expected[a] / tot;
+      if(std::fabs(f - freq[a]) > change) change = std::fabs(f - freq[a]);
+      freq[a] = f;
+    }
+    if(change < tol) break;
+  }
+  return it;
+}
+
+// Allele frequencies for each locus by EM, from read depths laid out as for
+// genotypeLogLikMixed, with the same error and alpha.  Samples of different
+// ploidies share one set of allele frequencies, and every class must be
+// autopolyploid; see checkHweClasses.  Genotype likelihoods are computed one
+// locus at a time in each thread's own buffer, so the full likelihood array
+// is never held.  Starting values are the read frequencies of each allele
+// pooled across samples, with one read added to each.  freq receives
+// nalleles[L] values for each locus, as in hwePriorsMixed; loci where no
+// sample has reads get NaN.  iter, if not NULL, receives the number of
+// iterations for each locus.  Parallel over loci.
+inline void alleleFreqEMMixed(const int* ad, const int* nalleles,
+                              std::size_t nloci, int nsamples,
+                              const std::vector<PloidyClass>& classes,
+                              const int* sampleClass, double error,
+                              double alpha, double tol, int maxit,
+                              double* freq, int* iter, int nthreads){
+  checkHweClasses(classes);
+  const LogLikSetup setup(ad, nalleles, nloci, nsamples, classes, sampleClass,
+                          error, alpha);
+  const int ncls = classes.size();
+  const std::vector<HweTable> tabs = hweTables(nalleles, nloci, classes,
+                                               setup.maxal);
+  std::vector<std::size_t> freqoff(nloci + 1, 0);
+  std::size_t maxll = 0;
+  std::size_t maxprior = 0;
+  for(std::size_t L = 0; L < nloci; L++){
+    freqoff[L + 1] = freqoff[L] + nalleles[L];
+    const std::size_t nll = setup.outoff[L + 1] - setup.outoff[L];
+    if(nll > maxll) maxll = nll;
+    std::size_t nprior = 0;
+    for(int c = 0; c < ncls; c++){
+      nprior += tabs[c * setup.stride + nalleles[L]].ngen;
+    }
+    if(nprior > maxprior) maxprior = nprior;
+  }
+
+  const long long n = nloci;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    LogLikScratch scratch(setup);
+    std::vector<double> ll(maxll);
+    std::vector<double> prior(maxprior);
+    std::vector<double> post(maxprior);
+    std::vector<const HweTable*> loctabs(ncls);
+    std::vector<char> missing(nsamples);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 4)
+#endif
+    for(long long L = 0; L < n; L++){
+      const int nal = nalleles[L];
+      const int* x = ad + setup.inoff[L];
+      double* f = freq + freqoff[L];
+      for(int a = 0; a < nal; a++) f[a] = 1;
+      int nused = 0;
+      for(int s = 0; s < nsamples; s++){
+        missing[s] = 1;
+        for(int a = 0; a < nal; a++){
+          const int xa = x[(std::size_t)s * nal + a];
+          if(xa <= 0) continue;
+          missing[s] = 0;
+          f[a] += xa;
+        }
+        if(!missing[s]) nused++;
+      }
+      if(nused == 0){
+        for(int a = 0; a < nal; a++){
+          f[a] = std::numeric_limits<double>::quiet_NaN();
+        }
+        if(iter != NULL) iter[L] = 0;
+        continue;
+      }
+      double tot = 0;
+      for(int a = 0; a < nal; a++) tot += f[a];
+      for(int a = 0; a < nal; a++) f[a] /= tot;
+
+      for(int c = 0; c < ncls; c++){
+        loctabs[c] = &tabs[c * setup.stride + nal];
+      }
+      setup.locus(ad, nal, L, ll.data(), scratch);
+      const int it = alleleFreqEM(ll.data(), missing.data(), nsamples,
+                                  sampleClass, loctabs, tol, maxit,
+                                  prior.data(), post.data(), f);
+      if(iter != NULL) iter[L] = it;
+    }
+  }
+}
+
+// alleleFreqEMMixed for samples of one ploidy.
+inline void alleleFreqEMBatch(const int* ad, const int* nalleles,
+                              std::size_t nloci, int nsamples, int ploidy,
+                              double error, double alpha, double tol,
+                              int maxit, double* freq, int* iter,
+                              int nthreads){
+  const std::vector<PloidyClass> classes(1, PloidyClass(ploidy));
+  const std::vector<int> sampleClass(nsamples, 0);
+  alleleFreqEMMixed(ad, nalleles, nloci, nsamples, classes, sampleClass.data(),
+                    error, alpha, tol, maxit, freq, iter, nthreads);
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_HWE_PRIORS_H
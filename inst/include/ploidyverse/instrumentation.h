@@ -0,0 +1,220 @@
+#ifndef PLOIDYVERSE_INSTRUMENTATION_H
+#define PLOIDYVERSE_INSTRUMENTATION_H
+
+// Opt-in counters for the exported functions: calls, wall time, bytes
+// allocated for results and large temporaries, and calls by ploidy and number
+// of alleles (for batch functions, loci by ploidy and number of alleles).
+// Instrumentation is off unless the environment variable PLOIDYVERSE_INSTRUMENT
+// is set to something other than 0, or it is turned on with setEnabled.  When
+// off, a KernelTimer costs one relaxed atomic load and a branch.
+//
+// The counters are process-wide statics, so each shared library that
+// includes this header has its own; those of ploidyverseVcf itself are
+// reached through kernelStats and resetKernelStats.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace ploidyverse {
+
+enum Kernel {
+  KERNEL_DMULTINOM,
+  KERNEL_DDIRICHLETMULTINOM,
+  KERNEL_ENUMERATE_GENOTYPES,
+  KERNEL_INDEX_GENOTYPE,
+  KERNEL_GENOTYPE_FROM_INDEX,
+  KERNEL_INDEX_GENOTYPES,
+  KERNEL_GENOTYPES_FROM_INDEX,
+  KERNEL_ALLELE_COPY,
+  KERNEL_MAKE_GAMETES,
+  KERNEL_GAMETE_DISTRIBUTION,
+  KERNEL_SELFING_MATRIX,
+  KERNEL_SELFING_MATRIX_CSR,
+  KERNEL_APPLY_SELFING,
+  KERNEL_SELFING_GENERATIONS,
+  KERNEL_CROSS_PROGENY,
+  KERNEL_CROSS_PROGENY_FREQ,
+  KERNEL_CROSS_PROGENY_BATCH,
+  KERNEL_GENOTYPE_LIKELIHOODS,
+  KERNEL_LOGLIK_TO_POSTERIOR,
+  KERNEL_ACN_TO_GENO,
+  KERNEL_GENO_TO_ACN,
+  KERNEL_GENOTYPE_CALLS,
+  KERNEL_GENOTYPE_LIKELIHOODS_MIXED,
+  KERNEL_ENUMERATE_PLOIDY_GENOTYPES,
+  KERNEL_FIT_OVERDISPERSION,
+  KERNEL_HWE_PRIORS,
+  KERNEL_ALLELE_FREQ_EM,
+  KERNEL_FIT_OVERDISPERSION_MIXED,
+  KERNEL_HWE_PRIORS_MIXED,
+  KERNEL_ALLELE_FREQ_EM_MIXED,
+  KERNEL_COUNT
+};
+
+// Names of the R functions, in the order of Kernel.  The log-space versions
+// of dmultinom and dDirichletMultinom are counted with them.
+inline const char* kernelName(int k){
+  static const char* names[KERNEL_COUNT] = {
+    "dmultinom", "dDirichletMultinom", "enumerateGenotypes", "indexGenotype",
+    "genotypeFromIndex", "indexGenotypes", "genotypesFromIndex", "alleleCopy",
+    "makeGametes", "gameteDistribution", "selfingMatrix", "selfingMatrixCSR",
+    "applySelfing", "selfingGenerations", "crossProgeny", "crossProgenyFreq",
+    "crossProgenyBatch", "batchGenotypeLikelihoods", "logLikToPosterior",
+    "acnToGenoBatch", "genoToAcnBatch", "genotypeCallsBatch",
+    "batchGenotypeLikelihoodsMixed", "enumeratePloidyGenotypes",
+    "fitOverdispersionBatch", "hwePriorsBatch", "alleleFreqEMBatch",
+    "fitOverdispersionMixed", "hwePriorsMixed", "alleleFreqEMMixed"
+  };
+  return names[k];
+}
+
+// The histogram has bins for ploidy and number of alleles up to this value;
+// larger values share the last bin.  Zero means not applicable, for example the
+// ploidy of dmultinom.
+static const int instrumentMaxBin = 16;
+
+struct KernelStats {
+  unsigned long long calls;
+  unsigned long long nanoseconds;
+  unsigned long long bytes;
+  // calls (or loci) for each ploidy (rows) and number of alleles (columns),
+  // from 0 to instrumentMaxBin, stored row by row
+  std::vector<unsigned long long> histogram;
+};
+
+class Instrumentation {
+public:
+  Instrumentation() {
+    const char* env = std::getenv("PLOIDYVERSE_INSTRUMENT");
+    enabled_.store(env != NULL && env[0] != '\0' && std::strcmp(env, "0") != 0);
+    reset();
+  }
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // Returns the previous setting.
+  bool setEnabled(bool on){ return enabled_.exchange(on); }
+
+  void record(int kernel, unsigned long long ns, unsigned long long bytes){
+    Counters& c = counters_[kernel];
+    c.calls.fetch_add(1, std::memory_order_relaxed);
+    c.nanoseconds.fetch_add(ns, std::memory_order_relaxed);
+    c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  // Add n to the histogram bin for a ploidy and number of alleles.
+  void count(int kernel, int ploidy, int nalleles, unsigned long long n){
+    counters_[kernel].histogram[bin(ploidy) * nbin + bin(nalleles)]
+      .fetch_add(n, std::memory_order_relaxed);
+  }
+
+  std::vector<KernelStats> snapshot() const {
+    std::vector<KernelStats> out(KERNEL_COUNT);
+    for(int k = 0; k < KERNEL_COUNT; k++){
+      const Counters& c = counters_[k];
+      out[k].calls = c.calls.load();
+      out[k].nanoseconds = c.nanoseconds.load();
+      out[k].bytes = c.bytes.load();
+      out[k].histogram.resize(nbin * nbin);
+      for(int i = 0; i < nbin * nbin; i++) out[k].histogram[i] = c.histogram[i].load();
+    }
+    return out;
+  }
+
+  void reset(){
+    for(int k = 0; k < KERNEL_COUNT; k++){
+      Counters& c = counters_[k];
+      c.calls.store(0);
+      c.nanoseconds.store(0);
+      c.bytes.store(0);
+      for(int i = 0; i < nbin * nbin; i++) c.histogram[i].store(0);
+    }
+  }
+
+private:
+  static const int nbin = instrumentMaxBin + 1;
+
+  static int bin(int x){
+    return x < 0 ? 0 : (x > instrumentMaxBin ? instrumentMaxBin : x);
+  }
+
+  struct Counters {
+    std::atomic<unsigned long long> calls;
+    std::atomic<unsigned long long> nanoseconds;
+    std::atomic<unsigned long long> bytes;
+    std::atomic<unsigned long long> histogram[nbin * nbin];
+  };
+
+  std::atomic<bool> enabled_;
+  Counters counters_[KERNEL_COUNT];
+};
+
+inline Instrumentation& instrumentation(){
+  static Instrumentation inst;
+  return inst;
+}
+
+// Records one call when it goes out of scope, if instrumentation was on when
+// it was created.  Place at the top of an exported function, and add the
+// sizes of allocations with addBytes.
+class KernelTimer {
+public:
+  KernelTimer(int kernel, int ploidy, int nalleles)
+    : on_(instrumentation().enabled()), kernel_(kernel), ploidy_(ploidy),
+      nalleles_(nalleles), bytes_(0), loci_(false) {
+    if(on_) start_ = std::chrono::steady_clock::now();
+  }
+
+  ~KernelTimer(){
+    if(!on_) return;
+    const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_).count();
+    Instrumentation& inst = instrumentation();
+    inst.record(kernel_, ns, bytes_);
+    if(!loci_) inst.count(kernel_, ploidy_, nalleles_, 1);
+  }
+
+  bool on() const { return on_; }
+
+  void addBytes(double bytes){
+    if(on_) bytes_ += (unsigned long long)bytes;
+  }
+
+  // For functions where the number of alleles is only known later.
+  void setAlleles(int nalleles){ nalleles_ = nalleles; }
+
+  // For batch functions, count each of n loci in the histogram by its number
+  // of alleles, rather than counting the call once.
+  void addLoci(const int* nalleles, std::size_t n){
+    if(!on_) return;
+    loci_ = true;
+    unsigned long long counts[instrumentMaxBin + 1] = {0};
+    for(std::size_t L = 0; L < n; L++){
+      const int a = nalleles[L];
+      counts[a < 0 ? 0 : (a > instrumentMaxBin ? instrumentMaxBin : a)]++;
+    }
+    for(int a = 0; a <= instrumentMaxBin; a++){
+      if(counts[a] > 0) instrumentation().count(kernel_, ploidy_, a, counts[a]);
+    }
+  }
+
+private:
+  KernelTimer(const KernelTimer&);
+  KernelTimer& operator=(const KernelTimer&);
+
+  bool on_;
+  int kernel_;
+  int ploidy_;
+  int nalleles_;
+  unsigned long long bytes_;
+  bool loci_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_INSTRUMENTATION_H
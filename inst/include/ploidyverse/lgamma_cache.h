@@ -0,0 +1,207 @@
+#ifndef PLOIDYVERSE_LGAMMA_CACHE_H
+#define PLOIDYVERSE_LGAMMA_CACHE_H
+
+// Process-wide caches of the gamma function terms used by the multinomial and
+// Dirichlet-multinomial kernels.  Read depths are small integers that repeat
+// millions of times, so lgamma is looked up rather than recomputed.
+//
+// Both caches are safe to read from many threads at once.  Growth is
+// serialized with a mutex, and entries are never moved once published.  The
+// batch kernels take everything they need from the caches before their
+// threads start, so no lock is taken per lookup.
+
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ploidyverse {
+
+// Hit and miss counts, accumulated locally by a kernel and added to the
+// global totals once per call so that counting does not cost an atomic
+// operation per lookup.
+struct CacheCounts {
+  unsigned long long hits;
+  unsigned long long misses;
+  CacheCounts() : hits(0), misses(0) {}
+};
+
+// Table of log(n!) = lgamma(n + 1) for n = 0, 1, 2, ..., grown in blocks.
+class LogFactorialTable {
+public:
+  static const long blockBits = 12;
+  static const long blockSize = 1L << blockBits;
+  static const long maxBlocks = 1024; // up to about four million entries
+  static const long maxSize = blockSize * maxBlocks;
+
+  LogFactorialTable() : size_(0), hits_(0), misses_(0) {}
+
+  long size() const { return size_.load(std::memory_order_acquire); }
+
+  // Unchecked lookup; i must be below size().
+  double at(long i) const {
+    return blocks_[i >> blockBits][i & (blockSize - 1)];
+  }
+
+  // Make sure log(n!) is in the table, if n is within the maximum size.
+  void reserve(long n){
+    if(n < size() || n >= maxSize) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    long sz = size_.load(std::memory_order_relaxed);
+    while(sz <= n){
+      double* blk = new double[blockSize];
+      for(long j = 0; j < blockSize; j++){
+        blk[j] = std::lgamma((double)(sz + j) + 1);
+      }
+      blocks_[sz >> blockBits].reset(blk);
+      sz += blockSize;
+    }
+    size_.store(sz, std::memory_order_release);
+  }
+
+  // log(n!), using the table if n is a non-negative integer within range.
+  double get(double n, CacheCounts& counts){
+    if(n >= 0 && n < maxSize && n == std::floor(n)){
+      long i = (long)n;
+      if(i < size()){
+        counts.hits++;
+      } else {
+        counts.misses++;
+        reserve(i);
+      }
+      return at(i);
+    }
+    counts.misses++;
+    return std::lgamma(n + 1);
+  }
+
+  void addCounts(const CacheCounts& counts){
+    hits_.fetch_add(counts.hits, std::memory_order_relaxed);
+    misses_.fetch_add(counts.misses, std::memory_order_relaxed);
+  }
+  unsigned long long hits() const { return hits_.load(); }
+  unsigned long long misses() const { return misses_.load(); }
+  void resetCounts(){
+    hits_.store(0);
+    misses_.store(0);
+  }
+
+private:
+  std::atomic<long> size_;
+  std::unique_ptr<double[]> blocks_[maxBlocks];
+  std::mutex mutex_;
+  std::atomic<unsigned long long> hits_;
+  std::atomic<unsigned long long> misses_;
+};
+
+inline LogFactorialTable& logFactorialTable(){
+  static LogFactorialTable table;
+  return table;
+}
+
+// lgamma(a + x) - lgamma(a), computed directly.  For a whole number x below
+// 32 this is the log of the rising factorial, summed term by term, which is
+// cheaper than two calls to lgamma.
+inline double gammaTerm(double a, double x){
+  if(x >= 0 && x < 32 && x == std::floor(x)){
+    double s = 0;
+    for(int k = 0; k < x; k++) s += std::log(a + k);
+    return s;
+  }
+  return std::lgamma(a + x) - std::lgamma(a);
+}
+
+// Terms lgamma(a + x) - lgamma(a) of the Dirichlet-multinomial, for
+// x = 0, 1, 2, ..., where a is alpha times the probability of a category.
+// Since the terms depend only on the product, tables are keyed on a, which
+// lets different (alpha, prob) pairs with the same product share a table.
+// The lgamma(n + alpha) - lgamma(alpha) term is the table for a = alpha.
+//
+// Tables are only worth building for a batch, which reuses a handful of
+// values of a across many samples, so they are fetched once per batch before
+// its threads start; single evaluations use gammaTerm instead.  The total
+// size is bounded by maxBytes, beyond which the cache is emptied.
+typedef std::shared_ptr<const std::vector<double> > GammaTerms;
+
+class DirichletGammaCache {
+public:
+  static const int maxLength = 1 << 16; // longest table, in read depth
+  static const std::size_t maxBytes = (std::size_t)1 << 26; // 64 MB in all
+
+  DirichletGammaCache() : bytes_(0), hits_(0), misses_(0) {}
+
+  // Table for a with at least maxx + 1 entries.  maxx must be below
+  // maxLength.  The returned pointer stays valid after the cache is cleared.
+  GammaTerms get(double a, int maxx, CacheCounts& counts){
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<double, GammaTerms>::iterator it = tables_.find(a);
+    if(it != tables_.end() && (int)it->second->size() > maxx){
+      counts.hits++;
+      return it->second;
+    }
+    counts.misses++;
+    // grow geometrically so that a slowly increasing depth does not rebuild
+    // the table every time
+    int len = 64;
+    while(len <= maxx) len *= 2;
+    if(len > maxLength) len = maxLength;
+    std::vector<double>* terms = new std::vector<double>(len);
+    double lga = std::lgamma(a);
+    for(int x = 0; x < len; x++){
+      (*terms)[x] = std::lgamma(a + x) - lga;
+    }
+    GammaTerms out(terms);
+    if(it != tables_.end()){
+      bytes_ -= it->second->size() * sizeof(double);
+      tables_.erase(it);
+    }
+    const std::size_t nbytes = len * sizeof(double);
+    if(bytes_ + nbytes > maxBytes){
+      tables_.clear();
+      bytes_ = 0;
+    }
+    tables_[a] = out;
+    bytes_ += nbytes;
+    return out;
+  }
+
+  void addCounts(const CacheCounts& counts){
+    hits_.fetch_add(counts.hits, std::memory_order_relaxed);
+    misses_.fetch_add(counts.misses, std::memory_order_relaxed);
+  }
+  unsigned long long hits() const { return hits_.load(); }
+  unsigned long long misses() const { return misses_.load(); }
+  std::size_t entries(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tables_.size();
+  }
+  std::size_t bytes(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+  }
+  void clear(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_.clear();
+    bytes_ = 0;
+    hits_.store(0);
+    misses_.store(0);
+  }
+
+private:
+  std::map<double, GammaTerms> tables_;
+  std::size_t bytes_;
+  std::mutex mutex_;
+  std::atomic<unsigned long long> hits_;
+  std::atomic<unsigned long long> misses_;
+};
+
+inline DirichletGammaCache& dirichletGammaCache(){
+  static DirichletGammaCache cache;
+  return cache;
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_LGAMMA_CACHE_H
@@ -0,0 +1,581 @@
+#ifndef PLOIDYVERSE_LIKELIHOOD_KERNELS_H
+#define PLOIDYVERSE_LIKELIHOOD_KERNELS_H
+
+// Plain C++ kernels for genotype likelihoods across many loci and samples.
+// Nothing here touches the R API, so these can run inside OpenMP threads.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <vector>
+#include "fixed_genotypes.h"
+#include "genotype_tables.h"
+#include "lgamma_cache.h"
+#include "ploidy_classes.h"
+#include "threads.h"
+
+namespace ploidyverse {
+
+// Probability of sampling a read of each allele from each genotype, for one
+// ploidy and number of alleles.  A sequencing error rate spreads some
+// probability evenly across all alleles.  Where the probability is zero, a
+// read of that allele makes the genotype impossible, as in dmultinom.
+struct ReadProbTable {
+  int ngen;
+  int nalleles;
+  std::vector<double> prob;    // ngen x nalleles
+  std::vector<double> logprob; // ngen x nalleles
+
+  ReadProbTable() : ngen(0), nalleles(0) {}
+  ReadProbTable(int ploidy, int nal, double error)
+    : ReadProbTable(PloidyClass(ploidy), nal, error) {}
+  // For allopolyploids, from copy numbers summed across subgenomes.
+  ReadProbTable(const PloidyClass& cls, int nal, double error) : nalleles(nal) {
+    std::vector<int> copies = classCopyTable(cls, nal);
+    ngen = copies.size() / nal;
+    prob.resize(copies.size());
+    logprob.resize(copies.size());
+    for(std::size_t i = 0; i < copies.size(); i++){
+      prob[i] = (1 - error) * copies[i] / cls.ploidy + error / nal;
+      logprob[i] = prob[i] > 0 ? std::log(prob[i]) :
+        -std::numeric_limits<double>::infinity();
+    }
+  }
+};
+
+// Log of the multinomial probability of counts x given category
+// probabilities prob, for k categories.  As in stats::dmultinom, categories
+// with zero probability are dropped if their count is zero, and otherwise
+// the result is -Inf.
+inline double logMultinom(const double* x, const double* prob, int k){
+  LogFactorialTable& lf = logFactorialTable();
+  CacheCounts counts;
+  double n = 0;
+  double s = 0;
+  for(int a = 0; a < k; a++){
+    if(!(prob[a] > 0)){
+      if(x[a] > 0) return -std::numeric_limits<double>::infinity();
+      continue;
+    }
+    n += x[a];
+    s += x[a] * std::log(prob[a]) - lf.get(x[a], counts);
+  }
+  double out = lf.get(n, counts) + s;
+  lf.addCounts(counts);
+  return out;
+}
+
+// Log of the Dirichlet-multinomial probability of counts x given category
+// probabilities prob and overdispersion parameter alpha.  Zero probabilities
+// are handled as in logMultinom.
+inline double logDirichletMultinom(const double* x, const double* prob, int k,
+                                   double alpha){
+  for(int a = 0; a < k; a++){
+    if(!(prob[a] > 0) && x[a] > 0){
+      return -std::numeric_limits<double>::infinity();
+    }
+  }
+  LogFactorialTable& lf = logFactorialTable();
+  CacheCounts counts;
+  double n = 0;
+  double s = 0;
+  for(int a = 0; a < k; a++){
+    if(!(prob[a] > 0)) continue;
+    n += x[a];
+    s += gammaTerm(alpha * prob[a], x[a]) - lf.get(x[a], counts);
+  }
+  double out = lf.get(n, counts) - gammaTerm(alpha, n) + s;
+  lf.addCounts(counts);
+  return out;
+}
+
+// Posterior probabilities of ngen genotypes from their log-likelihoods,
+// normalized with the log-sum-exp trick so that high read depths do not
+// underflow.  logprior may be NULL for a uniform prior.  If logout is true,
+// log posterior probabilities are returned.  If no genotype has a finite
+// log-likelihood, the output is NaN.
+inline void logLikToPosterior(const double* ll, const double* logprior,
+                              int ngen, bool logout, double* out){
+  double mx = -std::numeric_limits<double>::infinity();
+  for(int g = 0; g < ngen; g++){
+    out[g] = logprior != NULL ? ll[g] + logprior[g] : ll[g];
+    if(out[g] > mx) mx = out[g];
+  }
+  if(!std::isfinite(mx)){
+    for(int g = 0; g < ngen; g++){
+      out[g] = std::numeric_limits<double>::quiet_NaN();
+    }
+    return;
+  }
+  double tot = 0;
+  for(int g = 0; g < ngen; g++){
+    tot += std::exp(out[g] - mx);
+  }
+  const double lse = mx + std::log(tot);
+  for(int g = 0; g < ngen; g++){
+    out[g] = logout ? out[g] - lse : std::exp(out[g] - lse);
+  }
+}
+
+// logLikToPosterior over nblocks consecutive blocks of ngen values, such as
+// the output of genotypeLogLikBatch for loci with the same number of alleles.
+// logprior is NULL, ngen values shared by all blocks, or one set per block
+// if priorPerBlock is true.  Parallel over blocks.
+inline void logLikToPosteriorBatch(const double* ll, const double* logprior,
+                                   bool priorPerBlock, int ngen,
+                                   std::size_t nblocks, bool logout,
+                                   double* out, int nthreads){
+  const long long n = nblocks;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(static)
+#endif
+  for(long long b = 0; b < n; b++){
+    std::size_t off = (std::size_t)b * ngen;
+    const double* lp = logprior;
+    if(logprior != NULL && priorPerBlock) lp = logprior + off;
+    logLikToPosterior(ll + off, lp, ngen, logout, out + off);
+  }
+}
+
+// Cached Dirichlet-multinomial terms for one ReadProbTable and alpha, fetched
+// before a batch starts so that the threads never touch the cache's lock.
+// Pointers are NULL where the probability is zero, or where the read depth
+// is too high for the cache, in which case gammaTerm is called directly.
+struct DirichletTermTable {
+  std::vector<GammaTerms> owners;
+  std::vector<const double*> cat; // ngen x nalleles
+  const double* total;            // for the alpha, n term
+
+  DirichletTermTable() : total(NULL) {}
+  DirichletTermTable(const ReadProbTable& tab, double alpha, int maxx, long maxn,
+                     CacheCounts& counts) : total(NULL) {
+    DirichletGammaCache& dg = dirichletGammaCache();
+    cat.assign(tab.prob.size(), NULL);
+    if(maxx < DirichletGammaCache::maxLength){
+      std::map<double, const double*> seen;
+      for(std::size_t i = 0; i < tab.prob.size(); i++){
+        if(!(tab.prob[i] > 0)) continue;
+        double ap = alpha * tab.prob[i];
+        if(seen.find(ap) == seen.end()){
+          GammaTerms t = dg.get(ap, maxx, counts);
+          owners.push_back(t);
+          seen[ap] = t->data();
+        }
+        cat[i] = seen[ap];
+      }
+    }
+    if(maxn < DirichletGammaCache::maxLength){
+      GammaTerms t = dg.get(alpha, (int)maxn, counts);
+      owners.push_back(t);
+      total = t->data();
+    }
+  }
+};
+
+// log(n!) from a table already grown to at least size entries.
+inline double tableLogFactorial(const LogFactorialTable& lf, long size, long n){
+  return n < size ? lf.at(n) : std::lgamma(n + 1.0);
+}
+
+// Log-likelihood of every genotype for one sample at one locus.
+// x is the read depth for each allele, and out receives ngen values.
+// dm is NULL for the multinomial, otherwise the Dirichlet-multinomial is used.
+inline void sampleLogLik(const int* x, const ReadProbTable& tab,
+                         const DirichletTermTable* dm, double alpha,
+                         const LogFactorialTable& lf, long lfsize,
+                         double* lfx, double* out){
+  const int nal = tab.nalleles;
+  bool missing = true;
+  for(int a = 0; a < nal; a++){
+    // negative values, including NA_INTEGER, are treated as no reads
+    if(x[a] > 0) missing = false;
+    lfx[a] = x[a] > 0 ? tableLogFactorial(lf, lfsize, x[a]) : 0;
+  }
+  if(missing){
+    for(int g = 0; g < tab.ngen; g++) out[g] = 0;
+    return;
+  }
+
+  for(int g = 0; g < tab.ngen; g++){
+    const double* p = &tab.prob[g * nal];
+    const double* lp = &tab.logprob[g * nal];
+    long n = 0;
+    double s = 0;
+    bool impossible = false;
+    for(int a = 0; a < nal; a++){
+      int xa = x[a] > 0 ? x[a] : 0;
+      if(p[a] <= 0){
+        // a read of an allele the genotype lacks
+        if(xa > 0) impossible = true;
+        continue;
+      }
+      n += xa;
+      if(dm != NULL){
+        const double* terms = dm->cat[g * nal + a];
+        s += (terms != NULL ? terms[xa] : gammaTerm(alpha * p[a], xa)) -
+          lfx[a];
+      } else {
+        s += xa * lp[a] - lfx[a];
+      }
+    }
+    if(impossible){
+      out[g] = -std::numeric_limits<double>::infinity();
+      continue;
+    }
+    out[g] = tableLogFactorial(lf, lfsize, n) + s;
+    if(dm != NULL){
+      out[g] -= dm->total != NULL ? dm->total[n] : gammaTerm(alpha, n);
+    }
+  }
+}
+
+// sampleLogLik for ploidy P and A alleles.  The sums are the same and in the
+// same order, so results are identical, but the loops have constant bounds
+// and the read depths and their log factorials stay on the stack.
+template<int P, int A>
+inline void sampleLogLikFixed(const int* x, const ReadProbTable& tab,
+                              const DirichletTermTable* dm, double alpha,
+                              const LogFactorialTable& lf, long lfsize,
+                              double* out){
+  const int ngen = FixedGenotypes<P, A>::ngen;
+  int xa[A];
+  double lfx[A];
+  bool missing = true;
+  for(int a = 0; a < A; a++){
+    xa[a] = x[a] > 0 ? x[a] : 0;
+    if(xa[a] > 0) missing = false;
+    lfx[a] = xa[a] > 0 ? tableLogFactorial(lf, lfsize, xa[a]) : 0;
+  }
+  if(missing){
+    for(int g = 0; g < ngen; g++) out[g] = 0;
+    return;
+  }
+
+  if(dm == NULL){
+    for(int g = 0; g < ngen; g++){
+      const double* p = &tab.prob[g * A];
+      const double* lp = &tab.logprob[g * A];
+      long n = 0;
+      double s = 0;
+      bool impossible = false;
+      for(int a = 0; a < A; a++){
+        if(p[a] <= 0){
+          if(xa[a] > 0) impossible = true;
+          continue;
+        }
+        n += xa[a];
+        s += xa[a] * lp[a] - lfx[a];
+      }
+      out[g] = impossible ? -std::numeric_limits<double>::infinity() :
+        tableLogFactorial(lf, lfsize, n) + s;
+    }
+    return;
+  }
+  for(int g = 0; g < ngen; g++){
+    const double* p = &tab.prob[g * A];
+    long n = 0;
+    double s = 0;
+    bool impossible = false;
+    for(int a = 0; a < A; a++){
+      if(p[a] <= 0){
+        if(xa[a] > 0) impossible = true;
+        continue;
+      }
+      n += xa[a];
+      const double* terms = dm->cat[g * A + a];
+      s += (terms != NULL ? terms[xa[a]] : gammaTerm(alpha * p[a], xa[a])) -
+        lfx[a];
+    }
+    if(impossible){
+      out[g] = -std::numeric_limits<double>::infinity();
+      continue;
+    }
+    out[g] = tableLogFactorial(lf, lfsize, n) + s;
+    out[g] -= dm->total != NULL ? dm->total[n] : gammaTerm(alpha, n);
+  }
+}
+
+// Log-likelihoods for all samples at one locus, with x and out laid out as
+// for one locus in genotypeLogLikBatch.  lfx is scratch space for nalleles
+// values.
+typedef void (*LocusLogLikFn)(const int* x, int nsamples,
+                              const ReadProbTable& tab,
+                              const DirichletTermTable* dm, double alpha,
+                              const LogFactorialTable& lf, long lfsize,
+                              double* lfx, double* out);
+
+inline void locusLogLik(const int* x, int nsamples, const ReadProbTable& tab,
+                        const DirichletTermTable* dm, double alpha,
+                        const LogFactorialTable& lf, long lfsize, double* lfx,
+                        double* out){
+  for(int s = 0; s < nsamples; s++){
+    sampleLogLik(x + (std::size_t)s * tab.nalleles, tab, dm, alpha, lf, lfsize,
+                 lfx, out + (std::size_t)s * tab.ngen);
+  }
+}
+
+template<int P, int A>
+inline void locusLogLikFixed(const int* x, int nsamples,
+                             const ReadProbTable& tab,
+                             const DirichletTermTable* dm, double alpha,
+                             const LogFactorialTable& lf, long lfsize,
+                             double*, double* out){
+  for(int s = 0; s < nsamples; s++){
+    sampleLogLikFixed<P, A>(x + (std::size_t)s * A, tab, dm, alpha, lf, lfsize,
+                            out + (std::size_t)s * FixedGenotypes<P, A>::ngen);
+  }
+}
+
+struct LocusLogLikSelector {
+  LocusLogLikFn fn;
+  template<int P, int A> void run(){ fn = &locusLogLikFixed<P, A>; }
+};
+
+// The specialized locus kernel for a ploidy class and number of alleles, or
+// the generic one if there is none.  Allopolyploids always use the generic
+// kernel, since their genotypes are not those of the compile-time tables.
+inline LocusLogLikFn locusLogLikFor(const PloidyClass& cls, int nalleles){
+  LocusLogLikSelector f = {&locusLogLik};
+  if(cls.autopolyploid()) dispatchFixed(cls.ploidy, nalleles, f);
+  return f.fn;
+}
+
+struct LogLikScratch;
+
+// Tables for genotypeLogLikMixed, built before threads start: a read
+// probability table, locus kernel and Dirichlet-multinomial terms for each
+// ploidy class and number of alleles present, the samples of each class, the
+// offset of each locus in the input and output, and the log factorial table
+// grown to cover the deepest sample.  locus() then computes the
+// log-likelihoods for one locus, and may be called from any thread with its
+// own LogLikScratch.
+struct LogLikSetup {
+  int maxal;
+  int maxgen;                         // most genotypes of any class
+  int stride;                         // tables are at class * stride + nalleles
+  std::vector<int> sampleClass;
+  // samples of each class present, in order of first appearance; a group
+  // whose samples are consecutive goes to its kernel in place, and others
+  // are gathered into scratch space
+  std::vector<int> groupClass;
+  std::vector<std::vector<int> > groupSamples;
+  std::vector<char> groupContiguous;
+  bool gathered;                      // whether any group is not consecutive
+  std::size_t maxGathered;            // samples in the largest such group
+  std::vector<ReadProbTable> tabs;
+  std::vector<LocusLogLikFn> kernels;
+  std::vector<DirichletTermTable> dmtabs;
+  std::vector<std::size_t> inoff;     // start of each locus in ad
+  std::vector<std::size_t> outoff;    // start of each locus in out
+  bool usedm;
+  double alpha;
+  long lfsize;
+
+  LogLikSetup(const int* ad, const int* nalleles, std::size_t nloci,
+              int nsamples, const std::vector<PloidyClass>& classes,
+              const int* sclass, double error, double alph)
+    : maxal(0), maxgen(0), sampleClass(sclass, sclass + nsamples),
+      gathered(false), maxGathered(0), inoff(nloci + 1, 0),
+      outoff(nloci + 1, 0), usedm(alph > 0 && std::isfinite(alph)),
+      alpha(alph) {
+    const int ncls = classes.size();
+    for(std::size_t L = 0; L < nloci; L++){
+      if(nalleles[L] > maxal) maxal = nalleles[L];
+    }
+
+    std::vector<int> group(ncls, -1);
+    for(int s = 0; s < nsamples; s++){
+      const int c = sampleClass[s];
+      if(group[c] < 0){
+        group[c] = groupClass.size();
+        groupClass.push_back(c);
+        groupSamples.push_back(std::vector<int>());
+      }
+      groupSamples[group[c]].push_back(s);
+    }
+    for(std::size_t k = 0; k < groupSamples.size(); k++){
+      const std::vector<int>& gs = groupSamples[k];
+      const bool contig = gs.back() - gs.front() + 1 == (int)gs.size();
+      groupContiguous.push_back(contig);
+      if(!contig){
+        gathered = true;
+        if(gs.size() > maxGathered) maxGathered = gs.size();
+      }
+    }
+
+    stride = maxal + 1;
+    tabs.resize((std::size_t)ncls * stride);
+    kernels.resize((std::size_t)ncls * stride);
+    std::vector<bool> present(stride, false);
+    for(std::size_t L = 0; L < nloci; L++){
+      int nal = nalleles[L];
+      if(!present[nal]){
+        present[nal] = true;
+        for(std::size_t k = 0; k < groupClass.size(); k++){
+          const int c = groupClass[k];
+          tabs[c * stride + nal] = ReadProbTable(classes[c], nal, error);
+          kernels[c * stride + nal] = locusLogLikFor(classes[c], nal);
+          if(tabs[c * stride + nal].ngen > maxgen){
+            maxgen = tabs[c * stride + nal].ngen;
+          }
+        }
+      }
+      std::size_t ncell = 0;
+      for(std::size_t k = 0; k < groupClass.size(); k++){
+        ncell += (std::size_t)tabs[groupClass[k] * stride + nal].ngen *
+          groupSamples[k].size();
+      }
+      inoff[L + 1] = inoff[L] + (std::size_t)nal * nsamples;
+      outoff[L + 1] = outoff[L] + ncell;
+    }
+
+    // grow the shared caches up front to cover the deepest sample
+    int maxx = 0;
+    long maxn = 0;
+    for(std::size_t L = 0; L < nloci; L++){
+      for(int s = 0; s < nsamples; s++){
+        const int* x = ad + inoff[L] + (std::size_t)s * nalleles[L];
+        long n = 0;
+        for(int a = 0; a < nalleles[L]; a++){
+          if(x[a] <= 0) continue;
+          n += x[a];
+          if(x[a] > maxx) maxx = x[a];
+        }
+        if(n > maxn) maxn = n;
+      }
+    }
+    LogFactorialTable& lf = logFactorialTable();
+    lf.reserve(maxn);
+    lfsize = lf.size();
+
+    dmtabs.resize(tabs.size());
+    if(usedm){
+      CacheCounts dgcounts;
+      for(std::size_t k = 0; k < tabs.size(); k++){
+        if(tabs[k].nalleles == 0) continue;
+        dmtabs[k] = DirichletTermTable(tabs[k], alpha, maxx, maxn, dgcounts);
+      }
+      dirichletGammaCache().addCounts(dgcounts);
+    }
+  }
+
+  // Number of genotypes for sample s at a locus with nal alleles.
+  int ngen(int s, int nal) const {
+    return tabs[sampleClass[s] * stride + nal].ngen;
+  }
+
+  // Log-likelihoods at locus L into out, which receives outoff[L + 1] -
+  // outoff[L] values, for each sample in turn.
+  void locus(const int* ad, int nal, std::size_t L, double* out,
+             LogLikScratch& scratch) const;
+};
+
+// Per-thread scratch space for LogLikSetup::locus.
+struct LogLikScratch {
+  std::vector<double> lfx;
+  std::vector<int> x;              // read depths of a gathered group
+  std::vector<double> ll;          // log-likelihoods of a gathered group
+  std::vector<std::size_t> off;    // start of each sample in the output
+
+  explicit LogLikScratch(const LogLikSetup& setup)
+    : lfx(setup.maxal),
+      x(setup.maxGathered * setup.maxal),
+      ll(setup.maxGathered * setup.maxgen),
+      off(setup.gathered ? setup.sampleClass.size() : 0) {}
+};
+
+inline void LogLikSetup::locus(const int* ad, int nal, std::size_t L,
+                               double* out, LogLikScratch& scratch) const {
+  const LogFactorialTable& lf = logFactorialTable();
+  const int* x = ad + inoff[L];
+  const int nsamples = sampleClass.size();
+  if(gathered){
+    // start of each sample's values in out
+    std::size_t o = 0;
+    for(int s = 0; s < nsamples; s++){
+      scratch.off[s] = o;
+      o += ngen(s, nal);
+    }
+  }
+  double* o = out;
+  for(std::size_t k = 0; k < groupClass.size(); k++){
+    const int c = groupClass[k] * stride + nal;
+    const std::vector<int>& gs = groupSamples[k];
+    const int ns = gs.size();
+    const ReadProbTable& tab = tabs[c];
+    const DirichletTermTable* dm = usedm ? &dmtabs[c] : NULL;
+    if(groupContiguous[k]){
+      double* dest = gathered ? out + scratch.off[gs.front()] : o;
+      kernels[c](x + (std::size_t)gs.front() * nal, ns, tab, dm, alpha, lf,
+                 lfsize, scratch.lfx.data(), dest);
+      o += (std::size_t)ns * tab.ngen;
+    } else {
+      for(int i = 0; i < ns; i++){
+        const int* xs = x + (std::size_t)gs[i] * nal;
+        std::copy(xs, xs + nal, scratch.x.begin() + (std::size_t)i * nal);
+      }
+      kernels[c](scratch.x.data(), ns, tab, dm, alpha, lf, lfsize,
+                 scratch.lfx.data(), scratch.ll.data());
+      for(int i = 0; i < ns; i++){
+        const double* ls = scratch.ll.data() + (std::size_t)i * tab.ngen;
+        std::copy(ls, ls + tab.ngen, out + scratch.off[gs[i]]);
+      }
+    }
+  }
+}
+
+// genotypeLogLikBatch for samples of different ploidies, including
+// allopolyploids.  Sample s belongs to classes[sampleClass[s]], and at each
+// locus has classGenotypeCount(class, nalleles) values in out, in the order
+// described in ploidy_classes.h.  Otherwise the layout is as in
+// genotypeLogLikBatch, so out must hold that count summed over samples and
+// loci.  The samples of each class go to the locus kernel for that class and
+// number of alleles in one call.  If they are not consecutive they are first
+// copied to scratch space, so sorting samples by ploidy saves a copy, but any
+// order gives the same results.  Parallel over loci.
+inline void genotypeLogLikMixed(const int* ad, const int* nalleles,
+                                std::size_t nloci, int nsamples,
+                                const std::vector<PloidyClass>& classes,
+                                const int* sampleClass, double error,
+                                double alpha, double* out, int nthreads){
+  const LogLikSetup setup(ad, nalleles, nloci, nsamples, classes, sampleClass,
+                          error, alpha);
+  const long long n = nloci;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    LogLikScratch scratch(setup);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for(long long L = 0; L < n; L++){
+      setup.locus(ad, nalleles[L], L, out + setup.outoff[L], scratch);
+    }
+  }
+}
+
+// Genotype log-likelihoods for many loci and samples at once.
+// ad holds read depths with alleles varying fastest, then samples, then loci,
+// so locus L occupies nalleles[L] * nsamples values.  A dense 3D array
+// (allele x sample x locus) has exactly this layout.  out is laid out the
+// same way with genotypes in place of alleles, and must hold
+// sum(ngen[L]) * nsamples values.  If alpha is positive and finite the
+// Dirichlet-multinomial is used, otherwise the multinomial.  Loci whose
+// ploidy and number of alleles have a compile-time specialization use it.
+// Parallel over loci.
+inline void genotypeLogLikBatch(const int* ad, const int* nalleles,
+                                std::size_t nloci, int nsamples, int ploidy,
+                                double error, double alpha, double* out,
+                                int nthreads){
+  std::vector<PloidyClass> classes(1, PloidyClass(ploidy));
+  std::vector<int> sampleClass(nsamples, 0);
+  genotypeLogLikMixed(ad, nalleles, nloci, nsamples, classes,
+                      sampleClass.data(), error, alpha, out, nthreads);
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_LIKELIHOOD_KERNELS_H
@@ -0,0 +1,128 @@
+#ifndef PLOIDYVERSE_MULTIALLELE_UTILS_H
+#define PLOIDYVERSE_MULTIALLELE_UTILS_H
+
+// The functions of multiallele_utils.cpp on raw pointers and plain integers,
+// for calling from C++ without creating R objects.  The Rcpp exports are thin
+// wrappers around these, so results are identical.  Genotypes are arrays of
+// ploidy allele indices in ascending order, and indices of genotypes are in
+// VCF order, counting from zero.  Diploids, tetraploids and hexaploids with
+// up to four alleles go through the compile-time specializations in
+// fixed_genotypes.h.
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "fixed_genotypes.h"
+#include "gamete_kernels.h"
+#include "genotype_tables.h"
+#include "likelihood_kernels.h"
+
+namespace ploidyverse {
+
+// Multinomial probability of counts x given category probabilities prob, for
+// k categories.
+inline double dmultinom(const double* x, const double* prob, int k){
+  return std::exp(logMultinom(x, prob, k));
+}
+
+inline double dmultinomLog(const double* x, const double* prob, int k){
+  return logMultinom(x, prob, k);
+}
+
+// Dirichlet-multinomial probability, with overdispersion parameter alpha.
+inline double dDirichletMultinom(const double* x, const double* prob, int k,
+                                 double alpha){
+  return std::exp(logDirichletMultinom(x, prob, k, alpha));
+}
+
+inline double dDirichletMultinomLog(const double* x, const double* prob, int k,
+                                    double alpha){
+  return logDirichletMultinom(x, prob, k, alpha);
+}
+
+// Number of genotypes, or ULLONG_MAX if beyond 64 bits.
+inline unsigned long long nGen(int ploidy, int nalleles){
+  return countGenotypes(ploidy, nalleles);
+}
+
+// All genotypes in VCF order, ploidy values each, into out, which must hold
+// nGen(ploidy, nalleles) * ploidy values.  For repeated use, genotypeTable
+// returns a shared copy instead.
+struct EnumerateGenotypesFixed {
+  int* out;
+  template<int P, int A> void run(){ enumerateGenotypesFixed<P, A>(out); }
+};
+
+inline void enumerateGenotypes(int ploidy, int nalleles, int* out){
+  EnumerateGenotypesFixed f = {out};
+  if(!dispatchFixed(ploidy, nalleles, f)){
+    enumerateGenotypesInto(ploidy, nalleles, out);
+  }
+}
+
+// Ranks genotypes of ploidy P from the compile-time table when all of their
+// alleles are in it.
+template<int P>
+inline unsigned long long indexGenotypeFixed(const int* genotype){
+  bool intable = true;
+  for(int i = 0; i < P; i++){
+    if(genotype[i] < 0 || genotype[i] >= fixedMaxAlleles) intable = false;
+  }
+  return intable ? rankGenotypeFixed<P>(genotype) : rankGenotype(genotype, P);
+}
+
+// Index of a genotype.  canRankGenotypes(ploidy, genotype[ploidy - 1]) must
+// be true.
+inline unsigned long long indexGenotype(const int* genotype, int ploidy){
+  switch(ploidy){
+  case 2: return indexGenotypeFixed<2>(genotype);
+  case 4: return indexGenotypeFixed<4>(genotype);
+  case 6: return indexGenotypeFixed<6>(genotype);
+  default: return rankGenotype(genotype, ploidy);
+  }
+}
+
+template<int P>
+inline void genotypeFromIndexFixed(unsigned long long index, int* out){
+  if(index < (unsigned long long)FixedGenotypes<P, fixedMaxAlleles>::ngen){
+    unrankGenotypeFixed<P>(index, out);
+  } else {
+    unrankGenotype(index, P, out);
+  }
+}
+
+// Genotype at an index, into out (ploidy values).
+inline void genotypeFromIndex(unsigned long long index, int ploidy, int* out){
+  switch(ploidy){
+  case 2: genotypeFromIndexFixed<2>(index, out); break;
+  case 4: genotypeFromIndexFixed<4>(index, out); break;
+  case 6: genotypeFromIndexFixed<6>(index, out); break;
+  default: unrankGenotype(index, ploidy, out);
+  }
+}
+
+struct AlleleCopyFixed {
+  const int* genotype;
+  int* out;
+  template<int P, int A> void run(){ alleleCopyFixed<P, A>(genotype, out); }
+};
+
+// Copy number of each allele in a genotype (in any order), into out
+// (nalleles values).
+inline void alleleCopy(const int* genotype, int ploidy, int nalleles, int* out){
+  AlleleCopyFixed f = {genotype, out};
+  if(dispatchFixed(ploidy, nalleles, f)) return;
+  for(int a = 0; a < nalleles; a++) out[a] = 0;
+  for(int i = 0; i < ploidy; i++) out[genotype[i]]++;
+}
+
+// Every way of drawing ploidy/2 of the copies of a genotype, one gamete after
+// another, so that duplicates reflect relative gamete frequency.  For each
+// distinct gamete once, with its probability, use gameteDistribution.
+inline std::vector<int> makeGametes(const int* genotype, int ploidy){
+  return gameteCombinations(genotype, ploidy);
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_MULTIALLELE_UTILS_H
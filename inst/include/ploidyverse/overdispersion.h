@@ -0,0 +1,396 @@
+#ifndef PLOIDYVERSE_OVERDISPERSION_H
+#define PLOIDYVERSE_OVERDISPERSION_H
+
+// Maximum likelihood estimation of the overdispersion parameter alpha of the
+// Dirichlet-multinomial, for each locus or shared across loci, from read
+// depths and genotype probabilities.  Each sample's likelihood is a mixture
+// over its genotypes, weighted by their probabilities:
+//
+//   L(alpha) = prod_s sum_g w[s, g] DM(x[s] | p[g], alpha)
+//
+// The derivative with respect to log(alpha) is found analytically with
+// digamma functions, and its root is found by regula falsi (Illinois
+// variant) between lower and upper bounds on alpha.  Nothing here touches the
+// R API, so these can run inside OpenMP threads.
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "likelihood_kernels.h"
+#include "ploidy_classes.h"
+#include "threads.h"
+
+namespace ploidyverse {
+
+// Digamma function for x > 0, by recurrence up to 10 and then the asymptotic
+// series, accurate to about 1e-13.
+inline double digamma(double x){
+  double out = 0;
+  while(x < 10){
+    out -= 1 / x;
+    x += 1;
+  }
+  const double f = 1 / (x * x);
+  return out + std::log(x) - 0.5 / x -
+    f * (1.0 / 12 - f * (1.0 / 120 - f * (1.0 / 252 - f * (1.0 / 240 -
+    f / 132))));
+}
+
+// lgamma(a + x) - lgamma(a), and its derivative with respect to a,
+// digamma(a + x) - digamma(a), for a whole number x >= 0.  For small x these
+// are sums over the x terms of the rising factorial, which are exact and
+// cheaper than two calls each to lgamma and digamma.
+inline void lgammaRatio(double a, long x, double& value, double& deriv){
+  if(x < 32){
+    value = 0;
+    deriv = 0;
+    for(long k = 0; k < x; k++){
+      value += std::log(a + k);
+      deriv += 1 / (a + k);
+    }
+    return;
+  }
+  value = std::lgamma(a + x) - std::lgamma(a);
+  deriv = digamma(a + x) - digamma(a);
+}
+
+// Log-likelihood of alpha = exp(logalpha) at one locus, and its derivative
+// with respect to logalpha.  x holds nsamples sets of tab.nalleles read
+// depths, and gp nsamples sets of tab.ngen genotype probabilities.  Samples
+// with no reads, or with missing or all-zero genotype probabilities, are
+// skipped; the number used is returned.  ll and dl are scratch space for
+// tab.ngen values.
+inline int alphaLogLik(double logalpha, const int* x, const double* gp,
+                       int nsamples, const ReadProbTable& tab,
+                       const LogFactorialTable& lf, long lfsize,
+                       double* ll, double* dl, double& value, double& deriv){
+  const double alpha = std::exp(logalpha);
+  const int nal = tab.nalleles;
+  const int ngen = tab.ngen;
+  double alphaterm = 0;
+  double alphaderiv = 0;
+  long lastn = -1;
+  int nused = 0;
+  value = 0;
+  deriv = 0;
+  for(int s = 0; s < nsamples; s++){
+    const int* xs = x + (std::size_t)s * nal;
+    const double* ws = gp + (std::size_t)s * ngen;
+    bool reads = false;
+    for(int a = 0; a < nal; a++){
+      if(xs[a] > 0) reads = true;
+    }
+    bool valid = false;
+    for(int g = 0; g < ngen; g++){
+      if(std::isnan(ws[g])){
+        valid = false;
+        break;
+      }
+      if(ws[g] > 0) valid = true;
+    }
+    if(!reads || !valid) continue;
+
+    double mx = -std::numeric_limits<double>::infinity();
+    for(int g = 0; g < ngen; g++){
+      ll[g] = -std::numeric_limits<double>::infinity();
+      dl[g] = 0;
+      if(!(ws[g] > 0)) continue;
+      const double* p = &tab.prob[(std::size_t)g * nal];
+      long n = 0;
+      double l = 0;
+      double d = 0;
+      bool impossible = false;
+      for(int a = 0; a < nal; a++){
+        const long xa = xs[a] > 0 ? xs[a] : 0;
+        if(p[a] <= 0){
+          // a read of an allele the genotype lacks
+          if(xa > 0) impossible = true;
+          continue;
+        }
+        double v, dv;
+        n += xa;
+        lgammaRatio(alpha * p[a], xa, v, dv);
+        l += v - tableLogFactorial(lf, lfsize, xa);
+        d += p[a] * dv;
+      }
+      if(impossible) continue;
+      // n is the total depth for every possible genotype, so the alpha, n
+      // term is only computed once per sample
+      if(n != lastn){
+        lgammaRatio(alpha, n, alphaterm, alphaderiv);
+        lastn = n;
+      }
+      ll[g] = std::log(ws[g]) + l - alphaterm + tableLogFactorial(lf, lfsize, n);
+      dl[g] = d - alphaderiv;
+      if(ll[g] > mx) mx = ll[g];
+    }
+    if(!std::isfinite(mx)) continue;
+    double tot = 0;
+    double dtot = 0;
+    for(int g = 0; g < ngen; g++){
+      if(!(ws[g] > 0)) continue;
+      const double e = std::exp(ll[g] - mx);
+      tot += e;
+      dtot += e * dl[g];
+    }
+    value += mx + std::log(tot);
+    deriv += alpha * dtot / tot;
+    nused++;
+  }
+  return nused;
+}
+
+// Maximize a function of log(alpha) on [lo, hi] from its derivative.
+// f(t, value, deriv) evaluates it at t.  If the derivative does not change
+// from positive to negative across the interval, the better end is returned.
+template<class F>
+inline double maximizeLogAlpha(F& f, double lo, double hi, double tol,
+                               int maxit){
+  double vlo, dlo, vhi, dhi;
+  f(lo, vlo, dlo);
+  f(hi, vhi, dhi);
+  if(dlo <= 0 && dhi >= 0) return vlo >= vhi ? lo : hi;
+  if(dlo <= 0) return lo;
+  if(dhi >= 0) return hi;
+  // dlo > 0 > dhi, so a maximum is bracketed
+  int side = 0;
+  double t = lo;
+  for(int it = 0; it < maxit; it++){
+    const double prev = t;
+    t = lo + dlo * (hi - lo) / (dlo - dhi);
+    double v, d;
+    f(t, v, d);
+    if(d == 0 || std::fabs(t - prev) < tol || hi - lo < tol) break;
+    // Illinois: halve the end that has been kept twice in a row, so that
+    // both ends move in
+    if(d > 0){
+      lo = t;
+      dlo = d;
+      if(side == -1) dhi *= 0.5;
+      side = -1;
+    } else {
+      hi = t;
+      dhi = d;
+      if(side == 1) dlo *= 0.5;
+      side = 1;
+    }
+  }
+  return t;
+}
+
+// Tables shared by the loci of one batch, built before threads start.  Sample
+// s belongs to classes[sampleClass[s]], as in genotypeLogLikMixed.  Samples
+// are visited in runs of one class rather than gathered by class, since
+// alphaLogLik already loops over samples and has no per-class kernel to
+// amortize.
+struct OverdispersionSetup {
+  int stride;                       // tables are at class * stride + nalleles
+  std::vector<ReadProbTable> tabs;
+  std::vector<int> runStart;        // runs of consecutive samples in a class
+  std::vector<int> runClass;
+  std::vector<std::size_t> inoff;   // start of each locus in ad
+  std::vector<std::size_t> gpoff;   // start of each locus in gp
+  int maxgen;
+  long lfsize;
+
+  OverdispersionSetup(const int* ad, const int* nalleles, std::size_t nloci,
+                      int nsamples, const std::vector<PloidyClass>& classes,
+                      const int* sampleClass, double error)
+    : inoff(nloci + 1, 0), gpoff(nloci + 1, 0), maxgen(0) {
+    const int ncls = classes.size();
+    int maxal = 0;
+    for(std::size_t L = 0; L < nloci; L++){
+      if(nalleles[L] > maxal) maxal = nalleles[L];
+    }
+    std::vector<std::size_t> classSize(ncls, 0);
+    for(int s = 0; s < nsamples; s++){
+      if(s == 0 || sampleClass[s] != sampleClass[s - 1]){
+        runStart.push_back(s);
+        runClass.push_back(sampleClass[s]);
+      }
+      classSize[sampleClass[s]]++;
+    }
+    runStart.push_back(nsamples);
+
+    stride = maxal + 1;
+    tabs.resize((std::size_t)ncls * stride);
+    for(std::size_t L = 0; L < nloci; L++){
+      const int nal = nalleles[L];
+      std::size_t ngp = 0;
+      for(int c = 0; c < ncls; c++){
+        ReadProbTable& tab = tabs[c * stride + nal];
+        if(tab.nalleles == 0 && classSize[c] > 0){
+          tab = ReadProbTable(classes[c], nal, error);
+          if(tab.ngen > maxgen) maxgen = tab.ngen;
+        }
+        ngp += (std::size_t)tab.ngen * classSize[c];
+      }
+      inoff[L + 1] = inoff[L] + (std::size_t)nal * nsamples;
+      gpoff[L + 1] = gpoff[L] + ngp;
+    }
+    // log factorials of every read depth and total
+    long maxn = 0;
+    for(std::size_t L = 0; L < nloci; L++){
+      for(int s = 0; s < nsamples; s++){
+        const int* x = ad + inoff[L] + (std::size_t)s * nalleles[L];
+        long n = 0;
+        for(int a = 0; a < nalleles[L]; a++){
+          if(x[a] > 0) n += x[a];
+        }
+        if(n > maxn) maxn = n;
+      }
+    }
+    LogFactorialTable& lf = logFactorialTable();
+    lf.reserve(maxn);
+    lfsize = lf.size();
+  }
+
+  // alphaLogLik at locus L, summed over runs of samples, returning the
+  // number of samples used.  ll and dl are scratch space for maxgen values.
+  int locus(double logalpha, const int* ad, const double* gp, int nal,
+            std::size_t L, const LogFactorialTable& lf, double* ll,
+            double* dl, double& value, double& deriv) const {
+    const int* x = ad + inoff[L];
+    const double* w = gp + gpoff[L];
+    int nused = 0;
+    value = 0;
+    deriv = 0;
+    for(std::size_t r = 0; r < runClass.size(); r++){
+      const ReadProbTable& tab = tabs[runClass[r] * stride + nal];
+      const int ns = runStart[r + 1] - runStart[r];
+      double v, d;
+      nused += alphaLogLik(logalpha, x + (std::size_t)runStart[r] * nal, w,
+                           ns, tab, lf, lfsize, ll, dl, v, d);
+      value += v;
+      deriv += d;
+      w += (std::size_t)ns * tab.ngen;
+    }
+    return nused;
+  }
+};
+
+// Log-likelihood of alpha at one locus, as a function of log(alpha), for
+// maximizeLogAlpha.
+struct LocusAlphaObjective {
+  const int* ad;
+  const double* gp;
+  int nal;
+  std::size_t L;
+  const OverdispersionSetup* setup;
+  const LogFactorialTable* lf;
+  double* ll;
+  double* dl;
+  int nused;
+
+  void operator()(double t, double& value, double& deriv){
+    nused = setup->locus(t, ad, gp, nal, L, *lf, ll, dl, value, deriv);
+  }
+};
+
+// Sum over loci of the log-likelihood of one alpha, parallel over loci.
+struct SharedAlphaObjective {
+  const int* ad;
+  const double* gp;
+  const int* nalleles;
+  std::size_t nloci;
+  const OverdispersionSetup* setup;
+  int nthreads;
+  long long nused;
+
+  void operator()(double t, double& value, double& deriv){
+    const LogFactorialTable& lf = logFactorialTable();
+    const long long n = nloci;
+    double v = 0;
+    double d = 0;
+    long long used = 0;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+    {
+      std::vector<double> ll(setup->maxgen);
+      std::vector<double> dl(setup->maxgen);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16) reduction(+:v, d, used)
+#endif
+      for(long long L = 0; L < n; L++){
+        double vL, dL;
+        used += setup->locus(t, ad, gp, nalleles[L], L, lf, ll.data(),
+                             dl.data(), vL, dL);
+        v += vL;
+        d += dL;
+      }
+    }
+    value = v;
+    deriv = d;
+    nused = used;
+  }
+};
+
+// fitOverdispersionBatch for samples of different ploidies, including
+// allopolyploids, with sample s in classes[sampleClass[s]].  gp is laid out
+// as the output of genotypeLogLikMixed.
+inline void fitOverdispersionMixed(const int* ad, const double* gp,
+                                   const int* nalleles, std::size_t nloci,
+                                   int nsamples,
+                                   const std::vector<PloidyClass>& classes,
+                                   const int* sampleClass, double error,
+                                   double lower, double upper, bool shared,
+                                   double* out, int nthreads){
+  const double tol = 1e-8;
+  const int maxit = 100;
+  const double lo = std::log(lower);
+  const double hi = std::log(upper);
+  const OverdispersionSetup setup(ad, nalleles, nloci, nsamples, classes,
+                                  sampleClass, error);
+  const LogFactorialTable& lf = logFactorialTable();
+
+  if(shared){
+    SharedAlphaObjective f = {ad, gp, nalleles, nloci, &setup, nthreads, 0};
+    double t = maximizeLogAlpha(f, lo, hi, tol, maxit);
+    out[0] = f.nused > 0 ? std::exp(t) : std::numeric_limits<double>::quiet_NaN();
+    return;
+  }
+
+  const long long n = nloci;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<double> ll(setup.maxgen);
+    std::vector<double> dl(setup.maxgen);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 4)
+#endif
+    for(long long L = 0; L < n; L++){
+      LocusAlphaObjective f = {ad, gp, nalleles[L], (std::size_t)L, &setup,
+                               &lf, ll.data(), dl.data(), 0};
+      double t = maximizeLogAlpha(f, lo, hi, tol, maxit);
+      out[L] = f.nused > 0 ? std::exp(t) :
+        std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+}
+
+// Estimate alpha for each locus, or one alpha for all loci if shared is true.
+// ad holds read depths as in genotypeLogLikBatch, and gp genotype
+// probabilities laid out as that function's output (for example, posterior
+// probabilities from logLikToPosteriorBatch).  Estimates are bounded by lower
+// and upper, which must be positive.  out receives nloci values, or one if
+// shared; loci with no samples having both reads and genotype probabilities
+// get NaN.  Parallel over loci.
+inline void fitOverdispersionBatch(const int* ad, const double* gp,
+                                   const int* nalleles, std::size_t nloci,
+                                   int nsamples, int ploidy, double error,
+                                   double lower, double upper, bool shared,
+                                   double* out, int nthreads){
+  const std::vector<PloidyClass> classes(1, PloidyClass(ploidy));
+  const std::vector<int> sampleClass(nsamples, 0);
+  fitOverdispersionMixed(ad, gp, nalleles, nloci, nsamples, classes,
+                         sampleClass.data(), error, lower, upper, shared, out,
+                         nthreads);
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_OVERDISPERSION_H
@@ -0,0 +1,150 @@
+#ifndef PLOIDYVERSE_PLOIDY_CLASSES_H
+#define PLOIDYVERSE_PLOIDY_CLASSES_H
+
+// Ploidy as given for each sample in ploidyverse VCFs: "2x" for a diploid,
+// "4x" for an autotetraploid, "2x+2x" for an allotetraploid, and so on.  Each
+// subgenome inherits independently, so a genotype of an allopolyploid is one
+// genotype for each subgenome, and the genotypes of a ploidy class are all
+// combinations of those of its subgenomes.  They are numbered with the first
+// subgenome varying fastest, each subgenome's genotypes being in VCF order.
+// An autopolyploid class, with one subgenome, is numbered exactly as in
+// genotype_tables.h.
+//
+// Reads cannot be assigned to subgenomes, so the read probabilities of a
+// genotype depend only on the copy number of each allele summed across
+// subgenomes; see classCopyTable.
+
+#include <climits>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "genotype_tables.h"
+
+namespace ploidyverse {
+
+struct PloidyClass {
+  std::vector<int> subgenomes; // ploidy of each subgenome
+  int ploidy;                  // total
+
+  PloidyClass() : ploidy(0) {}
+  explicit PloidyClass(int p) : subgenomes(1, p), ploidy(p) {}
+
+  bool autopolyploid() const { return subgenomes.size() == 1; }
+};
+
+// Parse a ploidy string such as "4x" or "2x+2x", ignoring surrounding
+// whitespace.  Throws std::invalid_argument if it is not in that format.
+inline PloidyClass parsePloidy(const std::string& s){
+  const std::size_t last = s.find_last_not_of(" \t");
+  std::size_t i = s.find_first_not_of(" \t");
+  PloidyClass out;
+  bool ok = i != std::string::npos;
+  while(ok){
+    const std::size_t start = i;
+    int p = 0;
+    while(i <= last && s[i] >= '0' && s[i] <= '9' && p <= 1000){
+      p = p * 10 + (s[i] - '0');
+      i++;
+    }
+    ok = i > start && p >= 1 && p <= 1000 && i <= last && s[i] == 'x';
+    if(!ok) break;
+    out.subgenomes.push_back(p);
+    out.ploidy += p;
+    if(++i > last) return out;
+    ok = s[i++] == '+';
+  }
+  throw std::invalid_argument("Ploidy \"" + s +
+                              "\" is not formatted as in \"4x\" or \"2x+2x\".");
+}
+
+// Number of genotypes for a ploidy class, or ULLONG_MAX if beyond 64 bits.
+inline unsigned long long countClassGenotypes(const PloidyClass& cls,
+                                              int nalleles){
+  unsigned long long out = 1;
+  for(std::size_t k = 0; k < cls.subgenomes.size(); k++){
+    unsigned long long n = countGenotypes(cls.subgenomes[k], nalleles);
+    if(n == ULLONG_MAX || (n > 0 && out > ULLONG_MAX / n)) return ULLONG_MAX;
+    out *= n;
+  }
+  return out;
+}
+
+// Number of genotypes as an int, throwing std::length_error if there are
+// too many to enumerate, as GenotypeCache does.
+inline int classGenotypeCount(const PloidyClass& cls, int nalleles){
+  unsigned long long ngen = countClassGenotypes(cls, nalleles);
+  if(ngen > (unsigned long long)INT_MAX / (cls.ploidy > 0 ? cls.ploidy : 1)){
+    throw std::length_error("Too many genotypes to enumerate.");
+  }
+  return (int)ngen;
+}
+
+// All genotypes of a ploidy class into out, which must hold
+// classGenotypeCount(cls, nalleles) * cls.ploidy values.  Each row is one
+// genotype, with the alleles of each subgenome in turn, in ascending order
+// within a subgenome.
+inline void enumerateClassGenotypes(const PloidyClass& cls, int nalleles,
+                                    int* out){
+  const int ngen = classGenotypeCount(cls, nalleles);
+  const std::size_t nsub = cls.subgenomes.size();
+  std::vector<GenotypeTable> tabs(nsub);
+  for(std::size_t k = 0; k < nsub; k++){
+    tabs[k] = genotypeTable(cls.subgenomes[k], nalleles);
+  }
+  std::vector<int> which(nsub, 0); // genotype of each subgenome
+  for(int g = 0; g < ngen; g++){
+    int* row = out + (std::size_t)g * cls.ploidy;
+    for(std::size_t k = 0; k < nsub; k++){
+      const int* geno = tabs[k].row(which[k]);
+      for(int i = 0; i < cls.subgenomes[k]; i++) *row++ = geno[i];
+    }
+    for(std::size_t k = 0; k < nsub && ++which[k] == tabs[k].ngen; k++){
+      which[k] = 0;
+    }
+  }
+}
+
+// Copy number of each allele, summed across subgenomes, for every genotype
+// of a ploidy class.  Output is ngen x nalleles, stored row by row.
+inline std::vector<int> classCopyTable(const PloidyClass& cls, int nalleles){
+  if(cls.autopolyploid()) return alleleCopyTable(cls.ploidy, nalleles);
+  const int ngen = classGenotypeCount(cls, nalleles);
+  std::vector<int> genos((std::size_t)ngen * cls.ploidy);
+  enumerateClassGenotypes(cls, nalleles, genos.data());
+  std::vector<int> out((std::size_t)ngen * nalleles, 0);
+  for(int g = 0; g < ngen; g++){
+    const int* geno = &genos[(std::size_t)g * cls.ploidy];
+    for(int i = 0; i < cls.ploidy; i++){
+      out[(std::size_t)g * nalleles + geno[i]]++;
+    }
+  }
+  return out;
+}
+
+// Group samples by ploidy string.  Each distinct string (after parsing, so
+// " 4x" and "4x" are the same) becomes one class, in order of first
+// appearance, and sampleClass receives the class of each sample.
+inline std::vector<PloidyClass> groupByPloidy(
+    const std::vector<std::string>& ploidy, std::vector<int>& sampleClass){
+  std::vector<PloidyClass> classes;
+  std::map<std::vector<int>, int> seen;
+  sampleClass.resize(ploidy.size());
+  for(std::size_t s = 0; s < ploidy.size(); s++){
+    PloidyClass cls = parsePloidy(ploidy[s]);
+    std::map<std::vector<int>, int>::iterator it = seen.find(cls.subgenomes);
+    if(it == seen.end()){
+      it = seen.insert(std::make_pair(cls.subgenomes,
+                                      (int)classes.size())).first;
+      classes.push_back(cls);
+    }
+    sampleClass[s] = it->second;
+  }
+  return classes;
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_PLOIDY_CLASSES_H
@@ -0,0 +1,279 @@
+#ifndef PLOIDYVERSE_PROB_CONVERT_KERNELS_H
+#define PLOIDYVERSE_PROB_CONVERT_KERNELS_H
+
+// Plain C++ kernels for converting between allele copy number probabilities,
+// stored as in polyRAD, and multiallelic genotype probabilities, and for
+// summarizing genotype probabilities as GT and GN.
+//
+// Copy number probabilities are a (ploidy + 1) x nsamples x nAlleleColumns
+// array, where each allele of each locus has its own column along the third
+// dimension.  Genotype probabilities are flat, with genotypes in VCF order
+// varying fastest, then samples, then loci, as from genotypeLogLikBatch, and
+// may be doubles or quantized (see quantized_gp.h).  Each locus is described
+// by the positions of its alleles along the third dimension of the copy
+// number array (alleleCols, concatenated across loci) and its number of
+// alleles.
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <vector>
+#include "genotype_tables.h"
+#include "quantized_gp.h"
+#include "threads.h"
+
+namespace ploidyverse {
+
+// Allele copy number tables for each distinct number of alleles, built
+// serially so that parallel loops only read them.
+inline std::map<int, std::vector<int> > copyTablesFor(int ploidy,
+                                                      const int* nalleles,
+                                                      std::size_t nloci){
+  std::map<int, std::vector<int> > out;
+  for(std::size_t L = 0; L < nloci; L++){
+    if(out.find(nalleles[L]) == out.end()){
+      out[nalleles[L]] = alleleCopyTable(ploidy, nalleles[L]);
+    }
+  }
+  return out;
+}
+
+// Normalize the probabilities of one cell to sum to one, or set them to NaN if
+// they sum to zero.
+inline void storeProbs(const double* p, int n, double* out,
+                       std::vector<std::size_t>&){
+  double total = 0;
+  for(int i = 0; i < n; i++) total += p[i];
+  if(total > 0){
+    for(int i = 0; i < n; i++) out[i] = p[i] / total;
+  } else {
+    for(int i = 0; i < n; i++) out[i] = std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+inline void storeProbs(const double* p, int n, QuantizedProb* out,
+                       std::vector<std::size_t>& order){
+  quantizeProbs(p, n, out, order);
+}
+
+// Copy number probabilities to genotype probabilities.  Treating the alleles
+// at a locus as independent, each genotype's probability is the product of
+// the probabilities of its copy number of each allele, and these products are
+// normalized to sum to one within each sample.  Unlike the pseudoinverse of
+// genoConvMat, this gives probabilities that are never negative, and exactly
+// recovers any genotype that the copy number probabilities are certain of.
+// Samples where every product is zero or missing get NaN.  Parallel over loci.
+template <typename T>
+void acnToGenoBatch(const double* acn, int ploidy, int nsamples,
+                    const int* alleleCols, const int* nalleles,
+                    std::size_t nloci, T* out, int nthreads){
+  std::map<int, std::vector<int> > tables = copyTablesFor(ploidy, nalleles, nloci);
+  std::vector<std::size_t> colOffset(nloci + 1, 0);
+  std::vector<std::size_t> outOffset(nloci + 1, 0);
+  for(std::size_t L = 0; L < nloci; L++){
+    colOffset[L + 1] = colOffset[L] + nalleles[L];
+    outOffset[L + 1] = outOffset[L] +
+      (std::size_t)countGenotypes(ploidy, nalleles[L]) * nsamples;
+  }
+  const std::size_t stride = (std::size_t)(ploidy + 1) * nsamples;
+  const long long nl = nloci;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<double> work;
+    std::vector<std::size_t> order;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for(long long L = 0; L < nl; L++){
+      const int nal = nalleles[L];
+      const std::vector<int>& copies = tables.find(nal)->second;
+      const int ngen = copies.size() / (nal > 0 ? nal : 1);
+      const int* cols = alleleCols + colOffset[L];
+      work.resize(ngen);
+      for(int s = 0; s < nsamples; s++){
+        for(int g = 0; g < ngen; g++){
+          double p = 1;
+          for(int a = 0; a < nal; a++){
+            p *= acn[copies[(std::size_t)g * nal + a] + (std::size_t)s * (ploidy + 1) +
+                     cols[a] * stride];
+          }
+          if(p != p) p = 0; // missing
+          work[g] = p;
+        }
+        storeProbs(work.data(), ngen, out + outOffset[L] + (std::size_t)s * ngen,
+                   order);
+      }
+    }
+  }
+}
+
+// Genotype probabilities to copy number probabilities: the probability of c
+// copies of an allele is the sum of the probabilities of the genotypes with c
+// copies of it.  out must already be sized for every allele column; columns
+// not listed in alleleCols are left as they are.  Parallel over loci, so no
+// allele column may belong to more than one locus.
+template <typename T>
+void genoToAcnBatch(const T* geno, int ploidy, int nsamples,
+                    const int* alleleCols, const int* nalleles,
+                    std::size_t nloci, double* out, int nthreads){
+  std::map<int, std::vector<int> > tables = copyTablesFor(ploidy, nalleles, nloci);
+  std::vector<std::size_t> colOffset(nloci + 1, 0);
+  std::vector<std::size_t> inOffset(nloci + 1, 0);
+  for(std::size_t L = 0; L < nloci; L++){
+    colOffset[L + 1] = colOffset[L] + nalleles[L];
+    inOffset[L + 1] = inOffset[L] +
+      (std::size_t)countGenotypes(ploidy, nalleles[L]) * nsamples;
+  }
+  const std::size_t stride = (std::size_t)(ploidy + 1) * nsamples;
+  const long long nl = nloci;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(dynamic, 16)
+#endif
+  for(long long L = 0; L < nl; L++){
+    const int nal = nalleles[L];
+    const std::vector<int>& copies = tables.find(nal)->second;
+    const int ngen = copies.size() / (nal > 0 ? nal : 1);
+    const int* cols = alleleCols + colOffset[L];
+    for(int a = 0; a < nal; a++){
+      double* dest = out + cols[a] * stride;
+      for(std::size_t k = 0; k < stride; k++) dest[k] = 0;
+    }
+    for(int s = 0; s < nsamples; s++){
+      const T* src = geno + inOffset[L] + (std::size_t)s * ngen;
+      for(int g = 0; g < ngen; g++){
+        const double p = probValue(src[g]);
+        for(int a = 0; a < nal; a++){
+          out[copies[(std::size_t)g * nal + a] + (std::size_t)s * (ploidy + 1) +
+              cols[a] * stride] += p;
+        }
+      }
+    }
+  }
+}
+
+// GT and GN for one biallelic locus.  Genotype g has g copies of the
+// alternative allele, so GN is the mean of g over GP, divided by ploidy.  The
+// loops run over samples innermost and have no branches, so that they can be
+// vectorized; best holds nsamples values of working space.
+template <typename T>
+void biallelicCalls(const T* gp, int ploidy, int nsamples, int naInteger,
+                    int* gtIndex, double* gn, double* best){
+  const std::size_t ngen = ploidy + 1;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+  for(int s = 0; s < nsamples; s++){
+    best[s] = probValue(gp[s * ngen]);
+    gn[s] = 0 * best[s]; // NaN if missing
+    gtIndex[s] = 0;
+  }
+  for(int g = 1; g <= ploidy; g++){
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for(int s = 0; s < nsamples; s++){
+      const double p = probValue(gp[s * ngen + g]);
+      const bool better = p > best[s];
+      gtIndex[s] = better ? g : gtIndex[s];
+      best[s] = better ? p : best[s];
+      gn[s] += g * p;
+    }
+  }
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+  for(int s = 0; s < nsamples; s++){
+    gtIndex[s] = gn[s] == gn[s] ? gtIndex[s] : naInteger;
+    gn[s] /= ploidy;
+  }
+}
+
+// Summaries of genotype probabilities, flat as from acnToGenoBatch, for every
+// sample and locus.  gtIndex (one per sample and locus) is the index in VCF
+// order of the most probable genotype, taking the first in case of ties, and
+// gt (ploidy per sample and locus) holds its alleles; both are naInteger if
+// any probability is missing.  gn (nalleles - 1 per sample and locus) is the
+// posterior mean copy number of each alternative allele divided by ploidy.
+// Biallelic loci take a faster path.  Parallel over loci.
+template <typename T>
+void genotypeCallsBatch(const T* gp, int ploidy, int nsamples,
+                        const int* nalleles, std::size_t nloci, int naInteger,
+                        int* gtIndex, int* gt, double* gn, int nthreads){
+  std::map<int, std::vector<int> > tables = copyTablesFor(ploidy, nalleles, nloci);
+  std::map<int, GenotypeTable> genotypes;
+  for(std::map<int, std::vector<int> >::const_iterator it = tables.begin();
+      it != tables.end(); ++it){
+    genotypes[it->first] = genotypeTable(ploidy, it->first);
+  }
+  std::vector<std::size_t> gpOffset(nloci + 1, 0);
+  std::vector<std::size_t> gnOffset(nloci + 1, 0);
+  for(std::size_t L = 0; L < nloci; L++){
+    gpOffset[L + 1] = gpOffset[L] +
+      (std::size_t)countGenotypes(ploidy, nalleles[L]) * nsamples;
+    gnOffset[L + 1] = gnOffset[L] + (std::size_t)(nalleles[L] - 1) * nsamples;
+  }
+  const long long nl = nloci;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<double> scratch(nsamples);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for(long long L = 0; L < nl; L++){
+      const int nal = nalleles[L];
+      const std::vector<int>& copies = tables.find(nal)->second;
+      const GenotypeTable& tab = genotypes.find(nal)->second;
+      const int ngen = tab.ngen;
+      const T* src = gp + gpOffset[L];
+      int* index = gtIndex + (std::size_t)L * nsamples;
+      double* mean = gn + gnOffset[L];
+
+      if(nal == 2){
+        biallelicCalls(src, ploidy, nsamples, naInteger, index, mean, scratch.data());
+      } else {
+        for(int s = 0; s < nsamples; s++){
+          const T* cell = src + (std::size_t)s * ngen;
+          double* m = mean + (std::size_t)s * (nal - 1);
+          for(int a = 1; a < nal; a++) m[a - 1] = 0;
+          double best = probValue(cell[0]);
+          int arg = 0;
+          bool missing = false;
+          for(int g = 0; g < ngen; g++){
+            const double p = probValue(cell[g]);
+            if(p != p) missing = true;
+            if(p > best){
+              best = p;
+              arg = g;
+            }
+            const int* c = &copies[(std::size_t)g * nal];
+            for(int a = 1; a < nal; a++) m[a - 1] += c[a] * p;
+          }
+          for(int a = 1; a < nal; a++) m[a - 1] /= ploidy;
+          index[s] = missing ? naInteger : arg;
+        }
+      }
+
+      int* alleles = gt + (std::size_t)L * nsamples * ploidy;
+      for(int s = 0; s < nsamples; s++){
+        int* dest = alleles + (std::size_t)s * ploidy;
+        if(index[s] == naInteger){
+          for(int i = 0; i < ploidy; i++) dest[i] = naInteger;
+        } else {
+          const int* row = tab.row(index[s]);
+          for(int i = 0; i < ploidy; i++) dest[i] = row[i];
+        }
+      }
+    }
+  }
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_PROB_CONVERT_KERNELS_H
@@ -0,0 +1,120 @@
+#ifndef PLOIDYVERSE_QUANTIZED_GP_H
+#define PLOIDYVERSE_QUANTIZED_GP_H
+
+// Genotype probabilities stored as 16-bit integers in steps of 1/1000, the
+// precision of GP in ploidyverse VCFs, using a quarter of the memory of
+// doubles.  The probabilities of each cell (one sample at one locus) are
+// rounded so that they still sum to exactly 1000 steps, and a cell that is
+// missing has every value set to quantizedMissing.  Since every quantized
+// value is a multiple of 0.001, writing it to VCF text with three decimal
+// places and reading it back gives the same value.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "threads.h"
+
+namespace ploidyverse {
+
+typedef std::uint16_t QuantizedProb;
+
+static const QuantizedProb quantizedMissing = 0xFFFF;
+static const int quantizedSteps = 1000;
+
+// Probability represented by a stored value, so that kernels can be written
+// once for both doubles and quantized values.
+inline double probValue(double x){
+  return x;
+}
+
+inline double probValue(QuantizedProb q){
+  return q == quantizedMissing ? std::numeric_limits<double>::quiet_NaN() :
+    q * (1.0 / quantizedSteps);
+}
+
+// Quantize the n probabilities of one cell.  They are scaled to sum to 1000
+// steps, rounded down, and the remaining steps given to the values with the
+// largest remainders, ties going to the first.  Negative values are treated
+// as zero.  If any value is missing, or all are zero, the cell is missing.
+// order is working space.
+inline void quantizeProbs(const double* p, std::size_t n, QuantizedProb* out,
+                          std::vector<std::size_t>& order){
+  double total = 0;
+  for(std::size_t i = 0; i < n; i++){
+    if(p[i] > 0) total += p[i];
+    if(p[i] != p[i]) total = std::numeric_limits<double>::quiet_NaN();
+  }
+  if(!(total > 0) || !std::isfinite(total)){
+    for(std::size_t i = 0; i < n; i++) out[i] = quantizedMissing;
+    return;
+  }
+  const double scale = quantizedSteps / total;
+  int assigned = 0;
+  for(std::size_t i = 0; i < n; i++){
+    double x = p[i] > 0 ? p[i] * scale : 0;
+    int q = std::min((int)x, quantizedSteps);
+    out[i] = q;
+    assigned += q;
+  }
+  int left = quantizedSteps - assigned;
+  if(left <= 0) return;
+  // give the remaining steps to the largest remainders
+  order.resize(n);
+  for(std::size_t i = 0; i < n; i++) order[i] = i;
+  struct ByRemainder {
+    const double* p;
+    double scale;
+    const QuantizedProb* q;
+    double rem(std::size_t i) const {
+      return (p[i] > 0 ? p[i] * scale : 0) - q[i];
+    }
+    bool operator()(std::size_t a, std::size_t b) const {
+      double ra = rem(a), rb = rem(b);
+      return ra > rb || (ra == rb && a < b);
+    }
+  } cmp = {p, scale, out};
+  std::size_t k = std::min<std::size_t>(left, n);
+  std::nth_element(order.begin(), order.begin() + (k - 1), order.end(), cmp);
+  for(std::size_t j = 0; j < k; j++) out[order[j]]++;
+  // only possible through rounding error in the remainders
+  left -= k;
+  for(std::size_t i = 0; left > 0 && i < n; i++, left--) out[i]++;
+}
+
+// Quantize every cell of a ragged array of probabilities, in parallel.  Cell
+// i has values offsets[i] to offsets[i + 1] - 1.
+inline void quantizeRagged(const double* values, const double* offsets,
+                           std::size_t ncells, QuantizedProb* out, int nthreads){
+  const long long nc = ncells;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<std::size_t> order;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(long long i = 0; i < nc; i++){
+      std::size_t start = offsets[i];
+      std::size_t end = offsets[i + 1];
+      quantizeProbs(values + start, end - start, out + start, order);
+    }
+  }
+}
+
+// Probabilities from quantized values, in parallel.
+inline void dequantize(const QuantizedProb* q, std::size_t n, double* out,
+                       int nthreads){
+  const long long nn = n;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(static)
+#endif
+  for(long long i = 0; i < nn; i++) out[i] = probValue(q[i]);
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_QUANTIZED_GP_H
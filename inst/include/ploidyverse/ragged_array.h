@@ -0,0 +1,83 @@
+#ifndef PLOIDYVERSE_RAGGED_ARRAY_H
+#define PLOIDYVERSE_RAGGED_ARRAY_H
+
+// A ragged array stores one vector of values for every cell of a loci x
+// samples matrix, such as AD or GP from a VCF, as a single buffer of values
+// plus offsets.  Cells are in order by sample within locus, matching the
+// flat output of the batch kernels, and cell i has values
+// offsets[i] to offsets[i + 1] - 1.  Offsets are doubles so that they can be
+// shared with R without copying and still exceed 2^31.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "threads.h"
+
+namespace ploidyverse {
+
+// Read-only view of a ragged array held elsewhere, e.g. in an R object.
+template <typename T>
+struct RaggedView {
+  const T* values;
+  const double* offsets;
+  int nrow; // loci
+  int ncol; // samples
+
+  std::size_t ncells() const { return (std::size_t)nrow * ncol; }
+  std::size_t cellIndex(int row, int col) const {
+    return (std::size_t)row * ncol + col;
+  }
+  const T* cell(int row, int col) const {
+    return values + (std::size_t)offsets[cellIndex(row, col)];
+  }
+  std::size_t length(int row, int col) const {
+    std::size_t i = cellIndex(row, col);
+    return (std::size_t)offsets[i + 1] - (std::size_t)offsets[i];
+  }
+};
+
+// Offsets from cell lengths.  out must hold n + 1 values.
+inline void raggedOffsets(const std::size_t* lengths, std::size_t n, double* out){
+  double total = 0;
+  out[0] = 0;
+  for(std::size_t i = 0; i < n; i++){
+    total += lengths[i];
+    out[i + 1] = total;
+  }
+}
+
+// Whether n + 1 offsets are usable for nvalues values: whole numbers starting
+// at zero, never decreasing, and ending at nvalues.  Offsets coming from R
+// should be checked with this before any kernel indexes with them.
+inline bool validRaggedOffsets(const double* offsets, std::size_t n,
+                               double nvalues){
+  if(offsets[0] != 0 || offsets[n] != nvalues) return false;
+  for(std::size_t i = 0; i < n; i++){
+    const double o = offsets[i + 1];
+    // also false for NaN
+    if(!(o >= offsets[i]) || o > nvalues || o != std::floor(o)) return false;
+  }
+  return true;
+}
+
+// Copy the vectors for n cells into one buffer, in parallel.  src[i] points to
+// the values of cell i, and offsets is as from raggedOffsets.  Used to pack
+// per-cell vectors whose pointers have already been collected.
+template <typename T>
+void packRagged(const T* const* src, const double* offsets, std::size_t n,
+                T* out, int nthreads){
+  const long long nn = n;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(static)
+#endif
+  for(long long i = 0; i < nn; i++){
+    std::size_t start = offsets[i];
+    std::size_t end = offsets[i + 1];
+    if(end > start) std::copy(src[i], src[i] + (end - start), out + start);
+  }
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_RAGGED_ARRAY_H
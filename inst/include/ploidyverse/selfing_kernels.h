@@ -0,0 +1,410 @@
+#ifndef PLOIDYVERSE_SELFING_KERNELS_H
+#define PLOIDYVERSE_SELFING_KERNELS_H
+
+// Plain C++ kernels for the self-fertilization operator.  The selfing matrix
+// has parent genotypes in rows and progeny genotypes in columns, in VCF order,
+// and is almost entirely zeros, so it is built in compressed sparse row (CSR)
+// form or applied row by row without being built at all.
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "gamete_kernels.h"
+#include "genotype_tables.h"
+#include "threads.h"
+
+namespace ploidyverse {
+
+// One row of a sparse matrix: (column, value) pairs sorted by column.
+typedef std::vector<std::pair<int, double> > SparseRow;
+
+// Sparse matrix in CSR form.  Row i has entries rowptr[i] to rowptr[i + 1] - 1.
+struct SparseMatrix {
+  int nrow;
+  int ncol;
+  std::vector<std::size_t> rowptr;
+  std::vector<int> col;
+  std::vector<double> val;
+
+  SparseMatrix() : nrow(0), ncol(0), rowptr(1, 0) {}
+
+  std::size_t nnz() const { return val.size(); }
+};
+
+// Sort a row by column and add together duplicate columns.
+inline void collapseRow(SparseRow& row){
+  std::sort(row.begin(), row.end());
+  std::size_t out = 0;
+  for(std::size_t i = 0; i < row.size(); i++){
+    if(out > 0 && row[out - 1].first == row[i].first){
+      row[out - 1].second += row[i].second;
+    } else {
+      row[out++] = row[i];
+    }
+  }
+  row.resize(out);
+}
+
+// Progeny genotype distribution from self-fertilizing one parent genotype
+// (ploidy values, sorted).  Polysomic inheritance without double reduction is
+// assumed.  Each unordered pair of distinct gametes is visited once, and the
+// two gametes are merged in sorted order to get the progeny genotype, so no
+// sort is needed.
+inline void selfingRow(const int* parent, int ploidy, SparseRow& row){
+  GameteDistribution gam;
+  gameteDistribution(parent, ploidy, gam);
+  const int gamploidy = gam.gamploidy;
+  const int ngametes = gam.size();
+  row.clear();
+
+  std::vector<int> prog(ploidy);
+  for(int g1 = 0; g1 < ngametes; g1++){
+    const int* gam1 = gam.gamete(g1);
+    for(int g2 = g1; g2 < ngametes; g2++){
+      const int* gam2 = gam.gamete(g2);
+      std::merge(gam1, gam1 + gamploidy, gam2, gam2 + gamploidy, prog.begin());
+      double p = gam.prob[g1] * gam.prob[g2];
+      if(g2 != g1) p *= 2;
+      row.push_back(std::make_pair((int)rankGenotype(prog.data(), ploidy), p));
+    }
+  }
+  collapseRow(row);
+}
+
+// Build the selfing matrix in CSR form.  Rows are computed in parallel.
+inline SparseMatrix buildSelfingMatrix(int ploidy, int nalleles, int nthreads){
+  GenotypeTable allgen = genotypeTable(ploidy, nalleles);
+  const int ngen = allgen.ngen;
+  std::vector<SparseRow> rows(ngen);
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(dynamic, 8)
+#endif
+  for(int i = 0; i < ngen; i++){
+    selfingRow(allgen.row(i), ploidy, rows[i]);
+  }
+
+  SparseMatrix out;
+  out.nrow = ngen;
+  out.ncol = ngen;
+  out.rowptr.assign(ngen + 1, 0);
+  for(int i = 0; i < ngen; i++){
+    out.rowptr[i + 1] = out.rowptr[i] + rows[i].size();
+  }
+  out.col.resize(out.rowptr[ngen]);
+  out.val.resize(out.rowptr[ngen]);
+  for(int i = 0; i < ngen; i++){
+    std::size_t k = out.rowptr[i];
+    for(std::size_t e = 0; e < rows[i].size(); e++, k++){
+      out.col[k] = rows[i][e].first;
+      out.val[k] = rows[i][e].second;
+    }
+  }
+  return out;
+}
+
+// Product of two sparse matrices, by rows (Gustavson's algorithm).  Each
+// thread accumulates one output row at a time in a dense buffer.
+inline SparseMatrix sparseMultiply(const SparseMatrix& a, const SparseMatrix& b,
+                                   int nthreads){
+  std::vector<SparseRow> rows(a.nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    std::vector<double> acc(b.ncol, 0.0);
+    std::vector<char> used(b.ncol, 0);
+    std::vector<int> cols;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 8)
+#endif
+    for(int i = 0; i < a.nrow; i++){
+      cols.clear();
+      for(std::size_t ka = a.rowptr[i]; ka < a.rowptr[i + 1]; ka++){
+        const int r = a.col[ka];
+        const double v = a.val[ka];
+        for(std::size_t kb = b.rowptr[r]; kb < b.rowptr[r + 1]; kb++){
+          const int c = b.col[kb];
+          if(!used[c]){
+            used[c] = 1;
+            cols.push_back(c);
+          }
+          acc[c] += v * b.val[kb];
+        }
+      }
+      std::sort(cols.begin(), cols.end());
+      rows[i].resize(cols.size());
+      for(std::size_t e = 0; e < cols.size(); e++){
+        rows[i][e] = std::make_pair(cols[e], acc[cols[e]]);
+        acc[cols[e]] = 0;
+        used[cols[e]] = 0;
+      }
+    }
+  }
+
+  SparseMatrix out;
+  out.nrow = a.nrow;
+  out.ncol = b.ncol;
+  out.rowptr.assign(a.nrow + 1, 0);
+  for(int i = 0; i < a.nrow; i++){
+    out.rowptr[i + 1] = out.rowptr[i] + rows[i].size();
+  }
+  out.col.resize(out.rowptr[a.nrow]);
+  out.val.resize(out.rowptr[a.nrow]);
+  for(int i = 0; i < a.nrow; i++){
+    std::size_t k = out.rowptr[i];
+    for(std::size_t e = 0; e < rows[i].size(); e++, k++){
+      out.col[k] = rows[i][e].first;
+      out.val[k] = rows[i][e].second;
+    }
+  }
+  return out;
+}
+
+// Identity matrix in CSR form.
+inline SparseMatrix sparseIdentity(int n){
+  SparseMatrix out;
+  out.nrow = n;
+  out.ncol = n;
+  out.rowptr.resize(n + 1);
+  out.col.resize(n);
+  out.val.assign(n, 1.0);
+  for(int i = 0; i <= n; i++) out.rowptr[i] = i;
+  for(int i = 0; i < n; i++) out.col[i] = i;
+  return out;
+}
+
+// Cache of selfing matrices and their powers by (ploidy, nalleles,
+// generations).  A power is built from smaller ones by squaring, so asking
+// for k generations takes about log2(k) sparse products, and each power along
+// the way is kept for later calls.  The matrices kept take at most maxBytes in
+// all; when a new one would go over, the cache is emptied first, and a
+// matrix larger than maxBytes by itself is returned without being kept.
+class SelfingCache {
+public:
+  typedef std::pair<std::pair<int, int>, int> Key;
+  static const std::size_t maxBytes = (std::size_t)1 << 28; // 256 MB
+
+  SelfingCache() : bytes_(0) {}
+
+  static std::size_t matrixBytes(const SparseMatrix& mat){
+    return mat.rowptr.size() * sizeof(std::size_t) +
+      mat.nnz() * (sizeof(int) + sizeof(double));
+  }
+
+  std::shared_ptr<const SparseMatrix> get(int ploidy, int nalleles,
+                                          int generations, int nthreads){
+    Key key(std::make_pair(ploidy, nalleles), generations);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::map<Key, std::shared_ptr<const SparseMatrix> >::iterator
+        it = mats_.find(key);
+      if(it != mats_.end()) return it->second;
+    }
+
+    // build outside of the lock; smaller powers come from the cache
+    SparseMatrix* mat;
+    if(generations == 0){
+      mat = new SparseMatrix(sparseIdentity(genotypeTable(ploidy, nalleles).ngen));
+    } else if(generations == 1){
+      mat = new SparseMatrix(buildSelfingMatrix(ploidy, nalleles, nthreads));
+    } else if(generations % 2 == 0){
+      std::shared_ptr<const SparseMatrix> half =
+        get(ploidy, nalleles, generations / 2, nthreads);
+      mat = new SparseMatrix(sparseMultiply(*half, *half, nthreads));
+    } else {
+      std::shared_ptr<const SparseMatrix> rest =
+        get(ploidy, nalleles, generations - 1, nthreads);
+      std::shared_ptr<const SparseMatrix> one = get(ploidy, nalleles, 1, nthreads);
+      mat = new SparseMatrix(sparseMultiply(*rest, *one, nthreads));
+    }
+    std::shared_ptr<const SparseMatrix> out(mat);
+    const std::size_t nbytes = matrixBytes(*mat);
+    if(nbytes > maxBytes) return out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    // another thread may have built the same matrix meanwhile
+    std::map<Key, std::shared_ptr<const SparseMatrix> >::iterator
+      it = mats_.find(key);
+    if(it != mats_.end()) return it->second;
+    if(bytes_ + nbytes > maxBytes){
+      mats_.clear();
+      bytes_ = 0;
+    }
+    mats_[key] = out;
+    bytes_ += nbytes;
+    return out;
+  }
+
+  std::size_t entries(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mats_.size();
+  }
+
+  std::size_t bytes(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+  }
+
+  void clear(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    mats_.clear();
+    bytes_ = 0;
+  }
+
+private:
+  std::map<Key, std::shared_ptr<const SparseMatrix> > mats_;
+  std::size_t bytes_;
+  std::mutex mutex_;
+};
+
+inline SelfingCache& selfingCache(){
+  static SelfingCache cache;
+  return cache;
+}
+
+// Cached selfing matrix for a ploidy and number of alleles, raised to the
+// power of the number of generations of selfing.
+inline std::shared_ptr<const SparseMatrix> selfingMatrixCSR(int ploidy, int nalleles,
+                                                            int generations,
+                                                            int nthreads){
+  return selfingCache().get(ploidy, nalleles, generations, nthreads);
+}
+
+// Genotype frequencies after one generation of selfing, without building the
+// selfing matrix.  freq is ngen x ncol, stored column by column, with one
+// frequency distribution per column; out has the same layout.  Parallel over
+// parent genotypes, with each thread summing into its own buffer, and the
+// buffers added into out one thread at a time.  Columns are done in blocks of
+// at least 1 MB, or all of freq if smaller, so that narrow inputs do not
+// recompute rows many times; the buffers of all threads together take at most
+// about the larger of the size of out and 1 MB per thread.  A single vector
+// therefore needs a full copy of out per thread.
+inline void applySelfingOnTheFly(const double* freq, int ncol, int ploidy,
+                                 int nalleles, double* out, int nthreads){
+  GenotypeTable allgen = genotypeTable(ploidy, nalleles);
+  const int ngen = allgen.ngen;
+  const int nt = threadCount(nthreads);
+  std::fill(out, out + (std::size_t)ngen * ncol, 0.0);
+  int block = (ncol + nt - 1) / nt;
+  const std::size_t minBlock = ((std::size_t)1 << 17) / ngen;
+  if(block < (int)std::min<std::size_t>(minBlock, ncol)){
+    block = (int)std::min<std::size_t>(minBlock, ncol);
+  }
+  if(block < 1) block = 1;
+
+  for(int c0 = 0; c0 < ncol; c0 += block){
+    const int nc = std::min(block, ncol - c0);
+    const double* fb = freq + (std::size_t)c0 * ngen;
+    double* ob = out + (std::size_t)c0 * ngen;
+    const std::size_t len = (std::size_t)ngen * nc;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nt)
+#endif
+    {
+      std::vector<double> acc(len, 0.0);
+      SparseRow row;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 8)
+#endif
+      for(int i = 0; i < ngen; i++){
+        bool any = false;
+        for(int c = 0; c < nc; c++){
+          if(fb[i + (std::size_t)c * ngen] != 0) any = true;
+        }
+        if(!any) continue;
+        selfingRow(allgen.row(i), ploidy, row);
+        for(int c = 0; c < nc; c++){
+          double f = fb[i + (std::size_t)c * ngen];
+          if(f == 0) continue;
+          double* dest = &acc[(std::size_t)c * ngen];
+          for(std::size_t e = 0; e < row.size(); e++){
+            dest[row[e].first] += f * row[e].second;
+          }
+        }
+      }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      {
+        for(std::size_t k = 0; k < len; k++) ob[k] += acc[k];
+      }
+    }
+  }
+}
+
+// Transpose of a sparse matrix, so that the columns of the original can be
+// read as rows.
+inline SparseMatrix sparseTranspose(const SparseMatrix& a){
+  SparseMatrix out;
+  out.nrow = a.ncol;
+  out.ncol = a.nrow;
+  out.rowptr.assign(a.ncol + 1, 0);
+  for(std::size_t k = 0; k < a.nnz(); k++) out.rowptr[a.col[k] + 1]++;
+  for(int j = 0; j < a.ncol; j++) out.rowptr[j + 1] += out.rowptr[j];
+  out.col.resize(a.nnz());
+  out.val.resize(a.nnz());
+  std::vector<std::size_t> next(out.rowptr.begin(), out.rowptr.end() - 1);
+  for(int i = 0; i < a.nrow; i++){
+    for(std::size_t k = a.rowptr[i]; k < a.rowptr[i + 1]; k++){
+      std::size_t dest = next[a.col[k]]++;
+      out.col[dest] = i;
+      out.val[dest] = a.val[k];
+    }
+  }
+  return out;
+}
+
+// Genotype frequencies after several numbers of generations of selfing, in one
+// pass.  freq is ngen x ncol, stored column by column.  generations holds
+// ngens non-negative generation counts, in any order; out is
+// ngen x ncol x ngens, with one ngen x ncol block per generation count.
+// The cached selfing matrix is applied once per generation up to the largest
+// count, which for a vector costs far less than raising the matrix to a power.
+// Each step is parallel over progeny genotypes.
+inline void selfingGenerationsInto(const double* freq, int ncol, int ploidy,
+                                   int nalleles, const int* generations,
+                                   int ngens, double* out, int nthreads){
+  std::shared_ptr<const SparseMatrix> mat = selfingMatrixCSR(ploidy, nalleles, 1,
+                                                             nthreads);
+  const SparseMatrix tmat = sparseTranspose(*mat);
+  const int ngen = mat->nrow;
+  const std::size_t len = (std::size_t)ngen * ncol;
+  int maxgen = 0;
+  for(int g = 0; g < ngens; g++){
+    if(generations[g] > maxgen) maxgen = generations[g];
+  }
+
+  std::vector<double> cur(freq, freq + len);
+  std::vector<double> next(len);
+  for(int gen = 0; ; gen++){
+    for(int g = 0; g < ngens; g++){
+      if(generations[g] == gen){
+        std::copy(cur.begin(), cur.end(), out + (std::size_t)g * len);
+      }
+    }
+    if(gen == maxgen) break;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(static)
+#endif
+    for(int j = 0; j < ngen; j++){
+      for(int c = 0; c < ncol; c++){
+        const double* src = &cur[(std::size_t)c * ngen];
+        double total = 0;
+        for(std::size_t k = tmat.rowptr[j]; k < tmat.rowptr[j + 1]; k++){
+          total += tmat.val[k] * src[tmat.col[k]];
+        }
+        next[j + (std::size_t)c * ngen] = total;
+      }
+    }
+    cur.swap(next);
+  }
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_SELFING_KERNELS_H
@@ -0,0 +1,29 @@
+#ifndef PLOIDYVERSE_THREADS_H
+#define PLOIDYVERSE_THREADS_H
+
+// Helpers for OpenMP multithreading.  Code in the parallel regions of the
+// batch kernels must not touch the R API, so they work on raw pointers only.
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ploidyverse {
+
+// Number of threads to use, given what the user asked for.  Zero or negative
+// values mean "use the OpenMP default".  Always 1 if compiled without OpenMP.
+inline int threadCount(int nthreads){
+#ifdef _OPENMP
+  if(nthreads < 1){
+    return omp_get_max_threads();
+  }
+  return nthreads;
+#else
+  (void)nthreads;
+  return 1;
+#endif
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_THREADS_H
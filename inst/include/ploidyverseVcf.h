@@ -1,9 +1,36 @@
-// Generated by using Rcpp::compileAttributes() -> do not edit by hand
-// Generator token: 10BE3573-1514-4C36-9D1C-5A225CD40393
+#ifndef PLOIDYVERSEVCF_H
+#define PLOIDYVERSEVCF_H
 
-#ifndef RCPP_ploidyverseVcf_H_GEN_
-#define RCPP_ploidyverseVcf_H_GEN_
+// C++ API for packages with ploidyverseVcf in LinkingTo.
+//
+// The kernels in namespace ploidyverse are header-only and work on raw
+// pointers and plain integers, without the R API, so they can be inlined into
+// inner loops and called from OpenMP parallel regions.  Call them as, for
+// example, ploidyverse::dmultinom(x, prob, k) or
+// ploidyverse::indexGenotype(genotype, ploidy).  See the comments in each
+// header under ploidyverse/ for details.
+//
+// The Rcpp interfaces in namespace ploidyverseVcf, which take and return R
+// vectors and call into the package through R_GetCCallable, are included
+// too, unless PLOIDYVERSEVCF_NO_RCPP is defined before this header.
 
+#include "ploidyverse/cross_kernels.h"
+#include "ploidyverse/fixed_genotypes.h"
+#include "ploidyverse/gamete_kernels.h"
+#include "ploidyverse/genotype_tables.h"
+#include "ploidyverse/hwe_priors.h"
+#include "ploidyverse/instrumentation.h"
+#include "ploidyverse/likelihood_kernels.h"
+#include "ploidyverse/multiallele_utils.h"
+#include "ploidyverse/overdispersion.h"
+#include "ploidyverse/ploidy_classes.h"
+#include "ploidyverse/prob_convert_kernels.h"
+#include "ploidyverse/quantized_gp.h"
+#include "ploidyverse/ragged_array.h"
+#include "ploidyverse/selfing_kernels.h"
+
+#ifndef PLOIDYVERSEVCF_NO_RCPP
 #include "ploidyverseVcf_RcppExports.h"
+#endif
 
-#endif // RCPP_ploidyverseVcf_H_GEN_
+#endif // PLOIDYVERSEVCF_H
@@ -24,6 +24,361 @@ namespace ploidyverseVcf {
         }
     }
 
+    inline NumericVector crossProgeny(IntegerVector mother, IntegerVector father, int nalleles) {
+        typedef SEXP(*Ptr_crossProgeny)(SEXP,SEXP,SEXP);
+        static Ptr_crossProgeny p_crossProgeny = NULL;
+        if (p_crossProgeny == NULL) {
+            validateSignature("NumericVector(*crossProgeny)(IntegerVector,IntegerVector,int)");
+            p_crossProgeny = (Ptr_crossProgeny)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_crossProgeny");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_crossProgeny(Shield<SEXP>(Rcpp::wrap(mother)), Shield<SEXP>(Rcpp::wrap(father)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector crossProgenyFreq(NumericVector mother, NumericVector father, int motherPloidy, int fatherPloidy, int nalleles) {
+        typedef SEXP(*Ptr_crossProgenyFreq)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_crossProgenyFreq p_crossProgenyFreq = NULL;
+        if (p_crossProgenyFreq == NULL) {
+            validateSignature("NumericVector(*crossProgenyFreq)(NumericVector,NumericVector,int,int,int)");
+            p_crossProgenyFreq = (Ptr_crossProgenyFreq)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_crossProgenyFreq");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_crossProgenyFreq(Shield<SEXP>(Rcpp::wrap(mother)), Shield<SEXP>(Rcpp::wrap(father)), Shield<SEXP>(Rcpp::wrap(motherPloidy)), Shield<SEXP>(Rcpp::wrap(fatherPloidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector crossProgenyBatch(IntegerVector mother, IntegerVector father, IntegerVector nalleles, int motherPloidy, int fatherPloidy, int nthreads = 1) {
+        typedef SEXP(*Ptr_crossProgenyBatch)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_crossProgenyBatch p_crossProgenyBatch = NULL;
+        if (p_crossProgenyBatch == NULL) {
+            validateSignature("NumericVector(*crossProgenyBatch)(IntegerVector,IntegerVector,IntegerVector,int,int,int)");
+            p_crossProgenyBatch = (Ptr_crossProgenyBatch)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_crossProgenyBatch");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_crossProgenyBatch(Shield<SEXP>(Rcpp::wrap(mother)), Shield<SEXP>(Rcpp::wrap(father)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(motherPloidy)), Shield<SEXP>(Rcpp::wrap(fatherPloidy)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline bool instrumentKernels(bool enable = true) {
+        typedef SEXP(*Ptr_instrumentKernels)(SEXP);
+        static Ptr_instrumentKernels p_instrumentKernels = NULL;
+        if (p_instrumentKernels == NULL) {
+            validateSignature("bool(*instrumentKernels)(bool)");
+            p_instrumentKernels = (Ptr_instrumentKernels)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_instrumentKernels");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_instrumentKernels(Shield<SEXP>(Rcpp::wrap(enable)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<bool >(rcpp_result_gen);
+    }
+
+    inline List kernelStats() {
+        typedef SEXP(*Ptr_kernelStats)();
+        static Ptr_kernelStats p_kernelStats = NULL;
+        if (p_kernelStats == NULL) {
+            validateSignature("List(*kernelStats)()");
+            p_kernelStats = (Ptr_kernelStats)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_kernelStats");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_kernelStats();
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<List >(rcpp_result_gen);
+    }
+
+    inline void resetKernelStats() {
+        typedef SEXP(*Ptr_resetKernelStats)();
+        static Ptr_resetKernelStats p_resetKernelStats = NULL;
+        if (p_resetKernelStats == NULL) {
+            validateSignature("void(*resetKernelStats)()");
+            p_resetKernelStats = (Ptr_resetKernelStats)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_resetKernelStats");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_resetKernelStats();
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+    }
+
+    inline NumericVector batchGenotypeLikelihoods(IntegerVector AD, IntegerVector nalleles, int nsamples, int ploidy, double error = 0.001, double alpha = 0, int nthreads = 1) {
+        typedef SEXP(*Ptr_batchGenotypeLikelihoods)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_batchGenotypeLikelihoods p_batchGenotypeLikelihoods = NULL;
+        if (p_batchGenotypeLikelihoods == NULL) {
+            validateSignature("NumericVector(*batchGenotypeLikelihoods)(IntegerVector,IntegerVector,int,int,double,double,int)");
+            p_batchGenotypeLikelihoods = (Ptr_batchGenotypeLikelihoods)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_batchGenotypeLikelihoods");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_batchGenotypeLikelihoods(Shield<SEXP>(Rcpp::wrap(AD)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(error)), Shield<SEXP>(Rcpp::wrap(alpha)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector batchGenotypeLikelihoodsMixed(IntegerVector AD, IntegerVector nalleles, std::vector<std::string> ploidy, double error = 0.001, double alpha = 0, int nthreads = 1) {
+        typedef SEXP(*Ptr_batchGenotypeLikelihoodsMixed)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_batchGenotypeLikelihoodsMixed p_batchGenotypeLikelihoodsMixed = NULL;
+        if (p_batchGenotypeLikelihoodsMixed == NULL) {
+            validateSignature("NumericVector(*batchGenotypeLikelihoodsMixed)(IntegerVector,IntegerVector,std::vector<std::string>,double,double,int)");
+            p_batchGenotypeLikelihoodsMixed = (Ptr_batchGenotypeLikelihoodsMixed)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_batchGenotypeLikelihoodsMixed");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_batchGenotypeLikelihoodsMixed(Shield<SEXP>(Rcpp::wrap(AD)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(error)), Shield<SEXP>(Rcpp::wrap(alpha)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector fitOverdispersionBatch(IntegerVector AD, NumericVector genoprobs, IntegerVector nalleles, int nsamples, int ploidy, double error = 0.001, bool shared = false, double lower = 0.01, double upper = 10000, int nthreads = 1) {
+        typedef SEXP(*Ptr_fitOverdispersionBatch)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_fitOverdispersionBatch p_fitOverdispersionBatch = NULL;
+        if (p_fitOverdispersionBatch == NULL) {
+            validateSignature("NumericVector(*fitOverdispersionBatch)(IntegerVector,NumericVector,IntegerVector,int,int,double,bool,double,double,int)");
+            p_fitOverdispersionBatch = (Ptr_fitOverdispersionBatch)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_fitOverdispersionBatch");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_fitOverdispersionBatch(Shield<SEXP>(Rcpp::wrap(AD)), Shield<SEXP>(Rcpp::wrap(genoprobs)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(error)), Shield<SEXP>(Rcpp::wrap(shared)), Shield<SEXP>(Rcpp::wrap(lower)), Shield<SEXP>(Rcpp::wrap(upper)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector fitOverdispersionMixed(IntegerVector AD, NumericVector genoprobs, IntegerVector nalleles, std::vector<std::string> ploidy, double error = 0.001, bool shared = false, double lower = 0.01, double upper = 10000, int nthreads = 1) {
+        typedef SEXP(*Ptr_fitOverdispersionMixed)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_fitOverdispersionMixed p_fitOverdispersionMixed = NULL;
+        if (p_fitOverdispersionMixed == NULL) {
+            validateSignature("NumericVector(*fitOverdispersionMixed)(IntegerVector,NumericVector,IntegerVector,std::vector<std::string>,double,bool,double,double,int)");
+            p_fitOverdispersionMixed = (Ptr_fitOverdispersionMixed)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_fitOverdispersionMixed");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_fitOverdispersionMixed(Shield<SEXP>(Rcpp::wrap(AD)), Shield<SEXP>(Rcpp::wrap(genoprobs)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(error)), Shield<SEXP>(Rcpp::wrap(shared)), Shield<SEXP>(Rcpp::wrap(lower)), Shield<SEXP>(Rcpp::wrap(upper)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector hwePriorsBatch(NumericVector freq, IntegerVector nalleles, int ploidy, int nsamples = 1, bool logOutput = false, int nthreads = 1) {
+        typedef SEXP(*Ptr_hwePriorsBatch)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_hwePriorsBatch p_hwePriorsBatch = NULL;
+        if (p_hwePriorsBatch == NULL) {
+            validateSignature("NumericVector(*hwePriorsBatch)(NumericVector,IntegerVector,int,int,bool,int)");
+            p_hwePriorsBatch = (Ptr_hwePriorsBatch)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_hwePriorsBatch");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_hwePriorsBatch(Shield<SEXP>(Rcpp::wrap(freq)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(logOutput)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector hwePriorsMixed(NumericVector freq, IntegerVector nalleles, std::vector<std::string> ploidy, bool logOutput = false, int nthreads = 1) {
+        typedef SEXP(*Ptr_hwePriorsMixed)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_hwePriorsMixed p_hwePriorsMixed = NULL;
+        if (p_hwePriorsMixed == NULL) {
+            validateSignature("NumericVector(*hwePriorsMixed)(NumericVector,IntegerVector,std::vector<std::string>,bool,int)");
+            p_hwePriorsMixed = (Ptr_hwePriorsMixed)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_hwePriorsMixed");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_hwePriorsMixed(Shield<SEXP>(Rcpp::wrap(freq)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(logOutput)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector alleleFreqEMBatch(IntegerVector AD, IntegerVector nalleles, int nsamples, int ploidy, double error = 0.001, double alpha = 0, double tol = 1e-6, int maxit = 200, int nthreads = 1) {
+        typedef SEXP(*Ptr_alleleFreqEMBatch)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_alleleFreqEMBatch p_alleleFreqEMBatch = NULL;
+        if (p_alleleFreqEMBatch == NULL) {
+            validateSignature("NumericVector(*alleleFreqEMBatch)(IntegerVector,IntegerVector,int,int,double,double,double,int,int)");
+            p_alleleFreqEMBatch = (Ptr_alleleFreqEMBatch)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_alleleFreqEMBatch");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_alleleFreqEMBatch(Shield<SEXP>(Rcpp::wrap(AD)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(error)), Shield<SEXP>(Rcpp::wrap(alpha)), Shield<SEXP>(Rcpp::wrap(tol)), Shield<SEXP>(Rcpp::wrap(maxit)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector alleleFreqEMMixed(IntegerVector AD, IntegerVector nalleles, std::vector<std::string> ploidy, double error = 0.001, double alpha = 0, double tol = 1e-6, int maxit = 200, int nthreads = 1) {
+        typedef SEXP(*Ptr_alleleFreqEMMixed)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_alleleFreqEMMixed p_alleleFreqEMMixed = NULL;
+        if (p_alleleFreqEMMixed == NULL) {
+            validateSignature("NumericVector(*alleleFreqEMMixed)(IntegerVector,IntegerVector,std::vector<std::string>,double,double,double,int,int)");
+            p_alleleFreqEMMixed = (Ptr_alleleFreqEMMixed)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_alleleFreqEMMixed");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_alleleFreqEMMixed(Shield<SEXP>(Rcpp::wrap(AD)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(error)), Shield<SEXP>(Rcpp::wrap(alpha)), Shield<SEXP>(Rcpp::wrap(tol)), Shield<SEXP>(Rcpp::wrap(maxit)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector lgammaCacheStats() {
+        typedef SEXP(*Ptr_lgammaCacheStats)();
+        static Ptr_lgammaCacheStats p_lgammaCacheStats = NULL;
+        if (p_lgammaCacheStats == NULL) {
+            validateSignature("NumericVector(*lgammaCacheStats)()");
+            p_lgammaCacheStats = (Ptr_lgammaCacheStats)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_lgammaCacheStats");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_lgammaCacheStats();
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline void resetLgammaCache() {
+        typedef SEXP(*Ptr_resetLgammaCache)();
+        static Ptr_resetLgammaCache p_resetLgammaCache = NULL;
+        if (p_resetLgammaCache == NULL) {
+            validateSignature("void(*resetLgammaCache)()");
+            p_resetLgammaCache = (Ptr_resetLgammaCache)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_resetLgammaCache");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_resetLgammaCache();
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+    }
+
+    inline NumericVector logLikToPosterior(NumericVector loglik, int ngen, Nullable<NumericVector> prior = R_NilValue, bool logOutput = false, int nthreads = 1) {
+        typedef SEXP(*Ptr_logLikToPosterior)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_logLikToPosterior p_logLikToPosterior = NULL;
+        if (p_logLikToPosterior == NULL) {
+            validateSignature("NumericVector(*logLikToPosterior)(NumericVector,int,Nullable<NumericVector>,bool,int)");
+            p_logLikToPosterior = (Ptr_logLikToPosterior)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_logLikToPosterior");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_logLikToPosterior(Shield<SEXP>(Rcpp::wrap(loglik)), Shield<SEXP>(Rcpp::wrap(ngen)), Shield<SEXP>(Rcpp::wrap(prior)), Shield<SEXP>(Rcpp::wrap(logOutput)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
     inline double dmultinom(NumericVector x, NumericVector prob) {
         typedef SEXP(*Ptr_dmultinom)(SEXP,SEXP);
         static Ptr_dmultinom p_dmultinom = NULL;
@@ -34,7 +389,343 @@ namespace ploidyverseVcf {
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_dmultinom(Shield<SEXP>(Rcpp::wrap(x)), Shield<SEXP>(Rcpp::wrap(prob)));
+            rcpp_result_gen = p_dmultinom(Shield<SEXP>(Rcpp::wrap(x)), Shield<SEXP>(Rcpp::wrap(prob)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<double >(rcpp_result_gen);
+    }
+
+    inline double dDirichletMultinom(NumericVector x, NumericVector prob, double alpha) {
+        typedef SEXP(*Ptr_dDirichletMultinom)(SEXP,SEXP,SEXP);
+        static Ptr_dDirichletMultinom p_dDirichletMultinom = NULL;
+        if (p_dDirichletMultinom == NULL) {
+            validateSignature("double(*dDirichletMultinom)(NumericVector,NumericVector,double)");
+            p_dDirichletMultinom = (Ptr_dDirichletMultinom)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_dDirichletMultinom");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_dDirichletMultinom(Shield<SEXP>(Rcpp::wrap(x)), Shield<SEXP>(Rcpp::wrap(prob)), Shield<SEXP>(Rcpp::wrap(alpha)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<double >(rcpp_result_gen);
+    }
+
+    inline double dmultinomLog(NumericVector x, NumericVector prob) {
+        typedef SEXP(*Ptr_dmultinomLog)(SEXP,SEXP);
+        static Ptr_dmultinomLog p_dmultinomLog = NULL;
+        if (p_dmultinomLog == NULL) {
+            validateSignature("double(*dmultinomLog)(NumericVector,NumericVector)");
+            p_dmultinomLog = (Ptr_dmultinomLog)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_dmultinomLog");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_dmultinomLog(Shield<SEXP>(Rcpp::wrap(x)), Shield<SEXP>(Rcpp::wrap(prob)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<double >(rcpp_result_gen);
+    }
+
+    inline double dDirichletMultinomLog(NumericVector x, NumericVector prob, double alpha) {
+        typedef SEXP(*Ptr_dDirichletMultinomLog)(SEXP,SEXP,SEXP);
+        static Ptr_dDirichletMultinomLog p_dDirichletMultinomLog = NULL;
+        if (p_dDirichletMultinomLog == NULL) {
+            validateSignature("double(*dDirichletMultinomLog)(NumericVector,NumericVector,double)");
+            p_dDirichletMultinomLog = (Ptr_dDirichletMultinomLog)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_dDirichletMultinomLog");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_dDirichletMultinomLog(Shield<SEXP>(Rcpp::wrap(x)), Shield<SEXP>(Rcpp::wrap(prob)), Shield<SEXP>(Rcpp::wrap(alpha)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<double >(rcpp_result_gen);
+    }
+
+    inline int nGen(int ploidy, int nalleles) {
+        typedef SEXP(*Ptr_nGen)(SEXP,SEXP);
+        static Ptr_nGen p_nGen = NULL;
+        if (p_nGen == NULL) {
+            validateSignature("int(*nGen)(int,int)");
+            p_nGen = (Ptr_nGen)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_nGen");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_nGen(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<int >(rcpp_result_gen);
+    }
+
+    inline IntegerMatrix enumerateGenotypes(int ploidy, int nalleles) {
+        typedef SEXP(*Ptr_enumerateGenotypes)(SEXP,SEXP);
+        static Ptr_enumerateGenotypes p_enumerateGenotypes = NULL;
+        if (p_enumerateGenotypes == NULL) {
+            validateSignature("IntegerMatrix(*enumerateGenotypes)(int,int)");
+            p_enumerateGenotypes = (Ptr_enumerateGenotypes)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_enumerateGenotypes");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_enumerateGenotypes(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<IntegerMatrix >(rcpp_result_gen);
+    }
+
+    inline IntegerMatrix enumeratePloidyGenotypes(std::string ploidy, int nalleles) {
+        typedef SEXP(*Ptr_enumeratePloidyGenotypes)(SEXP,SEXP);
+        static Ptr_enumeratePloidyGenotypes p_enumeratePloidyGenotypes = NULL;
+        if (p_enumeratePloidyGenotypes == NULL) {
+            validateSignature("IntegerMatrix(*enumeratePloidyGenotypes)(std::string,int)");
+            p_enumeratePloidyGenotypes = (Ptr_enumeratePloidyGenotypes)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_enumeratePloidyGenotypes");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_enumeratePloidyGenotypes(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<IntegerMatrix >(rcpp_result_gen);
+    }
+
+    inline int indexGenotype(IntegerVector genotype) {
+        typedef SEXP(*Ptr_indexGenotype)(SEXP);
+        static Ptr_indexGenotype p_indexGenotype = NULL;
+        if (p_indexGenotype == NULL) {
+            validateSignature("int(*indexGenotype)(IntegerVector)");
+            p_indexGenotype = (Ptr_indexGenotype)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_indexGenotype");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_indexGenotype(Shield<SEXP>(Rcpp::wrap(genotype)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<int >(rcpp_result_gen);
+    }
+
+    inline IntegerVector genotypeFromIndex(int index, int ploidy) {
+        typedef SEXP(*Ptr_genotypeFromIndex)(SEXP,SEXP);
+        static Ptr_genotypeFromIndex p_genotypeFromIndex = NULL;
+        if (p_genotypeFromIndex == NULL) {
+            validateSignature("IntegerVector(*genotypeFromIndex)(int,int)");
+            p_genotypeFromIndex = (Ptr_genotypeFromIndex)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_genotypeFromIndex");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_genotypeFromIndex(Shield<SEXP>(Rcpp::wrap(index)), Shield<SEXP>(Rcpp::wrap(ploidy)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<IntegerVector >(rcpp_result_gen);
+    }
+
+    inline NumericVector indexGenotypes(IntegerMatrix genotypes, int nthreads = 1) {
+        typedef SEXP(*Ptr_indexGenotypes)(SEXP,SEXP);
+        static Ptr_indexGenotypes p_indexGenotypes = NULL;
+        if (p_indexGenotypes == NULL) {
+            validateSignature("NumericVector(*indexGenotypes)(IntegerMatrix,int)");
+            p_indexGenotypes = (Ptr_indexGenotypes)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_indexGenotypes");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_indexGenotypes(Shield<SEXP>(Rcpp::wrap(genotypes)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline IntegerMatrix genotypesFromIndex(NumericVector index, int ploidy, int nthreads = 1) {
+        typedef SEXP(*Ptr_genotypesFromIndex)(SEXP,SEXP,SEXP);
+        static Ptr_genotypesFromIndex p_genotypesFromIndex = NULL;
+        if (p_genotypesFromIndex == NULL) {
+            validateSignature("IntegerMatrix(*genotypesFromIndex)(NumericVector,int,int)");
+            p_genotypesFromIndex = (Ptr_genotypesFromIndex)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_genotypesFromIndex");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_genotypesFromIndex(Shield<SEXP>(Rcpp::wrap(index)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<IntegerMatrix >(rcpp_result_gen);
+    }
+
+    inline IntegerVector alleleCopy(IntegerVector genotype, int nalleles) {
+        typedef SEXP(*Ptr_alleleCopy)(SEXP,SEXP);
+        static Ptr_alleleCopy p_alleleCopy = NULL;
+        if (p_alleleCopy == NULL) {
+            validateSignature("IntegerVector(*alleleCopy)(IntegerVector,int)");
+            p_alleleCopy = (Ptr_alleleCopy)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_alleleCopy");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_alleleCopy(Shield<SEXP>(Rcpp::wrap(genotype)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<IntegerVector >(rcpp_result_gen);
+    }
+
+    inline IntegerMatrix makeGametes(IntegerVector genotype) {
+        typedef SEXP(*Ptr_makeGametes)(SEXP);
+        static Ptr_makeGametes p_makeGametes = NULL;
+        if (p_makeGametes == NULL) {
+            validateSignature("IntegerMatrix(*makeGametes)(IntegerVector)");
+            p_makeGametes = (Ptr_makeGametes)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_makeGametes");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_makeGametes(Shield<SEXP>(Rcpp::wrap(genotype)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<IntegerMatrix >(rcpp_result_gen);
+    }
+
+    inline List gameteDistribution(IntegerVector genotype) {
+        typedef SEXP(*Ptr_gameteDistribution)(SEXP);
+        static Ptr_gameteDistribution p_gameteDistribution = NULL;
+        if (p_gameteDistribution == NULL) {
+            validateSignature("List(*gameteDistribution)(IntegerVector)");
+            p_gameteDistribution = (Ptr_gameteDistribution)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_gameteDistribution");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_gameteDistribution(Shield<SEXP>(Rcpp::wrap(genotype)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<List >(rcpp_result_gen);
+    }
+
+    inline NumericMatrix selfingMatrix(int ploidy, int nalleles) {
+        typedef SEXP(*Ptr_selfingMatrix)(SEXP,SEXP);
+        static Ptr_selfingMatrix p_selfingMatrix = NULL;
+        if (p_selfingMatrix == NULL) {
+            validateSignature("NumericMatrix(*selfingMatrix)(int,int)");
+            p_selfingMatrix = (Ptr_selfingMatrix)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_selfingMatrix");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_selfingMatrix(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericMatrix >(rcpp_result_gen);
+    }
+
+    inline SEXP acnToGenoBatch(NumericVector probarray, int ploidy, int nsamples, IntegerVector alleleCols, IntegerVector nalleles, int nthreads = 1, bool quantize = false) {
+        typedef SEXP(*Ptr_acnToGenoBatch)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_acnToGenoBatch p_acnToGenoBatch = NULL;
+        if (p_acnToGenoBatch == NULL) {
+            validateSignature("SEXP(*acnToGenoBatch)(NumericVector,int,int,IntegerVector,IntegerVector,int,bool)");
+            p_acnToGenoBatch = (Ptr_acnToGenoBatch)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_acnToGenoBatch");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_acnToGenoBatch(Shield<SEXP>(Rcpp::wrap(probarray)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(alleleCols)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nthreads)), Shield<SEXP>(Rcpp::wrap(quantize)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<SEXP >(rcpp_result_gen);
+    }
+
+    inline NumericVector genoToAcnBatch(SEXP genoprobs, int ploidy, int nsamples, IntegerVector alleleCols, IntegerVector nalleles, int nAlleleCols, int nthreads = 1) {
+        typedef SEXP(*Ptr_genoToAcnBatch)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_genoToAcnBatch p_genoToAcnBatch = NULL;
+        if (p_genoToAcnBatch == NULL) {
+            validateSignature("NumericVector(*genoToAcnBatch)(SEXP,int,int,IntegerVector,IntegerVector,int,int)");
+            p_genoToAcnBatch = (Ptr_genoToAcnBatch)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_genoToAcnBatch");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_genoToAcnBatch(Shield<SEXP>(Rcpp::wrap(genoprobs)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(alleleCols)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nAlleleCols)), Shield<SEXP>(Rcpp::wrap(nthreads)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -42,20 +733,20 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<double >(rcpp_result_gen);
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
     }
 
-    inline double dDirichletMultinom(NumericVector x, NumericVector prob, double alpha) {
-        typedef SEXP(*Ptr_dDirichletMultinom)(SEXP,SEXP,SEXP);
-        static Ptr_dDirichletMultinom p_dDirichletMultinom = NULL;
-        if (p_dDirichletMultinom == NULL) {
-            validateSignature("double(*dDirichletMultinom)(NumericVector,NumericVector,double)");
-            p_dDirichletMultinom = (Ptr_dDirichletMultinom)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_dDirichletMultinom");
+    inline List genotypeCallsBatch(SEXP genoprobs, int ploidy, int nsamples, IntegerVector nalleles, int nthreads = 1) {
+        typedef SEXP(*Ptr_genotypeCallsBatch)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_genotypeCallsBatch p_genotypeCallsBatch = NULL;
+        if (p_genotypeCallsBatch == NULL) {
+            validateSignature("List(*genotypeCallsBatch)(SEXP,int,int,IntegerVector,int)");
+            p_genotypeCallsBatch = (Ptr_genotypeCallsBatch)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_genotypeCallsBatch");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_dDirichletMultinom(Shield<SEXP>(Rcpp::wrap(x)), Shield<SEXP>(Rcpp::wrap(prob)), Shield<SEXP>(Rcpp::wrap(alpha)));
+            rcpp_result_gen = p_genotypeCallsBatch(Shield<SEXP>(Rcpp::wrap(genoprobs)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nthreads)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -63,20 +754,20 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<double >(rcpp_result_gen);
+        return Rcpp::as<List >(rcpp_result_gen);
     }
 
-    inline int nGen(int ploidy, int nalleles) {
-        typedef SEXP(*Ptr_nGen)(SEXP,SEXP);
-        static Ptr_nGen p_nGen = NULL;
-        if (p_nGen == NULL) {
-            validateSignature("int(*nGen)(int,int)");
-            p_nGen = (Ptr_nGen)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_nGen");
+    inline RawVector quantizeRaggedProbs(NumericVector values, NumericVector offsets, int nthreads = 1) {
+        typedef SEXP(*Ptr_quantizeRaggedProbs)(SEXP,SEXP,SEXP);
+        static Ptr_quantizeRaggedProbs p_quantizeRaggedProbs = NULL;
+        if (p_quantizeRaggedProbs == NULL) {
+            validateSignature("RawVector(*quantizeRaggedProbs)(NumericVector,NumericVector,int)");
+            p_quantizeRaggedProbs = (Ptr_quantizeRaggedProbs)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_quantizeRaggedProbs");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_nGen(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+            rcpp_result_gen = p_quantizeRaggedProbs(Shield<SEXP>(Rcpp::wrap(values)), Shield<SEXP>(Rcpp::wrap(offsets)), Shield<SEXP>(Rcpp::wrap(nthreads)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -84,20 +775,20 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<int >(rcpp_result_gen);
+        return Rcpp::as<RawVector >(rcpp_result_gen);
     }
 
-    inline IntegerMatrix enumerateGenotypes(int ploidy, int nalleles) {
-        typedef SEXP(*Ptr_enumerateGenotypes)(SEXP,SEXP);
-        static Ptr_enumerateGenotypes p_enumerateGenotypes = NULL;
-        if (p_enumerateGenotypes == NULL) {
-            validateSignature("IntegerMatrix(*enumerateGenotypes)(int,int)");
-            p_enumerateGenotypes = (Ptr_enumerateGenotypes)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_enumerateGenotypes");
+    inline NumericVector dequantizeProbs(RawVector values, int nthreads = 1) {
+        typedef SEXP(*Ptr_dequantizeProbs)(SEXP,SEXP);
+        static Ptr_dequantizeProbs p_dequantizeProbs = NULL;
+        if (p_dequantizeProbs == NULL) {
+            validateSignature("NumericVector(*dequantizeProbs)(RawVector,int)");
+            p_dequantizeProbs = (Ptr_dequantizeProbs)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_dequantizeProbs");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_enumerateGenotypes(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+            rcpp_result_gen = p_dequantizeProbs(Shield<SEXP>(Rcpp::wrap(values)), Shield<SEXP>(Rcpp::wrap(nthreads)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -105,20 +796,20 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<IntegerMatrix >(rcpp_result_gen);
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
     }
 
-    inline int indexGenotype(IntegerVector genotype) {
-        typedef SEXP(*Ptr_indexGenotype)(SEXP);
-        static Ptr_indexGenotype p_indexGenotype = NULL;
-        if (p_indexGenotype == NULL) {
-            validateSignature("int(*indexGenotype)(IntegerVector)");
-            p_indexGenotype = (Ptr_indexGenotype)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_indexGenotype");
+    inline List raggedFromMatrixList(List mat, int nthreads = 1) {
+        typedef SEXP(*Ptr_raggedFromMatrixList)(SEXP,SEXP);
+        static Ptr_raggedFromMatrixList p_raggedFromMatrixList = NULL;
+        if (p_raggedFromMatrixList == NULL) {
+            validateSignature("List(*raggedFromMatrixList)(List,int)");
+            p_raggedFromMatrixList = (Ptr_raggedFromMatrixList)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_raggedFromMatrixList");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_indexGenotype(Shield<SEXP>(Rcpp::wrap(genotype)));
+            rcpp_result_gen = p_raggedFromMatrixList(Shield<SEXP>(Rcpp::wrap(mat)), Shield<SEXP>(Rcpp::wrap(nthreads)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -126,20 +817,20 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<int >(rcpp_result_gen);
+        return Rcpp::as<List >(rcpp_result_gen);
     }
 
-    inline IntegerVector genotypeFromIndex(int index, int ploidy) {
-        typedef SEXP(*Ptr_genotypeFromIndex)(SEXP,SEXP);
-        static Ptr_genotypeFromIndex p_genotypeFromIndex = NULL;
-        if (p_genotypeFromIndex == NULL) {
-            validateSignature("IntegerVector(*genotypeFromIndex)(int,int)");
-            p_genotypeFromIndex = (Ptr_genotypeFromIndex)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_genotypeFromIndex");
+    inline List raggedToMatrixList(SEXP values, NumericVector offsets, int nrow, int ncol) {
+        typedef SEXP(*Ptr_raggedToMatrixList)(SEXP,SEXP,SEXP,SEXP);
+        static Ptr_raggedToMatrixList p_raggedToMatrixList = NULL;
+        if (p_raggedToMatrixList == NULL) {
+            validateSignature("List(*raggedToMatrixList)(SEXP,NumericVector,int,int)");
+            p_raggedToMatrixList = (Ptr_raggedToMatrixList)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_raggedToMatrixList");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_genotypeFromIndex(Shield<SEXP>(Rcpp::wrap(index)), Shield<SEXP>(Rcpp::wrap(ploidy)));
+            rcpp_result_gen = p_raggedToMatrixList(Shield<SEXP>(Rcpp::wrap(values)), Shield<SEXP>(Rcpp::wrap(offsets)), Shield<SEXP>(Rcpp::wrap(nrow)), Shield<SEXP>(Rcpp::wrap(ncol)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -147,20 +838,20 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<IntegerVector >(rcpp_result_gen);
+        return Rcpp::as<List >(rcpp_result_gen);
     }
 
-    inline IntegerVector alleleCopy(IntegerVector genotype, int nalleles) {
-        typedef SEXP(*Ptr_alleleCopy)(SEXP,SEXP);
-        static Ptr_alleleCopy p_alleleCopy = NULL;
-        if (p_alleleCopy == NULL) {
-            validateSignature("IntegerVector(*alleleCopy)(IntegerVector,int)");
-            p_alleleCopy = (Ptr_alleleCopy)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_alleleCopy");
+    inline List selfingMatrixCSR(int ploidy, int nalleles, int generations = 1, int nthreads = 1) {
+        typedef SEXP(*Ptr_selfingMatrixCSR)(SEXP,SEXP,SEXP,SEXP);
+        static Ptr_selfingMatrixCSR p_selfingMatrixCSR = NULL;
+        if (p_selfingMatrixCSR == NULL) {
+            validateSignature("List(*selfingMatrixCSR)(int,int,int,int)");
+            p_selfingMatrixCSR = (Ptr_selfingMatrixCSR)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_selfingMatrixCSR");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_alleleCopy(Shield<SEXP>(Rcpp::wrap(genotype)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+            rcpp_result_gen = p_selfingMatrixCSR(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(generations)), Shield<SEXP>(Rcpp::wrap(nthreads)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -168,20 +859,20 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<IntegerVector >(rcpp_result_gen);
+        return Rcpp::as<List >(rcpp_result_gen);
     }
 
-    inline IntegerMatrix makeGametes(IntegerVector genotype) {
-        typedef SEXP(*Ptr_makeGametes)(SEXP);
-        static Ptr_makeGametes p_makeGametes = NULL;
-        if (p_makeGametes == NULL) {
-            validateSignature("IntegerMatrix(*makeGametes)(IntegerVector)");
-            p_makeGametes = (Ptr_makeGametes)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_makeGametes");
+    inline NumericVector applySelfing(NumericVector freq, int ploidy, int nalleles, int nthreads = 1) {
+        typedef SEXP(*Ptr_applySelfing)(SEXP,SEXP,SEXP,SEXP);
+        static Ptr_applySelfing p_applySelfing = NULL;
+        if (p_applySelfing == NULL) {
+            validateSignature("NumericVector(*applySelfing)(NumericVector,int,int,int)");
+            p_applySelfing = (Ptr_applySelfing)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_applySelfing");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_makeGametes(Shield<SEXP>(Rcpp::wrap(genotype)));
+            rcpp_result_gen = p_applySelfing(Shield<SEXP>(Rcpp::wrap(freq)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nthreads)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -189,20 +880,309 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<IntegerMatrix >(rcpp_result_gen);
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
     }
 
-    inline NumericMatrix selfingMatrix(int ploidy, int nalleles) {
-        typedef SEXP(*Ptr_selfingMatrix)(SEXP,SEXP);
-        static Ptr_selfingMatrix p_selfingMatrix = NULL;
-        if (p_selfingMatrix == NULL) {
-            validateSignature("NumericMatrix(*selfingMatrix)(int,int)");
-            p_selfingMatrix = (Ptr_selfingMatrix)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_selfingMatrix");
+    inline NumericVector selfingGenerations(NumericVector freq, int ploidy, int nalleles, IntegerVector generations, int nthreads = 1) {
+        typedef SEXP(*Ptr_selfingGenerations)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_selfingGenerations p_selfingGenerations = NULL;
+        if (p_selfingGenerations == NULL) {
+            validateSignature("NumericVector(*selfingGenerations)(NumericVector,int,int,IntegerVector,int)");
+            p_selfingGenerations = (Ptr_selfingGenerations)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_selfingGenerations");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p_selfingMatrix(Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)));
+            rcpp_result_gen = p_selfingGenerations(Shield<SEXP>(Rcpp::wrap(freq)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(generations)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<NumericVector >(rcpp_result_gen);
+    }
+
+    inline void vcfCacheBuild(std::string file, std::string cache, int ploidy, CharacterVector fields, bool quantizeGP = false, double tolerance = 0.01, int nloci = 10000, int nthreads = 1) {
+        typedef SEXP(*Ptr_vcfCacheBuild)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_vcfCacheBuild p_vcfCacheBuild = NULL;
+        if (p_vcfCacheBuild == NULL) {
+            validateSignature("void(*vcfCacheBuild)(std::string,std::string,int,CharacterVector,bool,double,int,int)");
+            p_vcfCacheBuild = (Ptr_vcfCacheBuild)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheBuild");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfCacheBuild(Shield<SEXP>(Rcpp::wrap(file)), Shield<SEXP>(Rcpp::wrap(cache)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(fields)), Shield<SEXP>(Rcpp::wrap(quantizeGP)), Shield<SEXP>(Rcpp::wrap(tolerance)), Shield<SEXP>(Rcpp::wrap(nloci)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+    }
+
+    inline SEXP vcfCacheOpen(std::string cache) {
+        typedef SEXP(*Ptr_vcfCacheOpen)(SEXP);
+        static Ptr_vcfCacheOpen p_vcfCacheOpen = NULL;
+        if (p_vcfCacheOpen == NULL) {
+            validateSignature("SEXP(*vcfCacheOpen)(std::string)");
+            p_vcfCacheOpen = (Ptr_vcfCacheOpen)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheOpen");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfCacheOpen(Shield<SEXP>(Rcpp::wrap(cache)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<SEXP >(rcpp_result_gen);
+    }
+
+    inline List vcfCacheInfo(SEXP cache) {
+        typedef SEXP(*Ptr_vcfCacheInfo)(SEXP);
+        static Ptr_vcfCacheInfo p_vcfCacheInfo = NULL;
+        if (p_vcfCacheInfo == NULL) {
+            validateSignature("List(*vcfCacheInfo)(SEXP)");
+            p_vcfCacheInfo = (Ptr_vcfCacheInfo)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheInfo");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfCacheInfo(Shield<SEXP>(Rcpp::wrap(cache)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<List >(rcpp_result_gen);
+    }
+
+    inline List vcfCacheRead(SEXP cache, NumericVector loci, IntegerVector samples, CharacterVector fields, int nthreads = 1) {
+        typedef SEXP(*Ptr_vcfCacheRead)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_vcfCacheRead p_vcfCacheRead = NULL;
+        if (p_vcfCacheRead == NULL) {
+            validateSignature("List(*vcfCacheRead)(SEXP,NumericVector,IntegerVector,CharacterVector,int)");
+            p_vcfCacheRead = (Ptr_vcfCacheRead)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheRead");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfCacheRead(Shield<SEXP>(Rcpp::wrap(cache)), Shield<SEXP>(Rcpp::wrap(loci)), Shield<SEXP>(Rcpp::wrap(samples)), Shield<SEXP>(Rcpp::wrap(fields)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<List >(rcpp_result_gen);
+    }
+
+    inline void vcfCacheClose(SEXP cache) {
+        typedef SEXP(*Ptr_vcfCacheClose)(SEXP);
+        static Ptr_vcfCacheClose p_vcfCacheClose = NULL;
+        if (p_vcfCacheClose == NULL) {
+            validateSignature("void(*vcfCacheClose)(SEXP)");
+            p_vcfCacheClose = (Ptr_vcfCacheClose)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheClose");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfCacheClose(Shield<SEXP>(Rcpp::wrap(cache)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+    }
+
+    inline SEXP vcfReaderOpen(std::string file, int ploidy, CharacterVector fields, int nthreads = 1) {
+        typedef SEXP(*Ptr_vcfReaderOpen)(SEXP,SEXP,SEXP,SEXP);
+        static Ptr_vcfReaderOpen p_vcfReaderOpen = NULL;
+        if (p_vcfReaderOpen == NULL) {
+            validateSignature("SEXP(*vcfReaderOpen)(std::string,int,CharacterVector,int)");
+            p_vcfReaderOpen = (Ptr_vcfReaderOpen)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderOpen");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfReaderOpen(Shield<SEXP>(Rcpp::wrap(file)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(fields)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<SEXP >(rcpp_result_gen);
+    }
+
+    inline void vcfReaderSetRegion(SEXP reader, std::string index, std::string chrom, double start, double end) {
+        typedef SEXP(*Ptr_vcfReaderSetRegion)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_vcfReaderSetRegion p_vcfReaderSetRegion = NULL;
+        if (p_vcfReaderSetRegion == NULL) {
+            validateSignature("void(*vcfReaderSetRegion)(SEXP,std::string,std::string,double,double)");
+            p_vcfReaderSetRegion = (Ptr_vcfReaderSetRegion)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderSetRegion");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfReaderSetRegion(Shield<SEXP>(Rcpp::wrap(reader)), Shield<SEXP>(Rcpp::wrap(index)), Shield<SEXP>(Rcpp::wrap(chrom)), Shield<SEXP>(Rcpp::wrap(start)), Shield<SEXP>(Rcpp::wrap(end)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+    }
+
+    inline List vcfReaderInfo(SEXP reader) {
+        typedef SEXP(*Ptr_vcfReaderInfo)(SEXP);
+        static Ptr_vcfReaderInfo p_vcfReaderInfo = NULL;
+        if (p_vcfReaderInfo == NULL) {
+            validateSignature("List(*vcfReaderInfo)(SEXP)");
+            p_vcfReaderInfo = (Ptr_vcfReaderInfo)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderInfo");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfReaderInfo(Shield<SEXP>(Rcpp::wrap(reader)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<List >(rcpp_result_gen);
+    }
+
+    inline List vcfReadChunk(SEXP reader, int nloci, bool quantizeGP = false) {
+        typedef SEXP(*Ptr_vcfReadChunk)(SEXP,SEXP,SEXP);
+        static Ptr_vcfReadChunk p_vcfReadChunk = NULL;
+        if (p_vcfReadChunk == NULL) {
+            validateSignature("List(*vcfReadChunk)(SEXP,int,bool)");
+            p_vcfReadChunk = (Ptr_vcfReadChunk)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReadChunk");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfReadChunk(Shield<SEXP>(Rcpp::wrap(reader)), Shield<SEXP>(Rcpp::wrap(nloci)), Shield<SEXP>(Rcpp::wrap(quantizeGP)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<List >(rcpp_result_gen);
+    }
+
+    inline void vcfReaderClose(SEXP reader) {
+        typedef SEXP(*Ptr_vcfReaderClose)(SEXP);
+        static Ptr_vcfReaderClose p_vcfReaderClose = NULL;
+        if (p_vcfReaderClose == NULL) {
+            validateSignature("void(*vcfReaderClose)(SEXP)");
+            p_vcfReaderClose = (Ptr_vcfReaderClose)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderClose");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfReaderClose(Shield<SEXP>(Rcpp::wrap(reader)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+    }
+
+    inline List vcfValidateFile(std::string file, int ploidy, double tolerance = 0.01, int nloci = 10000, int nthreads = 1) {
+        typedef SEXP(*Ptr_vcfValidateFile)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_vcfValidateFile p_vcfValidateFile = NULL;
+        if (p_vcfValidateFile == NULL) {
+            validateSignature("List(*vcfValidateFile)(std::string,int,double,int,int)");
+            p_vcfValidateFile = (Ptr_vcfValidateFile)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfValidateFile");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfValidateFile(Shield<SEXP>(Rcpp::wrap(file)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(tolerance)), Shield<SEXP>(Rcpp::wrap(nloci)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<List >(rcpp_result_gen);
+    }
+
+    inline SEXP vcfWriterOpen(std::string file, std::vector<std::string> header, bool bgzf = false, int level = 6, int nthreads = 1) {
+        typedef SEXP(*Ptr_vcfWriterOpen)(SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_vcfWriterOpen p_vcfWriterOpen = NULL;
+        if (p_vcfWriterOpen == NULL) {
+            validateSignature("SEXP(*vcfWriterOpen)(std::string,std::vector<std::string>,bool,int,int)");
+            p_vcfWriterOpen = (Ptr_vcfWriterOpen)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfWriterOpen");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfWriterOpen(Shield<SEXP>(Rcpp::wrap(file)), Shield<SEXP>(Rcpp::wrap(header)), Shield<SEXP>(Rcpp::wrap(bgzf)), Shield<SEXP>(Rcpp::wrap(level)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+        return Rcpp::as<SEXP >(rcpp_result_gen);
+    }
+
+    inline void vcfWriteChunk(SEXP writer, std::vector<std::string> chrom, IntegerVector pos, std::vector<std::string> id, std::vector<std::string> ref, std::vector<std::string> alt, IntegerVector nalleles, int nsamples, int ploidy, SEXP GT = R_NilValue, SEXP phased = R_NilValue, SEXP AD = R_NilValue, SEXP GP = R_NilValue, SEXP GN = R_NilValue, SEXP PS = R_NilValue, int digits = 3, int nthreads = 1) {
+        typedef SEXP(*Ptr_vcfWriteChunk)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+        static Ptr_vcfWriteChunk p_vcfWriteChunk = NULL;
+        if (p_vcfWriteChunk == NULL) {
+            validateSignature("void(*vcfWriteChunk)(SEXP,std::vector<std::string>,IntegerVector,std::vector<std::string>,std::vector<std::string>,std::vector<std::string>,IntegerVector,int,int,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,int,int)");
+            p_vcfWriteChunk = (Ptr_vcfWriteChunk)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfWriteChunk");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfWriteChunk(Shield<SEXP>(Rcpp::wrap(writer)), Shield<SEXP>(Rcpp::wrap(chrom)), Shield<SEXP>(Rcpp::wrap(pos)), Shield<SEXP>(Rcpp::wrap(id)), Shield<SEXP>(Rcpp::wrap(ref)), Shield<SEXP>(Rcpp::wrap(alt)), Shield<SEXP>(Rcpp::wrap(nalleles)), Shield<SEXP>(Rcpp::wrap(nsamples)), Shield<SEXP>(Rcpp::wrap(ploidy)), Shield<SEXP>(Rcpp::wrap(GT)), Shield<SEXP>(Rcpp::wrap(phased)), Shield<SEXP>(Rcpp::wrap(AD)), Shield<SEXP>(Rcpp::wrap(GP)), Shield<SEXP>(Rcpp::wrap(GN)), Shield<SEXP>(Rcpp::wrap(PS)), Shield<SEXP>(Rcpp::wrap(digits)), Shield<SEXP>(Rcpp::wrap(nthreads)));
+        }
+        if (rcpp_result_gen.inherits("interrupted-error"))
+            throw Rcpp::internal::InterruptedException();
+        if (Rcpp::internal::isLongjumpSentinel(rcpp_result_gen))
+            throw Rcpp::LongjumpException(rcpp_result_gen);
+        if (rcpp_result_gen.inherits("try-error"))
+            throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
+    }
+
+    inline void vcfWriterClose(SEXP writer) {
+        typedef SEXP(*Ptr_vcfWriterClose)(SEXP);
+        static Ptr_vcfWriterClose p_vcfWriterClose = NULL;
+        if (p_vcfWriterClose == NULL) {
+            validateSignature("void(*vcfWriterClose)(SEXP)");
+            p_vcfWriterClose = (Ptr_vcfWriterClose)R_GetCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfWriterClose");
+        }
+        RObject rcpp_result_gen;
+        {
+            RNGScope RCPP_rngScope_gen;
+            rcpp_result_gen = p_vcfWriterClose(Shield<SEXP>(Rcpp::wrap(writer)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -210,7 +1190,6 @@ namespace ploidyverseVcf {
             throw Rcpp::LongjumpException(rcpp_result_gen);
         if (rcpp_result_gen.inherits("try-error"))
             throw Rcpp::exception(Rcpp::as<std::string>(rcpp_result_gen).c_str());
-        return Rcpp::as<NumericMatrix >(rcpp_result_gen);
     }
 
 }
@@ -8,22 +8,23 @@
 
 using namespace Rcpp;
 
-// dmultinom
-double dmultinom(NumericVector x, NumericVector prob);
-static SEXP _ploidyverseVcf_dmultinom_try(SEXP xSEXP, SEXP probSEXP) {
+// crossProgeny
+NumericVector crossProgeny(IntegerVector mother, IntegerVector father, int nalleles);
+static SEXP _ploidyverseVcf_crossProgeny_try(SEXP motherSEXP, SEXP fatherSEXP, SEXP nallelesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
-    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
-    Rcpp::traits::input_parameter< NumericVector >::type prob(probSEXP);
-    rcpp_result_gen = Rcpp::wrap(dmultinom(x, prob));
+    Rcpp::traits::input_parameter< IntegerVector >::type mother(motherSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type father(fatherSEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    rcpp_result_gen = Rcpp::wrap(crossProgeny(mother, father, nalleles));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_dmultinom(SEXP xSEXP, SEXP probSEXP) {
+RcppExport SEXP _ploidyverseVcf_crossProgeny(SEXP motherSEXP, SEXP fatherSEXP, SEXP nallelesSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_dmultinom_try(xSEXP, probSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_crossProgeny_try(motherSEXP, fatherSEXP, nallelesSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -43,23 +44,25 @@ RcppExport SEXP _ploidyverseVcf_dmultinom(SEXP xSEXP, SEXP probSEXP) {
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// dDirichletMultinom
-double dDirichletMultinom(NumericVector x, NumericVector prob, double alpha);
-static SEXP _ploidyverseVcf_dDirichletMultinom_try(SEXP xSEXP, SEXP probSEXP, SEXP alphaSEXP) {
+// crossProgenyFreq
+NumericVector crossProgenyFreq(NumericVector mother, NumericVector father, int motherPloidy, int fatherPloidy, int nalleles);
+static SEXP _ploidyverseVcf_crossProgenyFreq_try(SEXP motherSEXP, SEXP fatherSEXP, SEXP motherPloidySEXP, SEXP fatherPloidySEXP, SEXP nallelesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
-    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
-    Rcpp::traits::input_parameter< NumericVector >::type prob(probSEXP);
-    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
-    rcpp_result_gen = Rcpp::wrap(dDirichletMultinom(x, prob, alpha));
+    Rcpp::traits::input_parameter< NumericVector >::type mother(motherSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type father(fatherSEXP);
+    Rcpp::traits::input_parameter< int >::type motherPloidy(motherPloidySEXP);
+    Rcpp::traits::input_parameter< int >::type fatherPloidy(fatherPloidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    rcpp_result_gen = Rcpp::wrap(crossProgenyFreq(mother, father, motherPloidy, fatherPloidy, nalleles));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_dDirichletMultinom(SEXP xSEXP, SEXP probSEXP, SEXP alphaSEXP) {
+RcppExport SEXP _ploidyverseVcf_crossProgenyFreq(SEXP motherSEXP, SEXP fatherSEXP, SEXP motherPloidySEXP, SEXP fatherPloidySEXP, SEXP nallelesSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_dDirichletMultinom_try(xSEXP, probSEXP, alphaSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_crossProgenyFreq_try(motherSEXP, fatherSEXP, motherPloidySEXP, fatherPloidySEXP, nallelesSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -79,22 +82,26 @@ RcppExport SEXP _ploidyverseVcf_dDirichletMultinom(SEXP xSEXP, SEXP probSEXP, SE
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// nGen
-int nGen(int ploidy, int nalleles);
-static SEXP _ploidyverseVcf_nGen_try(SEXP ploidySEXP, SEXP nallelesSEXP) {
+// crossProgenyBatch
+NumericVector crossProgenyBatch(IntegerVector mother, IntegerVector father, IntegerVector nalleles, int motherPloidy, int fatherPloidy, int nthreads);
+static SEXP _ploidyverseVcf_crossProgenyBatch_try(SEXP motherSEXP, SEXP fatherSEXP, SEXP nallelesSEXP, SEXP motherPloidySEXP, SEXP fatherPloidySEXP, SEXP nthreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
-    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
-    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
-    rcpp_result_gen = Rcpp::wrap(nGen(ploidy, nalleles));
+    Rcpp::traits::input_parameter< IntegerVector >::type mother(motherSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type father(fatherSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type motherPloidy(motherPloidySEXP);
+    Rcpp::traits::input_parameter< int >::type fatherPloidy(fatherPloidySEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(crossProgenyBatch(mother, father, nalleles, motherPloidy, fatherPloidy, nthreads));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_nGen(SEXP ploidySEXP, SEXP nallelesSEXP) {
+RcppExport SEXP _ploidyverseVcf_crossProgenyBatch(SEXP motherSEXP, SEXP fatherSEXP, SEXP nallelesSEXP, SEXP motherPloidySEXP, SEXP fatherPloidySEXP, SEXP nthreadsSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_nGen_try(ploidySEXP, nallelesSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_crossProgenyBatch_try(motherSEXP, fatherSEXP, nallelesSEXP, motherPloidySEXP, fatherPloidySEXP, nthreadsSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -114,22 +121,126 @@ RcppExport SEXP _ploidyverseVcf_nGen(SEXP ploidySEXP, SEXP nallelesSEXP) {
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// enumerateGenotypes
-IntegerMatrix enumerateGenotypes(int ploidy, int nalleles);
-static SEXP _ploidyverseVcf_enumerateGenotypes_try(SEXP ploidySEXP, SEXP nallelesSEXP) {
+// instrumentKernels
+bool instrumentKernels(bool enable);
+static SEXP _ploidyverseVcf_instrumentKernels_try(SEXP enableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< bool >::type enable(enableSEXP);
+    rcpp_result_gen = Rcpp::wrap(instrumentKernels(enable));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_instrumentKernels(SEXP enableSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_instrumentKernels_try(enableSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// kernelStats
+List kernelStats();
+static SEXP _ploidyverseVcf_kernelStats_try() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    rcpp_result_gen = Rcpp::wrap(kernelStats());
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_kernelStats() {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_kernelStats_try());
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// resetKernelStats
+void resetKernelStats();
+static SEXP _ploidyverseVcf_resetKernelStats_try() {
+BEGIN_RCPP
+    resetKernelStats();
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_resetKernelStats() {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_resetKernelStats_try());
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// batchGenotypeLikelihoods
+NumericVector batchGenotypeLikelihoods(IntegerVector AD, IntegerVector nalleles, int nsamples, int ploidy, double error, double alpha, int nthreads);
+static SEXP _ploidyverseVcf_batchGenotypeLikelihoods_try(SEXP ADSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP nthreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type AD(ADSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
     Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
-    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
-    rcpp_result_gen = Rcpp::wrap(enumerateGenotypes(ploidy, nalleles));
+    Rcpp::traits::input_parameter< double >::type error(errorSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(batchGenotypeLikelihoods(AD, nalleles, nsamples, ploidy, error, alpha, nthreads));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_enumerateGenotypes(SEXP ploidySEXP, SEXP nallelesSEXP) {
+RcppExport SEXP _ploidyverseVcf_batchGenotypeLikelihoods(SEXP ADSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP nthreadsSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_enumerateGenotypes_try(ploidySEXP, nallelesSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_batchGenotypeLikelihoods_try(ADSEXP, nallelesSEXP, nsamplesSEXP, ploidySEXP, errorSEXP, alphaSEXP, nthreadsSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -149,21 +260,26 @@ RcppExport SEXP _ploidyverseVcf_enumerateGenotypes(SEXP ploidySEXP, SEXP nallele
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// indexGenotype
-int indexGenotype(IntegerVector genotype);
-static SEXP _ploidyverseVcf_indexGenotype_try(SEXP genotypeSEXP) {
+// batchGenotypeLikelihoodsMixed
+NumericVector batchGenotypeLikelihoodsMixed(IntegerVector AD, IntegerVector nalleles, std::vector<std::string> ploidy, double error, double alpha, int nthreads);
+static SEXP _ploidyverseVcf_batchGenotypeLikelihoodsMixed_try(SEXP ADSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP nthreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
-    Rcpp::traits::input_parameter< IntegerVector >::type genotype(genotypeSEXP);
-    rcpp_result_gen = Rcpp::wrap(indexGenotype(genotype));
+    Rcpp::traits::input_parameter< IntegerVector >::type AD(ADSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< double >::type error(errorSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(batchGenotypeLikelihoodsMixed(AD, nalleles, ploidy, error, alpha, nthreads));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_indexGenotype(SEXP genotypeSEXP) {
+RcppExport SEXP _ploidyverseVcf_batchGenotypeLikelihoodsMixed(SEXP ADSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP nthreadsSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_indexGenotype_try(genotypeSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_batchGenotypeLikelihoodsMixed_try(ADSEXP, nallelesSEXP, ploidySEXP, errorSEXP, alphaSEXP, nthreadsSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -183,22 +299,30 @@ RcppExport SEXP _ploidyverseVcf_indexGenotype(SEXP genotypeSEXP) {
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// genotypeFromIndex
-IntegerVector genotypeFromIndex(int index, int ploidy);
-static SEXP _ploidyverseVcf_genotypeFromIndex_try(SEXP indexSEXP, SEXP ploidySEXP) {
+// fitOverdispersionBatch
+NumericVector fitOverdispersionBatch(IntegerVector AD, NumericVector genoprobs, IntegerVector nalleles, int nsamples, int ploidy, double error, bool shared, double lower, double upper, int nthreads);
+static SEXP _ploidyverseVcf_fitOverdispersionBatch_try(SEXP ADSEXP, SEXP genoprobsSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP sharedSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP nthreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
-    Rcpp::traits::input_parameter< int >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type AD(ADSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type genoprobs(genoprobsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
     Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
-    rcpp_result_gen = Rcpp::wrap(genotypeFromIndex(index, ploidy));
+    Rcpp::traits::input_parameter< double >::type error(errorSEXP);
+    Rcpp::traits::input_parameter< bool >::type shared(sharedSEXP);
+    Rcpp::traits::input_parameter< double >::type lower(lowerSEXP);
+    Rcpp::traits::input_parameter< double >::type upper(upperSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(fitOverdispersionBatch(AD, genoprobs, nalleles, nsamples, ploidy, error, shared, lower, upper, nthreads));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_genotypeFromIndex(SEXP indexSEXP, SEXP ploidySEXP) {
+RcppExport SEXP _ploidyverseVcf_fitOverdispersionBatch(SEXP ADSEXP, SEXP genoprobsSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP sharedSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP nthreadsSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_genotypeFromIndex_try(indexSEXP, ploidySEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_fitOverdispersionBatch_try(ADSEXP, genoprobsSEXP, nallelesSEXP, nsamplesSEXP, ploidySEXP, errorSEXP, sharedSEXP, lowerSEXP, upperSEXP, nthreadsSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -218,22 +342,29 @@ RcppExport SEXP _ploidyverseVcf_genotypeFromIndex(SEXP indexSEXP, SEXP ploidySEX
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// alleleCopy
-IntegerVector alleleCopy(IntegerVector genotype, int nalleles);
-static SEXP _ploidyverseVcf_alleleCopy_try(SEXP genotypeSEXP, SEXP nallelesSEXP) {
+// fitOverdispersionMixed
+NumericVector fitOverdispersionMixed(IntegerVector AD, NumericVector genoprobs, IntegerVector nalleles, std::vector<std::string> ploidy, double error, bool shared, double lower, double upper, int nthreads);
+static SEXP _ploidyverseVcf_fitOverdispersionMixed_try(SEXP ADSEXP, SEXP genoprobsSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP sharedSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP nthreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
-    Rcpp::traits::input_parameter< IntegerVector >::type genotype(genotypeSEXP);
-    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
-    rcpp_result_gen = Rcpp::wrap(alleleCopy(genotype, nalleles));
+    Rcpp::traits::input_parameter< IntegerVector >::type AD(ADSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type genoprobs(genoprobsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< double >::type error(errorSEXP);
+    Rcpp::traits::input_parameter< bool >::type shared(sharedSEXP);
+    Rcpp::traits::input_parameter< double >::type lower(lowerSEXP);
+    Rcpp::traits::input_parameter< double >::type upper(upperSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(fitOverdispersionMixed(AD, genoprobs, nalleles, ploidy, error, shared, lower, upper, nthreads));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_alleleCopy(SEXP genotypeSEXP, SEXP nallelesSEXP) {
+RcppExport SEXP _ploidyverseVcf_fitOverdispersionMixed(SEXP ADSEXP, SEXP genoprobsSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP sharedSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP nthreadsSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_alleleCopy_try(genotypeSEXP, nallelesSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_fitOverdispersionMixed_try(ADSEXP, genoprobsSEXP, nallelesSEXP, ploidySEXP, errorSEXP, sharedSEXP, lowerSEXP, upperSEXP, nthreadsSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -253,21 +384,26 @@ RcppExport SEXP _ploidyverseVcf_alleleCopy(SEXP genotypeSEXP, SEXP nallelesSEXP)
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// makeGametes
-IntegerMatrix makeGametes(IntegerVector genotype);
-static SEXP _ploidyverseVcf_makeGametes_try(SEXP genotypeSEXP) {
+// hwePriorsBatch
+NumericVector hwePriorsBatch(NumericVector freq, IntegerVector nalleles, int ploidy, int nsamples, bool logOutput, int nthreads);
+static SEXP _ploidyverseVcf_hwePriorsBatch_try(SEXP freqSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP logOutputSEXP, SEXP nthreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
-    Rcpp::traits::input_parameter< IntegerVector >::type genotype(genotypeSEXP);
-    rcpp_result_gen = Rcpp::wrap(makeGametes(genotype));
+    Rcpp::traits::input_parameter< NumericVector >::type freq(freqSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
+    Rcpp::traits::input_parameter< bool >::type logOutput(logOutputSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(hwePriorsBatch(freq, nalleles, ploidy, nsamples, logOutput, nthreads));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_makeGametes(SEXP genotypeSEXP) {
+RcppExport SEXP _ploidyverseVcf_hwePriorsBatch(SEXP freqSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP logOutputSEXP, SEXP nthreadsSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_makeGametes_try(genotypeSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_hwePriorsBatch_try(freqSEXP, nallelesSEXP, ploidySEXP, nsamplesSEXP, logOutputSEXP, nthreadsSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -287,22 +423,1623 @@ RcppExport SEXP _ploidyverseVcf_makeGametes(SEXP genotypeSEXP) {
     UNPROTECT(1);
     return rcpp_result_gen;
 }
-// selfingMatrix
-NumericMatrix selfingMatrix(int ploidy, int nalleles);
-static SEXP _ploidyverseVcf_selfingMatrix_try(SEXP ploidySEXP, SEXP nallelesSEXP) {
+// hwePriorsMixed
+NumericVector hwePriorsMixed(NumericVector freq, IntegerVector nalleles, std::vector<std::string> ploidy, bool logOutput, int nthreads);
+static SEXP _ploidyverseVcf_hwePriorsMixed_try(SEXP freqSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP logOutputSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type freq(freqSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< bool >::type logOutput(logOutputSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(hwePriorsMixed(freq, nalleles, ploidy, logOutput, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_hwePriorsMixed(SEXP freqSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP logOutputSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_hwePriorsMixed_try(freqSEXP, nallelesSEXP, ploidySEXP, logOutputSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// alleleFreqEMBatch
+NumericVector alleleFreqEMBatch(IntegerVector AD, IntegerVector nalleles, int nsamples, int ploidy, double error, double alpha, double tol, int maxit, int nthreads);
+static SEXP _ploidyverseVcf_alleleFreqEMBatch_try(SEXP ADSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP nthreadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type AD(ADSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
     Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
-    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
-    rcpp_result_gen = Rcpp::wrap(selfingMatrix(ploidy, nalleles));
+    Rcpp::traits::input_parameter< double >::type error(errorSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(alleleFreqEMBatch(AD, nalleles, nsamples, ploidy, error, alpha, tol, maxit, nthreads));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _ploidyverseVcf_selfingMatrix(SEXP ploidySEXP, SEXP nallelesSEXP) {
+RcppExport SEXP _ploidyverseVcf_alleleFreqEMBatch(SEXP ADSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP nthreadsSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_ploidyverseVcf_selfingMatrix_try(ploidySEXP, nallelesSEXP));
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_alleleFreqEMBatch_try(ADSEXP, nallelesSEXP, nsamplesSEXP, ploidySEXP, errorSEXP, alphaSEXP, tolSEXP, maxitSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// alleleFreqEMMixed
+NumericVector alleleFreqEMMixed(IntegerVector AD, IntegerVector nalleles, std::vector<std::string> ploidy, double error, double alpha, double tol, int maxit, int nthreads);
+static SEXP _ploidyverseVcf_alleleFreqEMMixed_try(SEXP ADSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type AD(ADSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< double >::type error(errorSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(alleleFreqEMMixed(AD, nalleles, ploidy, error, alpha, tol, maxit, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_alleleFreqEMMixed(SEXP ADSEXP, SEXP nallelesSEXP, SEXP ploidySEXP, SEXP errorSEXP, SEXP alphaSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_alleleFreqEMMixed_try(ADSEXP, nallelesSEXP, ploidySEXP, errorSEXP, alphaSEXP, tolSEXP, maxitSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// lgammaCacheStats
+NumericVector lgammaCacheStats();
+static SEXP _ploidyverseVcf_lgammaCacheStats_try() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    rcpp_result_gen = Rcpp::wrap(lgammaCacheStats());
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_lgammaCacheStats() {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_lgammaCacheStats_try());
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// resetLgammaCache
+void resetLgammaCache();
+static SEXP _ploidyverseVcf_resetLgammaCache_try() {
+BEGIN_RCPP
+    resetLgammaCache();
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_resetLgammaCache() {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_resetLgammaCache_try());
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// logLikToPosterior
+NumericVector logLikToPosterior(NumericVector loglik, int ngen, Nullable<NumericVector> prior, bool logOutput, int nthreads);
+static SEXP _ploidyverseVcf_logLikToPosterior_try(SEXP loglikSEXP, SEXP ngenSEXP, SEXP priorSEXP, SEXP logOutputSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type loglik(loglikSEXP);
+    Rcpp::traits::input_parameter< int >::type ngen(ngenSEXP);
+    Rcpp::traits::input_parameter< Nullable<NumericVector> >::type prior(priorSEXP);
+    Rcpp::traits::input_parameter< bool >::type logOutput(logOutputSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(logLikToPosterior(loglik, ngen, prior, logOutput, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_logLikToPosterior(SEXP loglikSEXP, SEXP ngenSEXP, SEXP priorSEXP, SEXP logOutputSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_logLikToPosterior_try(loglikSEXP, ngenSEXP, priorSEXP, logOutputSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// dmultinom
+double dmultinom(NumericVector x, NumericVector prob);
+static SEXP _ploidyverseVcf_dmultinom_try(SEXP xSEXP, SEXP probSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type prob(probSEXP);
+    rcpp_result_gen = Rcpp::wrap(dmultinom(x, prob));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_dmultinom(SEXP xSEXP, SEXP probSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_dmultinom_try(xSEXP, probSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// dDirichletMultinom
+double dDirichletMultinom(NumericVector x, NumericVector prob, double alpha);
+static SEXP _ploidyverseVcf_dDirichletMultinom_try(SEXP xSEXP, SEXP probSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type prob(probSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(dDirichletMultinom(x, prob, alpha));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_dDirichletMultinom(SEXP xSEXP, SEXP probSEXP, SEXP alphaSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_dDirichletMultinom_try(xSEXP, probSEXP, alphaSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// dmultinomLog
+double dmultinomLog(NumericVector x, NumericVector prob);
+static SEXP _ploidyverseVcf_dmultinomLog_try(SEXP xSEXP, SEXP probSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type prob(probSEXP);
+    rcpp_result_gen = Rcpp::wrap(dmultinomLog(x, prob));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_dmultinomLog(SEXP xSEXP, SEXP probSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_dmultinomLog_try(xSEXP, probSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// dDirichletMultinomLog
+double dDirichletMultinomLog(NumericVector x, NumericVector prob, double alpha);
+static SEXP _ploidyverseVcf_dDirichletMultinomLog_try(SEXP xSEXP, SEXP probSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type prob(probSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(dDirichletMultinomLog(x, prob, alpha));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_dDirichletMultinomLog(SEXP xSEXP, SEXP probSEXP, SEXP alphaSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_dDirichletMultinomLog_try(xSEXP, probSEXP, alphaSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// nGen
+int nGen(int ploidy, int nalleles);
+static SEXP _ploidyverseVcf_nGen_try(SEXP ploidySEXP, SEXP nallelesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    rcpp_result_gen = Rcpp::wrap(nGen(ploidy, nalleles));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_nGen(SEXP ploidySEXP, SEXP nallelesSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_nGen_try(ploidySEXP, nallelesSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// enumerateGenotypes
+IntegerMatrix enumerateGenotypes(int ploidy, int nalleles);
+static SEXP _ploidyverseVcf_enumerateGenotypes_try(SEXP ploidySEXP, SEXP nallelesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    rcpp_result_gen = Rcpp::wrap(enumerateGenotypes(ploidy, nalleles));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_enumerateGenotypes(SEXP ploidySEXP, SEXP nallelesSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_enumerateGenotypes_try(ploidySEXP, nallelesSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// enumeratePloidyGenotypes
+IntegerMatrix enumeratePloidyGenotypes(std::string ploidy, int nalleles);
+static SEXP _ploidyverseVcf_enumeratePloidyGenotypes_try(SEXP ploidySEXP, SEXP nallelesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< std::string >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    rcpp_result_gen = Rcpp::wrap(enumeratePloidyGenotypes(ploidy, nalleles));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_enumeratePloidyGenotypes(SEXP ploidySEXP, SEXP nallelesSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_enumeratePloidyGenotypes_try(ploidySEXP, nallelesSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// indexGenotype
+int indexGenotype(IntegerVector genotype);
+static SEXP _ploidyverseVcf_indexGenotype_try(SEXP genotypeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type genotype(genotypeSEXP);
+    rcpp_result_gen = Rcpp::wrap(indexGenotype(genotype));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_indexGenotype(SEXP genotypeSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_indexGenotype_try(genotypeSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// genotypeFromIndex
+IntegerVector genotypeFromIndex(int index, int ploidy);
+static SEXP _ploidyverseVcf_genotypeFromIndex_try(SEXP indexSEXP, SEXP ploidySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< int >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    rcpp_result_gen = Rcpp::wrap(genotypeFromIndex(index, ploidy));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_genotypeFromIndex(SEXP indexSEXP, SEXP ploidySEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_genotypeFromIndex_try(indexSEXP, ploidySEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// indexGenotypes
+NumericVector indexGenotypes(IntegerMatrix genotypes, int nthreads);
+static SEXP _ploidyverseVcf_indexGenotypes_try(SEXP genotypesSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerMatrix >::type genotypes(genotypesSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(indexGenotypes(genotypes, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_indexGenotypes(SEXP genotypesSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_indexGenotypes_try(genotypesSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// genotypesFromIndex
+IntegerMatrix genotypesFromIndex(NumericVector index, int ploidy, int nthreads);
+static SEXP _ploidyverseVcf_genotypesFromIndex_try(SEXP indexSEXP, SEXP ploidySEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(genotypesFromIndex(index, ploidy, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_genotypesFromIndex(SEXP indexSEXP, SEXP ploidySEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_genotypesFromIndex_try(indexSEXP, ploidySEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// alleleCopy
+IntegerVector alleleCopy(IntegerVector genotype, int nalleles);
+static SEXP _ploidyverseVcf_alleleCopy_try(SEXP genotypeSEXP, SEXP nallelesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type genotype(genotypeSEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    rcpp_result_gen = Rcpp::wrap(alleleCopy(genotype, nalleles));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_alleleCopy(SEXP genotypeSEXP, SEXP nallelesSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_alleleCopy_try(genotypeSEXP, nallelesSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// makeGametes
+IntegerMatrix makeGametes(IntegerVector genotype);
+static SEXP _ploidyverseVcf_makeGametes_try(SEXP genotypeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type genotype(genotypeSEXP);
+    rcpp_result_gen = Rcpp::wrap(makeGametes(genotype));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_makeGametes(SEXP genotypeSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_makeGametes_try(genotypeSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// gameteDistribution
+List gameteDistribution(IntegerVector genotype);
+static SEXP _ploidyverseVcf_gameteDistribution_try(SEXP genotypeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type genotype(genotypeSEXP);
+    rcpp_result_gen = Rcpp::wrap(gameteDistribution(genotype));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_gameteDistribution(SEXP genotypeSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_gameteDistribution_try(genotypeSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// selfingMatrix
+NumericMatrix selfingMatrix(int ploidy, int nalleles);
+static SEXP _ploidyverseVcf_selfingMatrix_try(SEXP ploidySEXP, SEXP nallelesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    rcpp_result_gen = Rcpp::wrap(selfingMatrix(ploidy, nalleles));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_selfingMatrix(SEXP ploidySEXP, SEXP nallelesSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_selfingMatrix_try(ploidySEXP, nallelesSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// acnToGenoBatch
+SEXP acnToGenoBatch(NumericVector probarray, int ploidy, int nsamples, IntegerVector alleleCols, IntegerVector nalleles, int nthreads, bool quantize);
+static SEXP _ploidyverseVcf_acnToGenoBatch_try(SEXP probarraySEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP alleleColsSEXP, SEXP nallelesSEXP, SEXP nthreadsSEXP, SEXP quantizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type probarray(probarraySEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type alleleCols(alleleColsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quantize(quantizeSEXP);
+    rcpp_result_gen = Rcpp::wrap(acnToGenoBatch(probarray, ploidy, nsamples, alleleCols, nalleles, nthreads, quantize));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_acnToGenoBatch(SEXP probarraySEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP alleleColsSEXP, SEXP nallelesSEXP, SEXP nthreadsSEXP, SEXP quantizeSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_acnToGenoBatch_try(probarraySEXP, ploidySEXP, nsamplesSEXP, alleleColsSEXP, nallelesSEXP, nthreadsSEXP, quantizeSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// genoToAcnBatch
+NumericVector genoToAcnBatch(SEXP genoprobs, int ploidy, int nsamples, IntegerVector alleleCols, IntegerVector nalleles, int nAlleleCols, int nthreads);
+static SEXP _ploidyverseVcf_genoToAcnBatch_try(SEXP genoprobsSEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP alleleColsSEXP, SEXP nallelesSEXP, SEXP nAlleleColsSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< SEXP >::type genoprobs(genoprobsSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type alleleCols(alleleColsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nAlleleCols(nAlleleColsSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(genoToAcnBatch(genoprobs, ploidy, nsamples, alleleCols, nalleles, nAlleleCols, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_genoToAcnBatch(SEXP genoprobsSEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP alleleColsSEXP, SEXP nallelesSEXP, SEXP nAlleleColsSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_genoToAcnBatch_try(genoprobsSEXP, ploidySEXP, nsamplesSEXP, alleleColsSEXP, nallelesSEXP, nAlleleColsSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// genotypeCallsBatch
+List genotypeCallsBatch(SEXP genoprobs, int ploidy, int nsamples, IntegerVector nalleles, int nthreads);
+static SEXP _ploidyverseVcf_genotypeCallsBatch_try(SEXP genoprobsSEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP nallelesSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< SEXP >::type genoprobs(genoprobsSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(genotypeCallsBatch(genoprobs, ploidy, nsamples, nalleles, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_genotypeCallsBatch(SEXP genoprobsSEXP, SEXP ploidySEXP, SEXP nsamplesSEXP, SEXP nallelesSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_genotypeCallsBatch_try(genoprobsSEXP, ploidySEXP, nsamplesSEXP, nallelesSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// quantizeRaggedProbs
+RawVector quantizeRaggedProbs(NumericVector values, NumericVector offsets, int nthreads);
+static SEXP _ploidyverseVcf_quantizeRaggedProbs_try(SEXP valuesSEXP, SEXP offsetsSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type offsets(offsetsSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(quantizeRaggedProbs(values, offsets, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_quantizeRaggedProbs(SEXP valuesSEXP, SEXP offsetsSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_quantizeRaggedProbs_try(valuesSEXP, offsetsSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// dequantizeProbs
+NumericVector dequantizeProbs(RawVector values, int nthreads);
+static SEXP _ploidyverseVcf_dequantizeProbs_try(SEXP valuesSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< RawVector >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(dequantizeProbs(values, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_dequantizeProbs(SEXP valuesSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_dequantizeProbs_try(valuesSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// raggedFromMatrixList
+List raggedFromMatrixList(List mat, int nthreads);
+static SEXP _ploidyverseVcf_raggedFromMatrixList_try(SEXP matSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< List >::type mat(matSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(raggedFromMatrixList(mat, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_raggedFromMatrixList(SEXP matSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_raggedFromMatrixList_try(matSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// raggedToMatrixList
+List raggedToMatrixList(SEXP values, NumericVector offsets, int nrow, int ncol);
+static SEXP _ploidyverseVcf_raggedToMatrixList_try(SEXP valuesSEXP, SEXP offsetsSEXP, SEXP nrowSEXP, SEXP ncolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< SEXP >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type offsets(offsetsSEXP);
+    Rcpp::traits::input_parameter< int >::type nrow(nrowSEXP);
+    Rcpp::traits::input_parameter< int >::type ncol(ncolSEXP);
+    rcpp_result_gen = Rcpp::wrap(raggedToMatrixList(values, offsets, nrow, ncol));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_raggedToMatrixList(SEXP valuesSEXP, SEXP offsetsSEXP, SEXP nrowSEXP, SEXP ncolSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_raggedToMatrixList_try(valuesSEXP, offsetsSEXP, nrowSEXP, ncolSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// selfingMatrixCSR
+List selfingMatrixCSR(int ploidy, int nalleles, int generations, int nthreads);
+static SEXP _ploidyverseVcf_selfingMatrixCSR_try(SEXP ploidySEXP, SEXP nallelesSEXP, SEXP generationsSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type generations(generationsSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(selfingMatrixCSR(ploidy, nalleles, generations, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_selfingMatrixCSR(SEXP ploidySEXP, SEXP nallelesSEXP, SEXP generationsSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_selfingMatrixCSR_try(ploidySEXP, nallelesSEXP, generationsSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// applySelfing
+NumericVector applySelfing(NumericVector freq, int ploidy, int nalleles, int nthreads);
+static SEXP _ploidyverseVcf_applySelfing_try(SEXP freqSEXP, SEXP ploidySEXP, SEXP nallelesSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type freq(freqSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(applySelfing(freq, ploidy, nalleles, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_applySelfing(SEXP freqSEXP, SEXP ploidySEXP, SEXP nallelesSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_applySelfing_try(freqSEXP, ploidySEXP, nallelesSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// selfingGenerations
+NumericVector selfingGenerations(NumericVector freq, int ploidy, int nalleles, IntegerVector generations, int nthreads);
+static SEXP _ploidyverseVcf_selfingGenerations_try(SEXP freqSEXP, SEXP ploidySEXP, SEXP nallelesSEXP, SEXP generationsSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type freq(freqSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< int >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type generations(generationsSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(selfingGenerations(freq, ploidy, nalleles, generations, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_selfingGenerations(SEXP freqSEXP, SEXP ploidySEXP, SEXP nallelesSEXP, SEXP generationsSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_selfingGenerations_try(freqSEXP, ploidySEXP, nallelesSEXP, generationsSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfCacheBuild
+void vcfCacheBuild(std::string file, std::string cache, int ploidy, CharacterVector fields, bool quantizeGP, double tolerance, int nloci, int nthreads);
+static SEXP _ploidyverseVcf_vcfCacheBuild_try(SEXP fileSEXP, SEXP cacheSEXP, SEXP ploidySEXP, SEXP fieldsSEXP, SEXP quantizeGPSEXP, SEXP toleranceSEXP, SEXP nlociSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< std::string >::type cache(cacheSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< CharacterVector >::type fields(fieldsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quantizeGP(quantizeGPSEXP);
+    Rcpp::traits::input_parameter< double >::type tolerance(toleranceSEXP);
+    Rcpp::traits::input_parameter< int >::type nloci(nlociSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    vcfCacheBuild(file, cache, ploidy, fields, quantizeGP, tolerance, nloci, nthreads);
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfCacheBuild(SEXP fileSEXP, SEXP cacheSEXP, SEXP ploidySEXP, SEXP fieldsSEXP, SEXP quantizeGPSEXP, SEXP toleranceSEXP, SEXP nlociSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfCacheBuild_try(fileSEXP, cacheSEXP, ploidySEXP, fieldsSEXP, quantizeGPSEXP, toleranceSEXP, nlociSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfCacheOpen
+SEXP vcfCacheOpen(std::string cache);
+static SEXP _ploidyverseVcf_vcfCacheOpen_try(SEXP cacheSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< std::string >::type cache(cacheSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfCacheOpen(cache));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfCacheOpen(SEXP cacheSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfCacheOpen_try(cacheSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfCacheInfo
+List vcfCacheInfo(SEXP cache);
+static SEXP _ploidyverseVcf_vcfCacheInfo_try(SEXP cacheSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< SEXP >::type cache(cacheSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfCacheInfo(cache));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfCacheInfo(SEXP cacheSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfCacheInfo_try(cacheSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfCacheRead
+List vcfCacheRead(SEXP cache, NumericVector loci, IntegerVector samples, CharacterVector fields, int nthreads);
+static SEXP _ploidyverseVcf_vcfCacheRead_try(SEXP cacheSEXP, SEXP lociSEXP, SEXP samplesSEXP, SEXP fieldsSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< SEXP >::type cache(cacheSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type loci(lociSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type samples(samplesSEXP);
+    Rcpp::traits::input_parameter< CharacterVector >::type fields(fieldsSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfCacheRead(cache, loci, samples, fields, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfCacheRead(SEXP cacheSEXP, SEXP lociSEXP, SEXP samplesSEXP, SEXP fieldsSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfCacheRead_try(cacheSEXP, lociSEXP, samplesSEXP, fieldsSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfCacheClose
+void vcfCacheClose(SEXP cache);
+static SEXP _ploidyverseVcf_vcfCacheClose_try(SEXP cacheSEXP) {
+BEGIN_RCPP
+    Rcpp::traits::input_parameter< SEXP >::type cache(cacheSEXP);
+    vcfCacheClose(cache);
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfCacheClose(SEXP cacheSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfCacheClose_try(cacheSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfReaderOpen
+SEXP vcfReaderOpen(std::string file, int ploidy, CharacterVector fields, int nthreads);
+static SEXP _ploidyverseVcf_vcfReaderOpen_try(SEXP fileSEXP, SEXP ploidySEXP, SEXP fieldsSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< CharacterVector >::type fields(fieldsSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfReaderOpen(file, ploidy, fields, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfReaderOpen(SEXP fileSEXP, SEXP ploidySEXP, SEXP fieldsSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfReaderOpen_try(fileSEXP, ploidySEXP, fieldsSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfReaderSetRegion
+void vcfReaderSetRegion(SEXP reader, std::string index, std::string chrom, double start, double end);
+static SEXP _ploidyverseVcf_vcfReaderSetRegion_try(SEXP readerSEXP, SEXP indexSEXP, SEXP chromSEXP, SEXP startSEXP, SEXP endSEXP) {
+BEGIN_RCPP
+    Rcpp::traits::input_parameter< SEXP >::type reader(readerSEXP);
+    Rcpp::traits::input_parameter< std::string >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< std::string >::type chrom(chromSEXP);
+    Rcpp::traits::input_parameter< double >::type start(startSEXP);
+    Rcpp::traits::input_parameter< double >::type end(endSEXP);
+    vcfReaderSetRegion(reader, index, chrom, start, end);
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfReaderSetRegion(SEXP readerSEXP, SEXP indexSEXP, SEXP chromSEXP, SEXP startSEXP, SEXP endSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfReaderSetRegion_try(readerSEXP, indexSEXP, chromSEXP, startSEXP, endSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfReaderInfo
+List vcfReaderInfo(SEXP reader);
+static SEXP _ploidyverseVcf_vcfReaderInfo_try(SEXP readerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< SEXP >::type reader(readerSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfReaderInfo(reader));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfReaderInfo(SEXP readerSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfReaderInfo_try(readerSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfReadChunk
+List vcfReadChunk(SEXP reader, int nloci, bool quantizeGP);
+static SEXP _ploidyverseVcf_vcfReadChunk_try(SEXP readerSEXP, SEXP nlociSEXP, SEXP quantizeGPSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< SEXP >::type reader(readerSEXP);
+    Rcpp::traits::input_parameter< int >::type nloci(nlociSEXP);
+    Rcpp::traits::input_parameter< bool >::type quantizeGP(quantizeGPSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfReadChunk(reader, nloci, quantizeGP));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfReadChunk(SEXP readerSEXP, SEXP nlociSEXP, SEXP quantizeGPSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfReadChunk_try(readerSEXP, nlociSEXP, quantizeGPSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfReaderClose
+void vcfReaderClose(SEXP reader);
+static SEXP _ploidyverseVcf_vcfReaderClose_try(SEXP readerSEXP) {
+BEGIN_RCPP
+    Rcpp::traits::input_parameter< SEXP >::type reader(readerSEXP);
+    vcfReaderClose(reader);
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfReaderClose(SEXP readerSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfReaderClose_try(readerSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfValidateFile
+List vcfValidateFile(std::string file, int ploidy, double tolerance, int nloci, int nthreads);
+static SEXP _ploidyverseVcf_vcfValidateFile_try(SEXP fileSEXP, SEXP ploidySEXP, SEXP toleranceSEXP, SEXP nlociSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< double >::type tolerance(toleranceSEXP);
+    Rcpp::traits::input_parameter< int >::type nloci(nlociSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfValidateFile(file, ploidy, tolerance, nloci, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfValidateFile(SEXP fileSEXP, SEXP ploidySEXP, SEXP toleranceSEXP, SEXP nlociSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfValidateFile_try(fileSEXP, ploidySEXP, toleranceSEXP, nlociSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfWriterOpen
+SEXP vcfWriterOpen(std::string file, std::vector<std::string> header, bool bgzf, int level, int nthreads);
+static SEXP _ploidyverseVcf_vcfWriterOpen_try(SEXP fileSEXP, SEXP headerSEXP, SEXP bgzfSEXP, SEXP levelSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type header(headerSEXP);
+    Rcpp::traits::input_parameter< bool >::type bgzf(bgzfSEXP);
+    Rcpp::traits::input_parameter< int >::type level(levelSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(vcfWriterOpen(file, header, bgzf, level, nthreads));
+    return rcpp_result_gen;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfWriterOpen(SEXP fileSEXP, SEXP headerSEXP, SEXP bgzfSEXP, SEXP levelSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfWriterOpen_try(fileSEXP, headerSEXP, bgzfSEXP, levelSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfWriteChunk
+void vcfWriteChunk(SEXP writer, std::vector<std::string> chrom, IntegerVector pos, std::vector<std::string> id, std::vector<std::string> ref, std::vector<std::string> alt, IntegerVector nalleles, int nsamples, int ploidy, SEXP GT, SEXP phased, SEXP AD, SEXP GP, SEXP GN, SEXP PS, int digits, int nthreads);
+static SEXP _ploidyverseVcf_vcfWriteChunk_try(SEXP writerSEXP, SEXP chromSEXP, SEXP posSEXP, SEXP idSEXP, SEXP refSEXP, SEXP altSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP GTSEXP, SEXP phasedSEXP, SEXP ADSEXP, SEXP GPSEXP, SEXP GNSEXP, SEXP PSSEXP, SEXP digitsSEXP, SEXP nthreadsSEXP) {
+BEGIN_RCPP
+    Rcpp::traits::input_parameter< SEXP >::type writer(writerSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type chrom(chromSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type pos(posSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type id(idSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type ref(refSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> >::type alt(altSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type nalleles(nallelesSEXP);
+    Rcpp::traits::input_parameter< int >::type nsamples(nsamplesSEXP);
+    Rcpp::traits::input_parameter< int >::type ploidy(ploidySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type GT(GTSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type phased(phasedSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type AD(ADSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type GP(GPSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type GN(GNSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type PS(PSSEXP);
+    Rcpp::traits::input_parameter< int >::type digits(digitsSEXP);
+    Rcpp::traits::input_parameter< int >::type nthreads(nthreadsSEXP);
+    vcfWriteChunk(writer, chrom, pos, id, ref, alt, nalleles, nsamples, ploidy, GT, phased, AD, GP, GN, PS, digits, nthreads);
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfWriteChunk(SEXP writerSEXP, SEXP chromSEXP, SEXP posSEXP, SEXP idSEXP, SEXP refSEXP, SEXP altSEXP, SEXP nallelesSEXP, SEXP nsamplesSEXP, SEXP ploidySEXP, SEXP GTSEXP, SEXP phasedSEXP, SEXP ADSEXP, SEXP GPSEXP, SEXP GNSEXP, SEXP PSSEXP, SEXP digitsSEXP, SEXP nthreadsSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfWriteChunk_try(writerSEXP, chromSEXP, posSEXP, idSEXP, refSEXP, altSEXP, nallelesSEXP, nsamplesSEXP, ploidySEXP, GTSEXP, phasedSEXP, ADSEXP, GPSEXP, GNSEXP, PSSEXP, digitsSEXP, nthreadsSEXP));
+    }
+    Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
+    if (rcpp_isInterrupt_gen) {
+        UNPROTECT(1);
+        Rf_onintr();
+    }
+    bool rcpp_isLongjump_gen = Rcpp::internal::isLongjumpSentinel(rcpp_result_gen);
+    if (rcpp_isLongjump_gen) {
+        Rcpp::internal::resumeJump(rcpp_result_gen);
+    }
+    Rboolean rcpp_isError_gen = Rf_inherits(rcpp_result_gen, "try-error");
+    if (rcpp_isError_gen) {
+        SEXP rcpp_msgSEXP_gen = Rf_asChar(rcpp_result_gen);
+        UNPROTECT(1);
+        Rf_error(CHAR(rcpp_msgSEXP_gen));
+    }
+    UNPROTECT(1);
+    return rcpp_result_gen;
+}
+// vcfWriterClose
+void vcfWriterClose(SEXP writer);
+static SEXP _ploidyverseVcf_vcfWriterClose_try(SEXP writerSEXP) {
+BEGIN_RCPP
+    Rcpp::traits::input_parameter< SEXP >::type writer(writerSEXP);
+    vcfWriterClose(writer);
+    return R_NilValue;
+END_RCPP_RETURN_ERROR
+}
+RcppExport SEXP _ploidyverseVcf_vcfWriterClose(SEXP writerSEXP) {
+    SEXP rcpp_result_gen;
+    {
+        Rcpp::RNGScope rcpp_rngScope_gen;
+        rcpp_result_gen = PROTECT(_ploidyverseVcf_vcfWriterClose_try(writerSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -327,44 +2064,185 @@ RcppExport SEXP _ploidyverseVcf_selfingMatrix(SEXP ploidySEXP, SEXP nallelesSEXP
 static int _ploidyverseVcf_RcppExport_validate(const char* sig) { 
     static std::set<std::string> signatures;
     if (signatures.empty()) {
+        signatures.insert("NumericVector(*crossProgeny)(IntegerVector,IntegerVector,int)");
+        signatures.insert("NumericVector(*crossProgenyFreq)(NumericVector,NumericVector,int,int,int)");
+        signatures.insert("NumericVector(*crossProgenyBatch)(IntegerVector,IntegerVector,IntegerVector,int,int,int)");
+        signatures.insert("bool(*instrumentKernels)(bool)");
+        signatures.insert("List(*kernelStats)()");
+        signatures.insert("void(*resetKernelStats)()");
+        signatures.insert("NumericVector(*batchGenotypeLikelihoods)(IntegerVector,IntegerVector,int,int,double,double,int)");
+        signatures.insert("NumericVector(*batchGenotypeLikelihoodsMixed)(IntegerVector,IntegerVector,std::vector<std::string>,double,double,int)");
+        signatures.insert("NumericVector(*fitOverdispersionBatch)(IntegerVector,NumericVector,IntegerVector,int,int,double,bool,double,double,int)");
+        signatures.insert("NumericVector(*fitOverdispersionMixed)(IntegerVector,NumericVector,IntegerVector,std::vector<std::string>,double,bool,double,double,int)");
+        signatures.insert("NumericVector(*hwePriorsBatch)(NumericVector,IntegerVector,int,int,bool,int)");
+        signatures.insert("NumericVector(*hwePriorsMixed)(NumericVector,IntegerVector,std::vector<std::string>,bool,int)");
+        signatures.insert("NumericVector(*alleleFreqEMBatch)(IntegerVector,IntegerVector,int,int,double,double,double,int,int)");
+        signatures.insert("NumericVector(*alleleFreqEMMixed)(IntegerVector,IntegerVector,std::vector<std::string>,double,double,double,int,int)");
+        signatures.insert("NumericVector(*lgammaCacheStats)()");
+        signatures.insert("void(*resetLgammaCache)()");
+        signatures.insert("NumericVector(*logLikToPosterior)(NumericVector,int,Nullable<NumericVector>,bool,int)");
         signatures.insert("double(*dmultinom)(NumericVector,NumericVector)");
         signatures.insert("double(*dDirichletMultinom)(NumericVector,NumericVector,double)");
+        signatures.insert("double(*dmultinomLog)(NumericVector,NumericVector)");
+        signatures.insert("double(*dDirichletMultinomLog)(NumericVector,NumericVector,double)");
         signatures.insert("int(*nGen)(int,int)");
         signatures.insert("IntegerMatrix(*enumerateGenotypes)(int,int)");
+        signatures.insert("IntegerMatrix(*enumeratePloidyGenotypes)(std::string,int)");
         signatures.insert("int(*indexGenotype)(IntegerVector)");
         signatures.insert("IntegerVector(*genotypeFromIndex)(int,int)");
+        signatures.insert("NumericVector(*indexGenotypes)(IntegerMatrix,int)");
+        signatures.insert("IntegerMatrix(*genotypesFromIndex)(NumericVector,int,int)");
         signatures.insert("IntegerVector(*alleleCopy)(IntegerVector,int)");
         signatures.insert("IntegerMatrix(*makeGametes)(IntegerVector)");
+        signatures.insert("List(*gameteDistribution)(IntegerVector)");
         signatures.insert("NumericMatrix(*selfingMatrix)(int,int)");
+        signatures.insert("SEXP(*acnToGenoBatch)(NumericVector,int,int,IntegerVector,IntegerVector,int,bool)");
+        signatures.insert("NumericVector(*genoToAcnBatch)(SEXP,int,int,IntegerVector,IntegerVector,int,int)");
+        signatures.insert("List(*genotypeCallsBatch)(SEXP,int,int,IntegerVector,int)");
+        signatures.insert("RawVector(*quantizeRaggedProbs)(NumericVector,NumericVector,int)");
+        signatures.insert("NumericVector(*dequantizeProbs)(RawVector,int)");
+        signatures.insert("List(*raggedFromMatrixList)(List,int)");
+        signatures.insert("List(*raggedToMatrixList)(SEXP,NumericVector,int,int)");
+        signatures.insert("List(*selfingMatrixCSR)(int,int,int,int)");
+        signatures.insert("NumericVector(*applySelfing)(NumericVector,int,int,int)");
+        signatures.insert("NumericVector(*selfingGenerations)(NumericVector,int,int,IntegerVector,int)");
+        signatures.insert("void(*vcfCacheBuild)(std::string,std::string,int,CharacterVector,bool,double,int,int)");
+        signatures.insert("SEXP(*vcfCacheOpen)(std::string)");
+        signatures.insert("List(*vcfCacheInfo)(SEXP)");
+        signatures.insert("List(*vcfCacheRead)(SEXP,NumericVector,IntegerVector,CharacterVector,int)");
+        signatures.insert("void(*vcfCacheClose)(SEXP)");
+        signatures.insert("SEXP(*vcfReaderOpen)(std::string,int,CharacterVector,int)");
+        signatures.insert("void(*vcfReaderSetRegion)(SEXP,std::string,std::string,double,double)");
+        signatures.insert("List(*vcfReaderInfo)(SEXP)");
+        signatures.insert("List(*vcfReadChunk)(SEXP,int,bool)");
+        signatures.insert("void(*vcfReaderClose)(SEXP)");
+        signatures.insert("List(*vcfValidateFile)(std::string,int,double,int,int)");
+        signatures.insert("SEXP(*vcfWriterOpen)(std::string,std::vector<std::string>,bool,int,int)");
+        signatures.insert("void(*vcfWriteChunk)(SEXP,std::vector<std::string>,IntegerVector,std::vector<std::string>,std::vector<std::string>,std::vector<std::string>,IntegerVector,int,int,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,int,int)");
+        signatures.insert("void(*vcfWriterClose)(SEXP)");
     }
     return signatures.find(sig) != signatures.end();
 }
 
 // registerCCallable (register entry points for exported C++ functions)
 RcppExport SEXP _ploidyverseVcf_RcppExport_registerCCallable() { 
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_crossProgeny", (DL_FUNC)_ploidyverseVcf_crossProgeny_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_crossProgenyFreq", (DL_FUNC)_ploidyverseVcf_crossProgenyFreq_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_crossProgenyBatch", (DL_FUNC)_ploidyverseVcf_crossProgenyBatch_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_instrumentKernels", (DL_FUNC)_ploidyverseVcf_instrumentKernels_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_kernelStats", (DL_FUNC)_ploidyverseVcf_kernelStats_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_resetKernelStats", (DL_FUNC)_ploidyverseVcf_resetKernelStats_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_batchGenotypeLikelihoods", (DL_FUNC)_ploidyverseVcf_batchGenotypeLikelihoods_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_batchGenotypeLikelihoodsMixed", (DL_FUNC)_ploidyverseVcf_batchGenotypeLikelihoodsMixed_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_fitOverdispersionBatch", (DL_FUNC)_ploidyverseVcf_fitOverdispersionBatch_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_fitOverdispersionMixed", (DL_FUNC)_ploidyverseVcf_fitOverdispersionMixed_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_hwePriorsBatch", (DL_FUNC)_ploidyverseVcf_hwePriorsBatch_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_hwePriorsMixed", (DL_FUNC)_ploidyverseVcf_hwePriorsMixed_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_alleleFreqEMBatch", (DL_FUNC)_ploidyverseVcf_alleleFreqEMBatch_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_alleleFreqEMMixed", (DL_FUNC)_ploidyverseVcf_alleleFreqEMMixed_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_lgammaCacheStats", (DL_FUNC)_ploidyverseVcf_lgammaCacheStats_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_resetLgammaCache", (DL_FUNC)_ploidyverseVcf_resetLgammaCache_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_logLikToPosterior", (DL_FUNC)_ploidyverseVcf_logLikToPosterior_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_dmultinom", (DL_FUNC)_ploidyverseVcf_dmultinom_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_dDirichletMultinom", (DL_FUNC)_ploidyverseVcf_dDirichletMultinom_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_dmultinomLog", (DL_FUNC)_ploidyverseVcf_dmultinomLog_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_dDirichletMultinomLog", (DL_FUNC)_ploidyverseVcf_dDirichletMultinomLog_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_nGen", (DL_FUNC)_ploidyverseVcf_nGen_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_enumerateGenotypes", (DL_FUNC)_ploidyverseVcf_enumerateGenotypes_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_enumeratePloidyGenotypes", (DL_FUNC)_ploidyverseVcf_enumeratePloidyGenotypes_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_indexGenotype", (DL_FUNC)_ploidyverseVcf_indexGenotype_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_genotypeFromIndex", (DL_FUNC)_ploidyverseVcf_genotypeFromIndex_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_indexGenotypes", (DL_FUNC)_ploidyverseVcf_indexGenotypes_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_genotypesFromIndex", (DL_FUNC)_ploidyverseVcf_genotypesFromIndex_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_alleleCopy", (DL_FUNC)_ploidyverseVcf_alleleCopy_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_makeGametes", (DL_FUNC)_ploidyverseVcf_makeGametes_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_gameteDistribution", (DL_FUNC)_ploidyverseVcf_gameteDistribution_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_selfingMatrix", (DL_FUNC)_ploidyverseVcf_selfingMatrix_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_acnToGenoBatch", (DL_FUNC)_ploidyverseVcf_acnToGenoBatch_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_genoToAcnBatch", (DL_FUNC)_ploidyverseVcf_genoToAcnBatch_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_genotypeCallsBatch", (DL_FUNC)_ploidyverseVcf_genotypeCallsBatch_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_quantizeRaggedProbs", (DL_FUNC)_ploidyverseVcf_quantizeRaggedProbs_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_dequantizeProbs", (DL_FUNC)_ploidyverseVcf_dequantizeProbs_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_raggedFromMatrixList", (DL_FUNC)_ploidyverseVcf_raggedFromMatrixList_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_raggedToMatrixList", (DL_FUNC)_ploidyverseVcf_raggedToMatrixList_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_selfingMatrixCSR", (DL_FUNC)_ploidyverseVcf_selfingMatrixCSR_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_applySelfing", (DL_FUNC)_ploidyverseVcf_applySelfing_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_selfingGenerations", (DL_FUNC)_ploidyverseVcf_selfingGenerations_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheBuild", (DL_FUNC)_ploidyverseVcf_vcfCacheBuild_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheOpen", (DL_FUNC)_ploidyverseVcf_vcfCacheOpen_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheInfo", (DL_FUNC)_ploidyverseVcf_vcfCacheInfo_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheRead", (DL_FUNC)_ploidyverseVcf_vcfCacheRead_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfCacheClose", (DL_FUNC)_ploidyverseVcf_vcfCacheClose_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderOpen", (DL_FUNC)_ploidyverseVcf_vcfReaderOpen_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderSetRegion", (DL_FUNC)_ploidyverseVcf_vcfReaderSetRegion_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderInfo", (DL_FUNC)_ploidyverseVcf_vcfReaderInfo_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReadChunk", (DL_FUNC)_ploidyverseVcf_vcfReadChunk_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfReaderClose", (DL_FUNC)_ploidyverseVcf_vcfReaderClose_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfValidateFile", (DL_FUNC)_ploidyverseVcf_vcfValidateFile_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfWriterOpen", (DL_FUNC)_ploidyverseVcf_vcfWriterOpen_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfWriteChunk", (DL_FUNC)_ploidyverseVcf_vcfWriteChunk_try);
+    R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_vcfWriterClose", (DL_FUNC)_ploidyverseVcf_vcfWriterClose_try);
     R_RegisterCCallable("ploidyverseVcf", "_ploidyverseVcf_RcppExport_validate", (DL_FUNC)_ploidyverseVcf_RcppExport_validate);
     return R_NilValue;
 }
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_ploidyverseVcf_crossProgeny", (DL_FUNC) &_ploidyverseVcf_crossProgeny, 3},
+    {"_ploidyverseVcf_crossProgenyFreq", (DL_FUNC) &_ploidyverseVcf_crossProgenyFreq, 5},
+    {"_ploidyverseVcf_crossProgenyBatch", (DL_FUNC) &_ploidyverseVcf_crossProgenyBatch, 6},
+    {"_ploidyverseVcf_instrumentKernels", (DL_FUNC) &_ploidyverseVcf_instrumentKernels, 1},
+    {"_ploidyverseVcf_kernelStats", (DL_FUNC) &_ploidyverseVcf_kernelStats, 0},
+    {"_ploidyverseVcf_resetKernelStats", (DL_FUNC) &_ploidyverseVcf_resetKernelStats, 0},
+    {"_ploidyverseVcf_batchGenotypeLikelihoods", (DL_FUNC) &_ploidyverseVcf_batchGenotypeLikelihoods, 7},
+    {"_ploidyverseVcf_batchGenotypeLikelihoodsMixed", (DL_FUNC) &_ploidyverseVcf_batchGenotypeLikelihoodsMixed, 6},
+    {"_ploidyverseVcf_fitOverdispersionBatch", (DL_FUNC) &_ploidyverseVcf_fitOverdispersionBatch, 10},
+    {"_ploidyverseVcf_fitOverdispersionMixed", (DL_FUNC) &_ploidyverseVcf_fitOverdispersionMixed, 9},
+    {"_ploidyverseVcf_hwePriorsBatch", (DL_FUNC) &_ploidyverseVcf_hwePriorsBatch, 6},
+    {"_ploidyverseVcf_hwePriorsMixed", (DL_FUNC) &_ploidyverseVcf_hwePriorsMixed, 5},
+    {"_ploidyverseVcf_alleleFreqEMBatch", (DL_FUNC) &_ploidyverseVcf_alleleFreqEMBatch, 9},
+    {"_ploidyverseVcf_alleleFreqEMMixed", (DL_FUNC) &_ploidyverseVcf_alleleFreqEMMixed, 8},
+    {"_ploidyverseVcf_lgammaCacheStats", (DL_FUNC) &_ploidyverseVcf_lgammaCacheStats, 0},
+    {"_ploidyverseVcf_resetLgammaCache", (DL_FUNC) &_ploidyverseVcf_resetLgammaCache, 0},
+    {"_ploidyverseVcf_logLikToPosterior", (DL_FUNC) &_ploidyverseVcf_logLikToPosterior, 5},
     {"_ploidyverseVcf_dmultinom", (DL_FUNC) &_ploidyverseVcf_dmultinom, 2},
     {"_ploidyverseVcf_dDirichletMultinom", (DL_FUNC) &_ploidyverseVcf_dDirichletMultinom, 3},
+    {"_ploidyverseVcf_dmultinomLog", (DL_FUNC) &_ploidyverseVcf_dmultinomLog, 2},
+    {"_ploidyverseVcf_dDirichletMultinomLog", (DL_FUNC) &_ploidyverseVcf_dDirichletMultinomLog, 3},
     {"_ploidyverseVcf_nGen", (DL_FUNC) &_ploidyverseVcf_nGen, 2},
     {"_ploidyverseVcf_enumerateGenotypes", (DL_FUNC) &_ploidyverseVcf_enumerateGenotypes, 2},
+    {"_ploidyverseVcf_enumeratePloidyGenotypes", (DL_FUNC) &_ploidyverseVcf_enumeratePloidyGenotypes, 2},
     {"_ploidyverseVcf_indexGenotype", (DL_FUNC) &_ploidyverseVcf_indexGenotype, 1},
     {"_ploidyverseVcf_genotypeFromIndex", (DL_FUNC) &_ploidyverseVcf_genotypeFromIndex, 2},
+    {"_ploidyverseVcf_indexGenotypes", (DL_FUNC) &_ploidyverseVcf_indexGenotypes, 2},
+    {"_ploidyverseVcf_genotypesFromIndex", (DL_FUNC) &_ploidyverseVcf_genotypesFromIndex, 3},
     {"_ploidyverseVcf_alleleCopy", (DL_FUNC) &_ploidyverseVcf_alleleCopy, 2},
     {"_ploidyverseVcf_makeGametes", (DL_FUNC) &_ploidyverseVcf_makeGametes, 1},
+    {"_ploidyverseVcf_gameteDistribution", (DL_FUNC) &_ploidyverseVcf_gameteDistribution, 1},
     {"_ploidyverseVcf_selfingMatrix", (DL_FUNC) &_ploidyverseVcf_selfingMatrix, 2},
+    {"_ploidyverseVcf_acnToGenoBatch", (DL_FUNC) &_ploidyverseVcf_acnToGenoBatch, 7},
+    {"_ploidyverseVcf_genoToAcnBatch", (DL_FUNC) &_ploidyverseVcf_genoToAcnBatch, 7},
+    {"_ploidyverseVcf_genotypeCallsBatch", (DL_FUNC) &_ploidyverseVcf_genotypeCallsBatch, 5},
+    {"_ploidyverseVcf_quantizeRaggedProbs", (DL_FUNC) &_ploidyverseVcf_quantizeRaggedProbs, 3},
+    {"_ploidyverseVcf_dequantizeProbs", (DL_FUNC) &_ploidyverseVcf_dequantizeProbs, 2},
+    {"_ploidyverseVcf_raggedFromMatrixList", (DL_FUNC) &_ploidyverseVcf_raggedFromMatrixList, 2},
+    {"_ploidyverseVcf_raggedToMatrixList", (DL_FUNC) &_ploidyverseVcf_raggedToMatrixList, 4},
+    {"_ploidyverseVcf_selfingMatrixCSR", (DL_FUNC) &_ploidyverseVcf_selfingMatrixCSR, 4},
+    {"_ploidyverseVcf_applySelfing", (DL_FUNC) &_ploidyverseVcf_applySelfing, 4},
+    {"_ploidyverseVcf_selfingGenerations", (DL_FUNC) &_ploidyverseVcf_selfingGenerations, 5},
+    {"_ploidyverseVcf_vcfCacheBuild", (DL_FUNC) &_ploidyverseVcf_vcfCacheBuild, 8},
+    {"_ploidyverseVcf_vcfCacheOpen", (DL_FUNC) &_ploidyverseVcf_vcfCacheOpen, 1},
+    {"_ploidyverseVcf_vcfCacheInfo", (DL_FUNC) &_ploidyverseVcf_vcfCacheInfo, 1},
+    {"_ploidyverseVcf_vcfCacheRead", (DL_FUNC) &_ploidyverseVcf_vcfCacheRead, 5},
+    {"_ploidyverseVcf_vcfCacheClose", (DL_FUNC) &_ploidyverseVcf_vcfCacheClose, 1},
+    {"_ploidyverseVcf_vcfReaderOpen", (DL_FUNC) &_ploidyverseVcf_vcfReaderOpen, 4},
+    {"_ploidyverseVcf_vcfReaderSetRegion", (DL_FUNC) &_ploidyverseVcf_vcfReaderSetRegion, 5},
+    {"_ploidyverseVcf_vcfReaderInfo", (DL_FUNC) &_ploidyverseVcf_vcfReaderInfo, 1},
+    {"_ploidyverseVcf_vcfReadChunk", (DL_FUNC) &_ploidyverseVcf_vcfReadChunk, 3},
+    {"_ploidyverseVcf_vcfReaderClose", (DL_FUNC) &_ploidyverseVcf_vcfReaderClose, 1},
+    {"_ploidyverseVcf_vcfValidateFile", (DL_FUNC) &_ploidyverseVcf_vcfValidateFile, 5},
+    {"_ploidyverseVcf_vcfWriterOpen", (DL_FUNC) &_ploidyverseVcf_vcfWriterOpen, 5},
+    {"_ploidyverseVcf_vcfWriteChunk", (DL_FUNC) &_ploidyverseVcf_vcfWriteChunk, 17},
+    {"_ploidyverseVcf_vcfWriterClose", (DL_FUNC) &_ploidyverseVcf_vcfWriterClose, 1},
     {"_ploidyverseVcf_RcppExport_registerCCallable", (DL_FUNC) &_ploidyverseVcf_RcppExport_registerCCallable, 0},
     {NULL, NULL, 0}
 };
@@ -0,0 +1,278 @@
+#ifndef PLOIDYVERSE_BGZF_H
+#define PLOIDYVERSE_BGZF_H
+
+// BGZF (blocked gzip), as written by bgzip and indexed by tabix.  A BGZF file
+// is a series of gzip members, each holding at most 64 KiB of data and
+// recording its own compressed size, so blocks can be found without
+// decompressing them and then compressed or decompressed independently, in
+// parallel.  A position in the decompressed data is given by a virtual
+// offset: the file offset of a block shifted left 16 bits, plus the offset
+// within the block.
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ploidyverse/threads.h"
+
+namespace ploidyverse {
+
+// Compress data as one BGZF block, appending it to out.  len must be at most
+// bgzfBlockData.
+static const std::size_t bgzfBlockData = 0xff00;
+
+inline void bgzfCompressBlock(const char* data, std::size_t len, int level,
+                              std::string& out){
+  unsigned char block[0x10000];
+  z_stream zs;
+  zs.zalloc = Z_NULL;
+  zs.zfree = Z_NULL;
+  zs.opaque = Z_NULL;
+  if(deflateInit2(&zs, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK){
+    throw std::runtime_error("Unable to initialize compression.");
+  }
+  zs.next_in = (Bytef*)data;
+  zs.avail_in = len;
+  zs.next_out = block + 18;
+  zs.avail_out = sizeof(block) - 18 - 8;
+  int ret = deflate(&zs, Z_FINISH);
+  std::size_t clen = zs.total_out;
+  deflateEnd(&zs);
+  if(ret != Z_STREAM_END) throw std::runtime_error("BGZF block too large.");
+
+  const std::size_t bsize = clen + 18 + 8;
+  static const unsigned char head[16] = {0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff,
+                                         6, 0, 'B', 'C', 2, 0};
+  for(int i = 0; i < 16; i++) block[i] = head[i];
+  block[16] = (bsize - 1) & 0xff;
+  block[17] = ((bsize - 1) >> 8) & 0xff;
+  unsigned long crc = crc32(crc32(0L, Z_NULL, 0), (const Bytef*)data, len);
+  unsigned char* tail = block + 18 + clen;
+  for(int i = 0; i < 4; i++) tail[i] = (crc >> (8 * i)) & 0xff;
+  for(int i = 0; i < 4; i++) tail[4 + i] = (len >> (8 * i)) & 0xff;
+  out.append((const char*)block, bsize);
+}
+
+inline std::uint32_t bgzfLittleEndian(const unsigned char* p, int bytes){
+  std::uint32_t x = 0;
+  for(int i = bytes - 1; i >= 0; i--) x = (x << 8) | p[i];
+  return x;
+}
+
+// Total size of the BGZF block whose first 18 bytes are at head, or 0 if they
+// are not the start of a BGZF block.
+inline std::size_t bgzfBlockSize(const unsigned char* head){
+  if(head[0] != 0x1f || head[1] != 0x8b || head[2] != 8 || !(head[3] & 4)) return 0;
+  if(bgzfLittleEndian(head + 10, 2) < 6 || head[12] != 'B' || head[13] != 'C' ||
+     bgzfLittleEndian(head + 14, 2) != 2) return 0;
+  return bgzfLittleEndian(head + 16, 2) + 1;
+}
+
+// Decompress one complete BGZF block into out, checking its length and CRC.
+// zs must have been initialized by inflateInit2 for raw deflate.  Returns
+// false if the block is damaged.
+inline bool bgzfDecompressBlock(const unsigned char* block, std::size_t bsize,
+                                z_stream& zs, std::string& out){
+  const std::size_t start = 12 + bgzfLittleEndian(block + 10, 2);
+  if(bsize < start + 8) return false;
+  const std::uint32_t crc = bgzfLittleEndian(block + bsize - 8, 4);
+  const std::uint32_t isize = bgzfLittleEndian(block + bsize - 4, 4);
+  if(isize > 0x10000) return false;
+  out.resize(isize);
+  if(inflateReset(&zs) != Z_OK) return false;
+  Bytef empty;
+  zs.next_in = (Bytef*)(block + start);
+  zs.avail_in = bsize - start - 8;
+  zs.next_out = isize > 0 ? (Bytef*)&out[0] : &empty;
+  zs.avail_out = isize;
+  int ret = inflate(&zs, Z_FINISH);
+  if(ret != Z_STREAM_END || zs.total_out != isize) return false;
+  return crc32(crc32(0L, Z_NULL, 0), (const Bytef*)out.data(), isize) == crc;
+}
+
+inline bool bgzfSeekFile(std::FILE* fp, std::uint64_t offset){
+#ifdef _WIN32
+  return _fseeki64(fp, (__int64)offset, SEEK_SET) == 0;
+#else
+  return fseeko(fp, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+// Reads the lines of a BGZF file.  Blocks are read a batch at a time and
+// decompressed in parallel, with a batch of four blocks per thread.
+class BgzfReader {
+public:
+  BgzfReader(const std::string& file, int nthreads)
+    : nthreads_(threadCount(nthreads)), fileOffset_(0), nloaded_(0),
+      current_(0), pos_(0), eof_(false) {
+    batch_ = 4 * nthreads_;
+    fp_ = std::fopen(file.c_str(), "rb");
+    if(fp_ == NULL) throw std::runtime_error("Unable to open " + file);
+    std::setvbuf(fp_, NULL, _IOFBF, 1 << 20);
+    coffset_.assign(1, 0);
+  }
+
+  ~BgzfReader(){
+    std::fclose(fp_);
+  }
+
+  // Whether a file starts with a BGZF block.
+  static bool isBgzf(const std::string& file){
+    std::FILE* fp = std::fopen(file.c_str(), "rb");
+    if(fp == NULL) return false;
+    unsigned char head[18];
+    bool out = std::fread(head, 1, 18, fp) == 18 && bgzfBlockSize(head) > 0;
+    std::fclose(fp);
+    return out;
+  }
+
+  // Read one line, without the newline, returning false at the end of the
+  // file.
+  bool getLine(std::string& line){
+    line.clear();
+    bool any = false;
+    for(;;){
+      if(current_ >= nloaded_ && !fill()) break;
+      const std::string& d = data_[current_];
+      const char* start = d.data() + pos_;
+      const char* nl = static_cast<const char*>(std::memchr(start, '\n', d.size() - pos_));
+      if(nl != NULL){
+        line.append(start, nl - start);
+        pos_ = nl - d.data() + 1;
+        any = true;
+        if(pos_ == d.size()){
+          current_++;
+          pos_ = 0;
+        }
+        break;
+      }
+      if(d.size() > pos_) any = true;
+      line.append(start, d.size() - pos_);
+      current_++;
+      pos_ = 0;
+    }
+    if(!line.empty() && line[line.size() - 1] == '\r') line.resize(line.size() - 1);
+    return any;
+  }
+
+  // Virtual offset of the next line.
+  std::uint64_t tell() const {
+    return (coffset_[current_] << 16) | pos_;
+  }
+
+  void seek(std::uint64_t voffset){
+    const std::uint64_t coff = voffset >> 16;
+    const std::size_t uoff = voffset & 0xffff;
+    std::vector<std::uint64_t>::const_iterator it =
+      std::lower_bound(coffset_.begin(), coffset_.begin() + nloaded_, coff);
+    if(it != coffset_.begin() + nloaded_ && *it == coff){
+      current_ = it - coffset_.begin();
+    } else {
+      if(!bgzfSeekFile(fp_, coff)) throw std::runtime_error("Unable to seek in BGZF file.");
+      fileOffset_ = coff;
+      coffset_.assign(1, coff);
+      nloaded_ = 0;
+      current_ = 0;
+      eof_ = false;
+      if(!fill()){
+        if(uoff > 0) throw damaged();
+        return;
+      }
+    }
+    if(uoff > data_[current_].size()) throw damaged();
+    pos_ = uoff;
+    if(pos_ == data_[current_].size()){
+      current_++;
+      pos_ = 0;
+    }
+  }
+
+private:
+  BgzfReader(const BgzfReader&);
+  BgzfReader& operator=(const BgzfReader&);
+
+  static std::runtime_error damaged(){
+    return std::runtime_error("BGZF file is damaged or truncated.");
+  }
+
+  // Read and decompress the next batch of blocks, replacing the current
+  // batch.  Returns false at the end of the file.
+  bool fill(){
+    if(eof_) return false;
+    if(raw_.size() < batch_){
+      raw_.resize(batch_);
+      data_.resize(batch_);
+    }
+    coffset_.assign(1, fileOffset_);
+    std::size_t n = 0;
+    while(n < batch_){
+      unsigned char head[18];
+      std::size_t got = std::fread(head, 1, 18, fp_);
+      if(got == 0){
+        eof_ = true;
+        break;
+      }
+      std::size_t bsize = got == 18 ? bgzfBlockSize(head) : 0;
+      if(bsize < 18 + 8) throw damaged();
+      raw_[n].resize(bsize);
+      std::memcpy(&raw_[n][0], head, 18);
+      if(std::fread(&raw_[n][18], 1, bsize - 18, fp_) != bsize - 18) throw damaged();
+      fileOffset_ += bsize;
+      coffset_.push_back(fileOffset_);
+      n++;
+    }
+
+    const long long nn = n;
+    int failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads_) if(n > 1)
+#endif
+    {
+      z_stream zs;
+      zs.zalloc = Z_NULL;
+      zs.zfree = Z_NULL;
+      zs.opaque = Z_NULL;
+      zs.next_in = Z_NULL;
+      zs.avail_in = 0;
+      bool ok = inflateInit2(&zs, -15) == Z_OK;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(long long i = 0; i < nn; i++){
+        if(!ok || !bgzfDecompressBlock(&raw_[i][0], raw_[i].size(), zs, data_[i])){
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+          failed = 1;
+        }
+      }
+      if(ok) inflateEnd(&zs);
+    }
+    if(failed) throw damaged();
+    nloaded_ = n;
+    current_ = 0;
+    pos_ = 0;
+    return n > 0;
+  }
+
+  std::FILE* fp_;
+  int nthreads_;
+  std::size_t batch_;
+  std::uint64_t fileOffset_;                // of the next block to read
+  std::vector<std::vector<unsigned char> > raw_;
+  std::vector<std::string> data_;
+  std::vector<std::uint64_t> coffset_;      // of each loaded block, then the next
+  std::size_t nloaded_;
+  std::size_t current_;                     // block holding the next line
+  std::size_t pos_;                         // within that block
+  bool eof_;
+};
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_BGZF_H
@@ -0,0 +1,122 @@
+#include <Rcpp.h>
+#include <cmath>
+#include "ploidyverse/cross_kernels.h"
+#include "ploidyverse/instrumentation.h"
+using namespace Rcpp;
+
+// Progeny genotype distributions from crosses between two parents.
+
+static void checkCrossArgs(int motherPloidy, int fatherPloidy, int nalleles){
+  if(motherPloidy < 2 || motherPloidy % 2 != 0 ||
+     fatherPloidy < 2 || fatherPloidy % 2 != 0){
+    stop("Parent ploidies must be positive even numbers.");
+  }
+  if(nalleles < 1) stop("Number of alleles must be at least 1.");
+  int ploidy = std::max(std::max(motherPloidy, fatherPloidy),
+                        motherPloidy / 2 + fatherPloidy / 2);
+  if(!ploidyverse::canRankGenotypes(ploidy, nalleles - 1) ||
+     ploidyverse::countGenotypes(ploidy, nalleles) > INT_MAX){
+    stop("Too many genotypes for these ploidies and number of alleles.");
+  }
+}
+
+// Progeny genotype probabilities in VCF order from crossing two parent
+// genotypes, each an integer vector of alleles as in indexGenotype.  The
+// ploidy of each parent is the length of its genotype.
+// [[Rcpp::export]]
+NumericVector crossProgeny(IntegerVector mother, IntegerVector father,
+                           int nalleles){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_CROSS_PROGENY,
+                                 mother.size() / 2 + father.size() / 2, nalleles);
+  int pm = mother.size();
+  int pf = father.size();
+  checkCrossArgs(pm, pf, nalleles);
+  std::vector<int> gm(mother.begin(), mother.end());
+  std::vector<int> gf(father.begin(), father.end());
+  for(int i = 0; i < pm; i++){
+    if(gm[i] == NA_INTEGER || gm[i] < 0 || gm[i] >= nalleles){
+      stop("Alleles must be between 0 and nalleles - 1.");
+    }
+  }
+  for(int i = 0; i < pf; i++){
+    if(gf[i] == NA_INTEGER || gf[i] < 0 || gf[i] >= nalleles){
+      stop("Alleles must be between 0 and nalleles - 1.");
+    }
+  }
+  std::sort(gm.begin(), gm.end());
+  std::sort(gf.begin(), gf.end());
+
+  NumericVector out(no_init(ploidyverse::countGenotypes(pm / 2 + pf / 2, nalleles)));
+  timer.addBytes((double)out.size() * sizeof(double));
+  ploidyverse::crossGenotypesInto(gm.data(), pm, gf.data(), pf, nalleles,
+                                  out.begin());
+  return out;
+}
+
+// Progeny genotype probabilities in VCF order from crossing two parents whose
+// genotypes are given as probability distributions in VCF order.  Useful for
+// backcrosses and later generations, where a parent is itself a progeny.
+// [[Rcpp::export]]
+NumericVector crossProgenyFreq(NumericVector mother, NumericVector father,
+                               int motherPloidy, int fatherPloidy,
+                               int nalleles){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_CROSS_PROGENY_FREQ,
+                                 motherPloidy / 2 + fatherPloidy / 2, nalleles);
+  checkCrossArgs(motherPloidy, fatherPloidy, nalleles);
+  if(mother.size() != (R_xlen_t)ploidyverse::countGenotypes(motherPloidy, nalleles) ||
+     father.size() != (R_xlen_t)ploidyverse::countGenotypes(fatherPloidy, nalleles)){
+    stop("Length of mother and father must match the number of genotypes.");
+  }
+
+  int ploidy = motherPloidy / 2 + fatherPloidy / 2;
+  NumericVector out(no_init(ploidyverse::countGenotypes(ploidy, nalleles)));
+  timer.addBytes((double)out.size() * sizeof(double));
+  ploidyverse::crossFrequenciesInto(mother.begin(), motherPloidy, father.begin(),
+                                    fatherPloidy, nalleles, out.begin());
+  return out;
+}
+
+// Progeny genotype probabilities for many loci.  mother and father are
+// parent genotype indices in VCF order (as from indexGenotype), one per
+// locus, with NA for missing.  Output is flat, with progeny genotypes
+// varying fastest, then loci, and NA at loci with a missing parent.  Each
+// distinct combination of number of alleles and parent genotypes is only
+// computed once.
+// [[Rcpp::export]]
+NumericVector crossProgenyBatch(IntegerVector mother, IntegerVector father,
+                                IntegerVector nalleles, int motherPloidy,
+                                int fatherPloidy, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_CROSS_PROGENY_BATCH,
+                                 motherPloidy / 2 + fatherPloidy / 2, 0);
+  R_xlen_t nloci = nalleles.size();
+  if(mother.size() != nloci || father.size() != nloci){
+    stop("mother, father, and nalleles must be the same length.");
+  }
+  int ploidy = motherPloidy / 2 + fatherPloidy / 2;
+  std::vector<int> gm(nloci);
+  std::vector<int> gf(nloci);
+  double nout = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    checkCrossArgs(motherPloidy, fatherPloidy, nalleles[L]);
+    double ngm = ploidyverse::countGenotypes(motherPloidy, nalleles[L]);
+    double ngf = ploidyverse::countGenotypes(fatherPloidy, nalleles[L]);
+    gm[L] = mother[L] == NA_INTEGER ? -1 : mother[L];
+    gf[L] = father[L] == NA_INTEGER ? -1 : father[L];
+    if(gm[L] >= ngm || gf[L] >= ngf || (mother[L] != NA_INTEGER && gm[L] < 0) ||
+       (father[L] != NA_INTEGER && gf[L] < 0)){
+      stop("Parent genotype index out of range.");
+    }
+    nout += ploidyverse::countGenotypes(ploidy, nalleles[L]);
+  }
+
+  timer.addLoci(nalleles.begin(), nloci);
+  timer.addBytes(nout * sizeof(double) + 2.0 * nloci * sizeof(int));
+  NumericVector out(no_init((R_xlen_t)nout));
+  ploidyverse::crossProgenyBatch(gm.data(), gf.data(), nalleles.begin(), nloci,
+                                 motherPloidy, fatherPloidy, out.begin(),
+                                 nthreads);
+  for(R_xlen_t i = 0; i < out.size(); i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  return out;
+}
@@ -0,0 +1,60 @@
+#include <Rcpp.h>
+#include "ploidyverse/instrumentation.h"
+using namespace Rcpp;
+// [[Rcpp::interfaces(r, cpp)]]
+
+// Access to the call counters of the exported functions; see
+// ploidyverse/instrumentation.h.
+
+// Turn the counters on or off, returning the previous setting.
+// [[Rcpp::export]]
+bool instrumentKernels(bool enable = true){
+  return ploidyverse::instrumentation().setEnabled(enable);
+}
+
+// Counters since the last reset, as a data frame with one row per function
+// that has been called, and a data frame of calls (or for batch functions,
+// loci) by ploidy and number of alleles, omitting empty bins.
+// [[Rcpp::export]]
+List kernelStats(){
+  std::vector<ploidyverse::KernelStats> stats =
+    ploidyverse::instrumentation().snapshot();
+  const int nbin = ploidyverse::instrumentMaxBin + 1;
+  std::vector<std::string> fn, hfn;
+  std::vector<double> calls, seconds, bytes, hcount;
+  std::vector<int> hploidy, halleles;
+  for(int k = 0; k < ploidyverse::KERNEL_COUNT; k++){
+    const ploidyverse::KernelStats& s = stats[k];
+    if(s.calls == 0) continue;
+    fn.push_back(ploidyverse::kernelName(k));
+    calls.push_back((double)s.calls);
+    seconds.push_back(s.nanoseconds * 1e-9);
+    bytes.push_back((double)s.bytes);
+    for(int i = 0; i < nbin * nbin; i++){
+      if(s.histogram[i] == 0) continue;
+      hfn.push_back(ploidyverse::kernelName(k));
+      hploidy.push_back(i / nbin);
+      halleles.push_back(i % nbin);
+      hcount.push_back((double)s.histogram[i]);
+    }
+  }
+  DataFrame summary = DataFrame::create(Named("function") = wrap(fn),
+                                        Named("calls") = wrap(calls),
+                                        Named("seconds") = wrap(seconds),
+                                        Named("bytes") = wrap(bytes),
+                                        Named("stringsAsFactors") = false);
+  DataFrame histogram = DataFrame::create(Named("function") = wrap(hfn),
+                                          Named("ploidy") = wrap(hploidy),
+                                          Named("nalleles") = wrap(halleles),
+                                          Named("count") = wrap(hcount),
+                                          Named("stringsAsFactors") = false);
+  return List::create(Named("enabled") = ploidyverse::instrumentation().enabled(),
+                      Named("summary") = summary,
+                      Named("histogram") = histogram);
+}
+
+// Set all counters to zero.
+// [[Rcpp::export]]
+void resetKernelStats(){
+  ploidyverse::instrumentation().reset();
+}
@@ -0,0 +1,470 @@
+#include <Rcpp.h>
+#include <climits>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ploidyverse/hwe_priors.h"
+#include "ploidyverse/instrumentation.h"
+#include "ploidyverse/likelihood_kernels.h"
+#include "ploidyverse/overdispersion.h"
+#include "ploidyverse/ploidy_classes.h"
+using namespace Rcpp;
+
+// Batch genotype likelihoods from allelic read depth.
+
+// Log-likelihoods of all genotypes for all samples and loci in one call.
+// AD is a flat vector of read depths (alleles varying fastest, then samples,
+// then loci), which is also the layout of a 3D allele x sample x locus array.
+// nalleles gives the number of alleles at each locus.  Output is flat, with
+// genotypes in VCF order varying fastest, then samples, then loci.
+// If alpha is above zero, the Dirichlet-multinomial is used.
+// [[Rcpp::export]]
+NumericVector batchGenotypeLikelihoods(IntegerVector AD, IntegerVector nalleles,
+                                       int nsamples, int ploidy,
+                                       double error = 0.001, double alpha = 0,
+                                       int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_GENOTYPE_LIKELIHOODS,
+                                 ploidy, 0);
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nsamples < 0) stop("Number of samples cannot be negative.");
+  if(error < 0 || error >= 1) stop("error must be at least 0 and less than 1.");
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  double nout = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += (double)nalleles[L] * nsamples;
+    nout += Rf_choose(ploidy + nalleles[L] - 1, ploidy) * nsamples;
+  }
+  if(nin != AD.size()){
+    stop("Length of AD does not match nalleles and nsamples.");
+  }
+
+  timer.addLoci(nalleles.begin(), nloci);
+  timer.addBytes(nout * sizeof(double));
+  NumericVector out(no_init((R_xlen_t)nout));
+  ploidyverse::genotypeLogLikBatch(AD.begin(), nalleles.begin(), nloci,
+                                   nsamples, ploidy, error, alpha,
+                                   out.begin(), nthreads);
+  return out;
+}
+
+// Ploidy classes from one Ploidy string per sample, with the class of each
+// sample in sampleClass.
+static std::vector<ploidyverse::PloidyClass>
+  ploidyClasses(const std::vector<std::string>& ploidy,
+                std::vector<int>& sampleClass){
+  std::vector<ploidyverse::PloidyClass> classes;
+  try {
+    classes = ploidyverse::groupByPloidy(ploidy, sampleClass);
+  } catch(std::invalid_argument& e){
+    stop(e.what());
+  }
+  return classes;
+}
+
+// Number of genotypes for each sample and locus, samples varying fastest, as
+// in the "ngen" attribute of batchGenotypeLikelihoodsMixed.  nout receives
+// their sum.
+static IntegerVector
+  mixedGenotypeCounts(const IntegerVector& nalleles,
+                      const std::vector<ploidyverse::PloidyClass>& classes,
+                      const std::vector<int>& sampleClass, double& nout){
+  const R_xlen_t nloci = nalleles.size();
+  const int nsamples = sampleClass.size();
+  IntegerVector ngen(no_init(nloci * nsamples));
+  nout = 0;
+  std::map<int, std::vector<int> > classNgen; // by number of alleles
+  for(R_xlen_t L = 0; L < nloci; L++){
+    std::vector<int>& ng = classNgen[nalleles[L]];
+    if(ng.empty()){
+      for(std::size_t c = 0; c < classes.size(); c++){
+        unsigned long long n =
+          ploidyverse::countClassGenotypes(classes[c], nalleles[L]);
+        if(n > INT_MAX) stop("Too many genotypes to enumerate.");
+        ng.push_back(n);
+      }
+    }
+    for(int s = 0; s < nsamples; s++){
+      ngen[L * nsamples + s] = ng[sampleClass[s]];
+      nout += ng[sampleClass[s]];
+    }
+  }
+  return ngen;
+}
+
+// As above, for samples that differ in ploidy.  ploidy has one string per
+// sample, such as "2x", "4x" or "2x+2x"; see ploidyverse/ploidy_classes.h for
+// how allopolyploid genotypes are ordered.  Output is flat as above, but the
+// number of genotypes varies by sample, so it is given in the "ngen"
+// attribute, with samples varying fastest, then loci.
+// [[Rcpp::export]]
+NumericVector batchGenotypeLikelihoodsMixed(IntegerVector AD,
+                                            IntegerVector nalleles,
+                                            std::vector<std::string> ploidy,
+                                            double error = 0.001,
+                                            double alpha = 0,
+                                            int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_GENOTYPE_LIKELIHOODS_MIXED,
+                                 0, 0);
+  if(error < 0 || error >= 1) stop("error must be at least 0 and less than 1.");
+  const int nsamples = ploidy.size();
+  std::vector<int> sampleClass;
+  const std::vector<ploidyverse::PloidyClass> classes =
+    ploidyClasses(ploidy, sampleClass);
+
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += (double)nalleles[L] * nsamples;
+  }
+  if(nin != AD.size()){
+    stop("Length of AD does not match nalleles and ploidy.");
+  }
+  double nout = 0;
+  IntegerVector ngen = mixedGenotypeCounts(nalleles, classes, sampleClass,
+                                           nout);
+
+  timer.addLoci(nalleles.begin(), nloci);
+  timer.addBytes(nout * sizeof(double));
+  NumericVector out(no_init((R_xlen_t)nout));
+  ploidyverse::genotypeLogLikMixed(AD.begin(), nalleles.begin(), nloci,
+                                   nsamples, classes, sampleClass.data(),
+                                   error, alpha, out.begin(), nthreads);
+  out.attr("ngen") = ngen;
+  return out;
+}
+
+// Maximum likelihood estimates of the Dirichlet-multinomial overdispersion
+// parameter for each locus, or one shared by all loci, from read depth and
+// genotype probabilities.  AD and nalleles are as in batchGenotypeLikelihoods,
+// and genoprobs is laid out like its output.  Loci without usable samples
+// give NA.
+// [[Rcpp::export]]
+NumericVector fitOverdispersionBatch(IntegerVector AD, NumericVector genoprobs,
+                                     IntegerVector nalleles, int nsamples,
+                                     int ploidy, double error = 0.001,
+                                     bool shared = false, double lower = 0.01,
+                                     double upper = 10000, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_FIT_OVERDISPERSION,
+                                 ploidy, 0);
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nsamples < 0) stop("Number of samples cannot be negative.");
+  if(error < 0 || error >= 1) stop("error must be at least 0 and less than 1.");
+  if(!(lower > 0 && upper > lower && std::isfinite(upper))){
+    stop("Bounds must be positive and finite, with lower below upper.");
+  }
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  double ngp = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += (double)nalleles[L] * nsamples;
+    ngp += Rf_choose(ploidy + nalleles[L] - 1, ploidy) * nsamples;
+  }
+  if(nin != AD.size()){
+    stop("Length of AD does not match nalleles and nsamples.");
+  }
+  if(ngp != genoprobs.size()){
+    stop("Length of genoprobs does not match nalleles, nsamples and ploidy.");
+  }
+
+  timer.addLoci(nalleles.begin(), nloci);
+  NumericVector out(shared ? 1 : nloci);
+  ploidyverse::fitOverdispersionBatch(AD.begin(), genoprobs.begin(),
+                                      nalleles.begin(), nloci, nsamples, ploidy,
+                                      error, lower, upper, shared, out.begin(),
+                                      nthreads);
+  for(R_xlen_t i = 0; i < out.size(); i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  return out;
+}
+
+// As above, for samples that differ in ploidy, given as in
+// batchGenotypeLikelihoodsMixed, with genoprobs laid out like its output.
+// [[Rcpp::export]]
+NumericVector fitOverdispersionMixed(IntegerVector AD, NumericVector genoprobs,
+                                     IntegerVector nalleles,
+                                     std::vector<std::string> ploidy,
+                                     double error = 0.001, bool shared = false,
+                                     double lower = 0.01, double upper = 10000,
+                                     int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_FIT_OVERDISPERSION_MIXED,
+                                 0, 0);
+  if(error < 0 || error >= 1) stop("error must be at least 0 and less than 1.");
+  if(!(lower > 0 && upper > lower && std::isfinite(upper))){
+    stop("Bounds must be positive and finite, with lower below upper.");
+  }
+  const int nsamples = ploidy.size();
+  std::vector<int> sampleClass;
+  const std::vector<ploidyverse::PloidyClass> classes =
+    ploidyClasses(ploidy, sampleClass);
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += (double)nalleles[L] * nsamples;
+  }
+  if(nin != AD.size()){
+    stop("Length of AD does not match nalleles and ploidy.");
+  }
+  double ngp = 0;
+  mixedGenotypeCounts(nalleles, classes, sampleClass, ngp);
+  if(ngp != genoprobs.size()){
+    stop("Length of genoprobs does not match nalleles and ploidy.");
+  }
+
+  timer.addLoci(nalleles.begin(), nloci);
+  NumericVector out(shared ? 1 : nloci);
+  ploidyverse::fitOverdispersionMixed(AD.begin(), genoprobs.begin(),
+                                      nalleles.begin(), nloci, nsamples,
+                                      classes, sampleClass.data(), error,
+                                      lower, upper, shared, out.begin(),
+                                      nthreads);
+  for(R_xlen_t i = 0; i < out.size(); i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  return out;
+}
+
+// Genotype priors under Hardy-Weinberg equilibrium from allele frequencies.
+// freq is a flat vector of allele frequencies, alleles varying fastest, then
+// loci.  Each locus's priors are repeated nsamples times, so with the number
+// of samples in the likelihoods the output can be passed to logLikToPosterior
+// as a prior of the same length.  Frequencies are rescaled to sum to one;
+// loci with missing or negative frequencies are NA.
+// [[Rcpp::export]]
+NumericVector hwePriorsBatch(NumericVector freq, IntegerVector nalleles,
+                             int ploidy, int nsamples = 1,
+                             bool logOutput = false, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_HWE_PRIORS, ploidy, 0);
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nsamples < 0) stop("Number of samples cannot be negative.");
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  double nout = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += nalleles[L];
+    nout += Rf_choose(ploidy + nalleles[L] - 1, ploidy) * nsamples;
+  }
+  if(nin != freq.size()){
+    stop("Length of freq does not match nalleles.");
+  }
+
+  timer.addLoci(nalleles.begin(), nloci);
+  timer.addBytes(nout * sizeof(double));
+  NumericVector out(no_init((R_xlen_t)nout));
+  ploidyverse::hwePriorsBatch(freq.begin(), nalleles.begin(), nloci, ploidy,
+                              nsamples, logOutput, out.begin(), nthreads);
+  for(R_xlen_t i = 0; i < out.size(); i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  return out;
+}
+
+// As above, for samples that differ in ploidy, given as in
+// batchGenotypeLikelihoodsMixed.  Each sample gets the priors for its own
+// ploidy, so the output is laid out like, and has the "ngen" attribute of,
+// the output of batchGenotypeLikelihoodsMixed.  Every sample must be
+// autopolyploid.
+// [[Rcpp::export]]
+NumericVector hwePriorsMixed(NumericVector freq, IntegerVector nalleles,
+                             std::vector<std::string> ploidy,
+                             bool logOutput = false, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_HWE_PRIORS_MIXED, 0, 0);
+  const int nsamples = ploidy.size();
+  std::vector<int> sampleClass;
+  const std::vector<ploidyverse::PloidyClass> classes =
+    ploidyClasses(ploidy, sampleClass);
+  try {
+    ploidyverse::checkHweClasses(classes);
+  } catch(std::invalid_argument& e){
+    stop(e.what());
+  }
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += nalleles[L];
+  }
+  if(nin != freq.size()){
+    stop("Length of freq does not match nalleles.");
+  }
+  double nout = 0;
+  IntegerVector ngen = mixedGenotypeCounts(nalleles, classes, sampleClass,
+                                           nout);
+
+  timer.addLoci(nalleles.begin(), nloci);
+  timer.addBytes(nout * sizeof(double));
+  NumericVector out(no_init((R_xlen_t)nout));
+  ploidyverse::hwePriorsMixed(freq.begin(), nalleles.begin(), nloci, nsamples,
+                              classes, sampleClass.data(), logOutput,
+                              out.begin(), nthreads);
+  for(R_xlen_t i = 0; i < out.size(); i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  out.attr("ngen") = ngen;
+  return out;
+}
+
+// Allele frequencies for each locus by EM from read depth, assuming HWE, with
+// AD, nalleles, error and alpha as in batchGenotypeLikelihoods.  Output is
+// flat as the freq argument of hwePriorsBatch, with the number of iterations
+// for each locus in the "iterations" attribute.  Loci where no sample has
+// reads are NA.
+// [[Rcpp::export]]
+NumericVector alleleFreqEMBatch(IntegerVector AD, IntegerVector nalleles,
+                                int nsamples, int ploidy, double error = 0.001,
+                                double alpha = 0, double tol = 1e-6,
+                                int maxit = 200, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_ALLELE_FREQ_EM, ploidy, 0);
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nsamples < 0) stop("Number of samples cannot be negative.");
+  if(error < 0 || error >= 1) stop("error must be at least 0 and less than 1.");
+  if(!(tol > 0)) stop("tol must be positive.");
+  if(maxit < 1) stop("maxit must be at least 1.");
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  double nfreq = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += (double)nalleles[L] * nsamples;
+    nfreq += nalleles[L];
+  }
+  if(nin != AD.size()){
+    stop("Length of AD does not match nalleles and nsamples.");
+  }
+
+  timer.addLoci(nalleles.begin(), nloci);
+  NumericVector out(no_init((R_xlen_t)nfreq));
+  IntegerVector iter(nloci);
+  ploidyverse::alleleFreqEMBatch(AD.begin(), nalleles.begin(), nloci,
+                                 nsamples, ploidy, error, alpha, tol, maxit,
+                                 out.begin(), iter.begin(), nthreads);
+  for(R_xlen_t i = 0; i < out.size(); i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  out.attr("iterations") = iter;
+  return out;
+}
+
+// As above, for samples that differ in ploidy, given as in
+// batchGenotypeLikelihoodsMixed.  All samples share one set of allele
+// frequencies, and every sample must be autopolyploid.
+// [[Rcpp::export]]
+NumericVector alleleFreqEMMixed(IntegerVector AD, IntegerVector nalleles,
+                                std::vector<std::string> ploidy,
+                                double error = 0.001, double alpha = 0,
+                                double tol = 1e-6, int maxit = 200,
+                                int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_ALLELE_FREQ_EM_MIXED,
+                                 0, 0);
+  if(error < 0 || error >= 1) stop("error must be at least 0 and less than 1.");
+  if(!(tol > 0)) stop("tol must be positive.");
+  if(maxit < 1) stop("maxit must be at least 1.");
+  const int nsamples = ploidy.size();
+  std::vector<int> sampleClass;
+  const std::vector<ploidyverse::PloidyClass> classes =
+    ploidyClasses(ploidy, sampleClass);
+  try {
+    ploidyverse::checkHweClasses(classes);
+  } catch(std::invalid_argument& e){
+    stop(e.what());
+  }
+  R_xlen_t nloci = nalleles.size();
+  double nin = 0;
+  double nfreq = 0;
+  for(R_xlen_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Number of alleles must be at least 1.");
+    nin += (double)nalleles[L] * nsamples;
+    nfreq += nalleles[L];
+  }
+  if(nin != AD.size()){
+    stop("Length of AD does not match nalleles and ploidy.");
+  }
+
+  timer.addLoci(nalleles.begin(), nloci);
+  NumericVector out(no_init((R_xlen_t)nfreq));
+  IntegerVector iter(nloci);
+  ploidyverse::alleleFreqEMMixed(AD.begin(), nalleles.begin(), nloci,
+                                 nsamples, classes, sampleClass.data(), error,
+                                 alpha, tol, maxit, out.begin(), iter.begin(),
+                                 nthreads);
+  for(R_xlen_t i = 0; i < out.size(); i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  out.attr("iterations") = iter;
+  return out;
+}
+
+// Statistics for the shared lgamma caches: the log-factorial table used by
+// dmultinom, dDirichletMultinom and batchGenotypeLikelihoods, and the
+// Dirichlet-multinomial tables used by batchGenotypeLikelihoods.
+// [[Rcpp::export]]
+NumericVector lgammaCacheStats(){
+  ploidyverse::LogFactorialTable& lf = ploidyverse::logFactorialTable();
+  ploidyverse::DirichletGammaCache& dg = ploidyverse::dirichletGammaCache();
+  NumericVector out = NumericVector::create(
+    Named("factorialHits") = (double)lf.hits(),
+    Named("factorialMisses") = (double)lf.misses(),
+    Named("factorialTableSize") = (double)lf.size(),
+    Named("dirichletHits") = (double)dg.hits(),
+    Named("dirichletMisses") = (double)dg.misses(),
+    Named("dirichletTables") = (double)dg.entries(),
+    Named("dirichletBytes") = (double)dg.bytes());
+  return out;
+}
+
+// Reset the hit and miss counts and free the Dirichlet-multinomial tables.
+// The factorial table is kept, since its values never change.
+// [[Rcpp::export]]
+void resetLgammaCache(){
+  ploidyverse::logFactorialTable().resetCounts();
+  ploidyverse::dirichletGammaCache().clear();
+}
+
+// Convert genotype log-likelihoods to posterior probabilities in one pass,
+// using log-sum-exp.  loglik is divided into consecutive blocks of ngen values
+// (for example, the output of genotypeLikelihoods for one number of alleles),
+// each of which is normalized.  prior is a vector of genotype probabilities,
+// either of length ngen to be used for every block, or the same length as
+// loglik.  Attributes such as dim are kept.
+// [[Rcpp::export]]
+NumericVector logLikToPosterior(NumericVector loglik, int ngen,
+                                Nullable<NumericVector> prior = R_NilValue,
+                                bool logOutput = false, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_LOGLIK_TO_POSTERIOR, 0, 0);
+  if(ngen < 1) stop("ngen must be at least 1.");
+  R_xlen_t n = loglik.size();
+  if(n % ngen != 0) stop("Length of loglik must be a multiple of ngen.");
+
+  std::vector<double> logprior;
+  bool perBlock = false;
+  if(prior.isNotNull()){
+    NumericVector pr(prior.get());
+    if(pr.size() == n && n != ngen){
+      perBlock = true;
+    } else if(pr.size() != ngen){
+      stop("prior must be of length ngen or the same length as loglik.");
+    }
+    logprior.resize(pr.size());
+    for(R_xlen_t i = 0; i < pr.size(); i++){
+      logprior[i] = log(pr[i]);
+    }
+  }
+
+  NumericVector out(no_init(n));
+  timer.addBytes(((double)n + logprior.size()) * sizeof(double));
+  out.attr("dim") = loglik.attr("dim");
+  out.attr("dimnames") = loglik.attr("dimnames");
+  ploidyverse::logLikToPosteriorBatch(loglik.begin(),
+                                      logprior.empty() ? NULL : &logprior[0],
+                                      perBlock, ngen, n / ngen, logOutput,
+                                      out.begin(), nthreads);
+  return out;
+}
@@ -1,88 +1,144 @@
 #include <Rcpp.h>
+#include <climits>
+#include "ploidyverse/genotype_tables.h"
+#include "ploidyverse/instrumentation.h"
+#include "ploidyverse/multiallele_utils.h"
+#include "ploidyverse/ploidy_classes.h"
+#include "ploidyverse/selfing_kernels.h"
 using namespace Rcpp;
 // [[Rcpp::interfaces(r, cpp)]]
 
-// Utilities for working with multiallelic genotypes.
+// Utilities for working with multiallelic genotypes.  Most are wrappers
+// around the functions of the same names in ploidyverse/multiallele_utils.h,
+// which other packages can call from C++ directly.
 
 // Compiled version of the dmultinom function from R, using some of the same
 // source code.  Performs much less error checking than the R version.
+// Factorials come from a shared lookup table; see lgamma_cache.h.
 // [[Rcpp::export]]
 double dmultinom(NumericVector x, NumericVector prob){
-  double out;
-  double logout;
-  LogicalVector nonzero = prob > 0;
-  x = x[nonzero];
-  prob = prob[nonzero];
-  
-  logout = lgamma(sum(x) + 1) + sum(x * log(prob) - lgamma(x + 1));
-  out = exp(logout);
-  
-  return out;
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_DMULTINOM, 0, x.size());
+  return ploidyverse::dmultinom(x.begin(), prob.begin(), x.size());
 }
 
 // Probability distrubution under the Dirichlet multinomial.
 // For estimating genotype likelihoods under overdispersion.
 // [[Rcpp::export]]
 double dDirichletMultinom(NumericVector x, NumericVector prob, double alpha){
-  LogicalVector nonzero = prob > 0;
-  x = x[nonzero];
-  prob = prob[nonzero];
-  double n = sum(x);
-  double tot = lgamma(n + 1) + lgamma(alpha) - lgamma(n + alpha);
-  NumericVector alphas = alpha * prob;
-  double ind = sum(lgamma(x + 1) + lgamma(alphas) - lgamma(alphas + x));
-  return exp(tot - ind);
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_DDIRICHLETMULTINOM,
+                                 0, x.size());
+  return ploidyverse::dDirichletMultinom(x.begin(), prob.begin(), x.size(),
+                                         alpha);
+}
+
+// Log-space versions of the above.  At high read depth the probabilities
+// underflow to zero, whereas the log probabilities remain usable.
+// [[Rcpp::export]]
+double dmultinomLog(NumericVector x, NumericVector prob){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_DMULTINOM, 0, x.size());
+  return ploidyverse::dmultinomLog(x.begin(), prob.begin(), x.size());
+}
+
+// [[Rcpp::export]]
+double dDirichletMultinomLog(NumericVector x, NumericVector prob, double alpha){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_DDIRICHLETMULTINOM,
+                                 0, x.size());
+  return ploidyverse::dDirichletMultinomLog(x.begin(), prob.begin(), x.size(),
+                                            alpha);
 }
 
 // Function to get number of possible genotypes.
 // (ploidy + nalleles - 1)!/(ploidy! * (nalleles - 1)!)
+// Looked up from an exact table of binomial coefficients.
 // [[Rcpp::export]]
 int nGen(int ploidy, int nalleles) {
-  // Adding 0.5 is necessary because of floating point math error and
-  // truncation to integer.
-  return exp(lgamma(ploidy + nalleles) - lgamma(ploidy + 1) - lgamma(nalleles)) + 0.5;
+  unsigned long long out = ploidyverse::nGen(ploidy, nalleles);
+  if(out > INT_MAX){
+    stop("Number of genotypes too large to represent as an integer.");
+  }
+  return out;
 }
 
 // Function to enumerate genotypes in the VCF order.
 // Each row of output matrix is one genotype.
 // The matrix has as many columns as the ploidy.
 // Each cell contains the index of an allele that the genotype has.
+// Genotypes come from a cache shared with the other functions in this file,
+// so repeated calls for the same ploidy are just a copy; see genotype_tables.h.
 // [[Rcpp::export]]
 IntegerMatrix enumerateGenotypes(int ploidy, int nalleles){
-  int ngen = nGen(ploidy, nalleles);
-  IntegerMatrix out(ngen, ploidy);
-  int startrow;
-  IntegerMatrix submat;
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_ENUMERATE_GENOTYPES,
+                                 ploidy, nalleles);
+  ploidyverse::GenotypeTable tab = ploidyverse::genotypeTable(ploidy, nalleles);
+  IntegerMatrix out(tab.ngen, ploidy);
+  timer.addBytes((double)tab.ngen * ploidy * sizeof(int));
   
-  // a is allele, r is row, and c is column.
-  for(int a = 0; a < nalleles; a++){
-    if(ploidy == 1){
-      out(a, 0) = a;
-    } else {
-      startrow = nGen(ploidy, a);
-      submat = enumerateGenotypes(ploidy - 1, a + 1);
-      for(int r = 0; r < submat.nrow(); r++){
-        out(r + startrow, ploidy - 1) = a;
-        for(int c = 0; c < ploidy - 1; c++){
-          out(r + startrow, c) = submat(r, c);
-        }
-      }
+  // r is row, and c is column.
+  for(int r = 0; r < tab.ngen; r++){
+    const int* geno = tab.row(r);
+    for(int c = 0; c < ploidy; c++){
+      out(r, c) = geno[c];
     }
   }
   
   return out;
 }
 
+// Genotypes for a ploidy string such as "4x" or "2x+2x".  For an
+// allopolyploid, each row has the alleles of each subgenome in turn, and rows
+// are all combinations of the subgenomes' genotypes, with the first
+// subgenome varying fastest.  For an autopolyploid the output is the same as
+// enumerateGenotypes.
+// [[Rcpp::export]]
+IntegerMatrix enumeratePloidyGenotypes(std::string ploidy, int nalleles){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_ENUMERATE_PLOIDY_GENOTYPES,
+                                 0, nalleles);
+  ploidyverse::PloidyClass cls;
+  int ngen;
+  try {
+    cls = ploidyverse::parsePloidy(ploidy);
+    ngen = ploidyverse::classGenotypeCount(cls, nalleles);
+  } catch(std::exception& e){
+    stop(e.what());
+  }
+  timer.addBytes((double)ngen * cls.ploidy * sizeof(int) * 2);
+  std::vector<int> genos((std::size_t)ngen * cls.ploidy);
+  ploidyverse::enumerateClassGenotypes(cls, nalleles, genos.data());
+  IntegerMatrix out(ngen, cls.ploidy);
+  for(int r = 0; r < ngen; r++){
+    for(int c = 0; c < cls.ploidy; c++){
+      out(r, c) = genos[(std::size_t)r * cls.ploidy + c];
+    }
+  }
+  std::vector<int> subgenome;
+  for(std::size_t k = 0; k < cls.subgenomes.size(); k++){
+    subgenome.insert(subgenome.end(), cls.subgenomes[k], k + 1);
+  }
+  out.attr("subgenome") = wrap(subgenome);
+  return out;
+}
+
 // Get the index of a given genotype, i.e. the row that the genotype would
 // appear in, in the matrix output by enumerateGenotypes.
 // [[Rcpp::export]]
 int indexGenotype(IntegerVector genotype){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_INDEX_GENOTYPE,
+                                 genotype.size(), 0);
   int ploidy = genotype.size();
-  int out = 0;
-  int g;
-  for(int m = 1; m < ploidy + 1; m++){
-    g = genotype(m - 1);
-    out += Rf_choose(g + m - 1, m);
+  for(int i = 0; i < ploidy; i++){
+    // NA_INTEGER is negative, so this catches missing alleles too
+    if(genotype[i] < 0) stop("Alleles must be zero or above, and not NA.");
+    if(i > 0 && genotype[i] < genotype[i - 1]){
+      stop("Genotype must be sorted in ascending order.");
+    }
+  }
+  // sorted, so the last allele is the highest
+  if(ploidy > 0 && !ploidyverse::canRankGenotypes(ploidy, genotype(ploidy - 1))){
+    stop("Genotype index cannot be computed exactly.");
+  }
+  unsigned long long out = ploidyverse::indexGenotype(genotype.begin(), ploidy);
+  if(out > INT_MAX){
+    stop("Genotype index too large to represent as an integer; use indexGenotypes.");
   }
   return out;
 }
@@ -91,19 +147,69 @@ int indexGenotype(IntegerVector genotype){
 // the matrix of all possible genotypes.
 // [[Rcpp::export]]
 IntegerVector genotypeFromIndex(int index, int ploidy){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_GENOTYPE_FROM_INDEX, ploidy, 0);
   IntegerVector out(ploidy);
-  int nal; // number of alleles
-  
-  // work backwards from last allele in the genotype
-  for(int p = ploidy; p > 0; p--){
-    nal = 1;
-    while(nGen(p, nal) < index + 1){
-      nal++;
+  if(index < 0) stop("Index cannot be negative.");
+  ploidyverse::genotypeFromIndex(index, ploidy, out.begin());
+  return out;
+}
+
+// Vectorized versions of the above.  Each row of genotypes is one genotype,
+// and need not be sorted.  Indices are returned as doubles, which represent
+// integers exactly up to 2^53, so they can go beyond the range of int.
+// Missing genotypes and indices are NA.
+// [[Rcpp::export]]
+NumericVector indexGenotypes(IntegerMatrix genotypes, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_INDEX_GENOTYPES,
+                                 genotypes.ncol(), 0);
+  int n = genotypes.nrow();
+  int ploidy = genotypes.ncol();
+  int maxallele = 0;
+  for(IntegerMatrix::iterator it = genotypes.begin(); it != genotypes.end(); ++it){
+    if(*it > maxallele) maxallele = *it;
+  }
+  if(!ploidyverse::canRankGenotypes(ploidy, maxallele)){
+    stop("Genotype indices cannot be computed exactly.");
+  }
+  timer.setAlleles(maxallele + 1);
+  timer.addBytes((double)n * (sizeof(unsigned long long) + sizeof(double)));
+  std::vector<unsigned long long> idx(n);
+  ploidyverse::rankGenotypesBatch(genotypes.begin(), n, ploidy, idx.data(),
+                                  nthreads);
+  NumericVector out(n);
+  for(int i = 0; i < n; i++){
+    if(idx[i] == ULLONG_MAX){
+      out[i] = NA_REAL;
+    } else if(idx[i] > 9007199254740992ULL){
+      stop("Genotype index too large to represent exactly.");
+    } else {
+      out[i] = idx[i];
     }
-    out(p - 1) = nal - 1;
-    index -= nGen(p, nal - 1);
   }
-  
+  return out;
+}
+
+// [[Rcpp::export]]
+IntegerMatrix genotypesFromIndex(NumericVector index, int ploidy,
+                                 int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_GENOTYPES_FROM_INDEX,
+                                 ploidy, 0);
+  R_xlen_t n = index.size();
+  std::vector<unsigned long long> idx(n);
+  for(R_xlen_t i = 0; i < n; i++){
+    double v = index[i];
+    if(ISNAN(v)){
+      idx[i] = ULLONG_MAX;
+    } else if(v < 0 || v != floor(v) || v > 9007199254740992.0){
+      stop("Indices must be whole numbers from zero to 2^53.");
+    } else {
+      idx[i] = v;
+    }
+  }
+  IntegerMatrix out(n, ploidy);
+  timer.addBytes((double)n * (sizeof(unsigned long long) + ploidy * sizeof(int)));
+  ploidyverse::unrankGenotypesBatch(idx.data(), n, ploidy, NA_INTEGER,
+                                    out.begin(), nthreads);
   return out;
 }
 
@@ -112,53 +218,57 @@ IntegerVector genotypeFromIndex(int index, int ploidy){
 // a format useful for multinomial probability calculations.
 // [[Rcpp::export]]
 IntegerVector alleleCopy(IntegerVector genotype, int nalleles){
-  IntegerVector out (nalleles);
-  int ploidy = genotype.size();
-  int g;
-  
-  for(int i = 0; i < ploidy; i++){
-    g = genotype(i);
-    out(g)++;
-  }
-  
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_ALLELE_COPY,
+                                 genotype.size(), nalleles);
+  IntegerVector out(nalleles);
+  ploidyverse::alleleCopy(genotype.begin(), genotype.size(), nalleles, out.begin());
   return out;
 }
 
-// Internal, recursive function for generating gamete genotypes
-IntegerMatrix makeGametesRecur(IntegerVector genotype, int gamploidy){
+// For a given genotype, return a matrix containing all possible gamete
+// genotypes.  Duplicates will be output reflecting relative gamete frequency.
+// Ploidy should be even.
+// [[Rcpp::export]]
+IntegerMatrix makeGametes(IntegerVector genotype){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_MAKE_GAMETES,
+                                 genotype.size(), 0);
   int ploidy = genotype.size();
-  int ngametes = Rf_choose(ploidy, gamploidy);
+  int gamploidy = ploidy / 2;
+  std::vector<int> gametes = ploidyverse::makeGametes(genotype.begin(), ploidy);
+  int ngametes = gamploidy > 0 ? gametes.size() / gamploidy : 1;
+  timer.addBytes(2.0 * gametes.size() * sizeof(int));
   IntegerMatrix out(ngametes, gamploidy);
-  IntegerMatrix subout;
-  int row = 0;
-  
-  if(gamploidy == 1){
-    for(int i = 0; i < ngametes; i++){
-      out(i, 0) = genotype(i);
-    }
-  } else {
-    for(int i = 0; i < ploidy - gamploidy + 1; i++){
-      subout = makeGametesRecur(genotype[Range(i + 1, (ploidy - 1))], gamploidy - 1);
-      for(int r = 0; r < subout.nrow(); r++){
-        out(row, 0) = genotype(i);
-        for(int c = 0; c < subout.ncol(); c++){
-          out(row, c + 1) = subout(r, c);
-        }
-        row++;
-      }
+  for(int g = 0; g < ngametes; g++){
+    for(int c = 0; c < gamploidy; c++){
+      out(g, c) = gametes[(std::size_t)g * gamploidy + c];
     }
   }
-  
   return out;
 }
 
-// For a given genotype, return a matrix containing all possible gamete
-// genotypes.  Duplicates will be output reflecting relative gamete frequency.
-// Ploidy should be even.
+// For a given genotype, return each distinct gamete genotype once, in VCF
+// order, with its probability.  Ploidy should be even.
 // [[Rcpp::export]]
-IntegerMatrix makeGametes(IntegerVector genotype){
-  int gamploidy = genotype.size() / 2;
-  return makeGametesRecur(genotype, gamploidy);
+List gameteDistribution(IntegerVector genotype){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_GAMETE_DISTRIBUTION,
+                                 genotype.size(), 0);
+  int ploidy = genotype.size();
+  std::vector<int> geno(genotype.begin(), genotype.end());
+  for(int i = 0; i < ploidy; i++){
+    if(geno[i] == NA_INTEGER || geno[i] < 0) stop("Missing or negative allele.");
+  }
+  std::sort(geno.begin(), geno.end());
+  ploidyverse::GameteDistribution gam;
+  ploidyverse::gameteDistribution(geno.data(), ploidy, gam);
+
+  IntegerMatrix gametes(gam.size(), gam.gamploidy);
+  for(int g = 0; g < gam.size(); g++){
+    for(int c = 0; c < gam.gamploidy; c++){
+      gametes(g, c) = gam.gamete(g)[c];
+    }
+  }
+  NumericVector prob(gam.prob.begin(), gam.prob.end());
+  return List::create(Named("gametes") = gametes, Named("prob") = prob);
 }
 
 // Generate a square matrix indicating the expected frequency of progeny
@@ -169,34 +279,18 @@ IntegerMatrix makeGametes(IntegerVector genotype){
 // generation of self fertilization.  Genotypes are in VCF order.
 // [[Rcpp::export]]
 NumericMatrix selfingMatrix(int ploidy, int nalleles){
-  IntegerMatrix allgen = enumerateGenotypes(ploidy, nalleles);
-  int ngen = allgen.nrow();
-  int gamploidy = ploidy / 2;
-  int ngametes = Rf_choose(ploidy, gamploidy);
-  IntegerVector thisgen(ploidy); // genotype that is being selfed
-  IntegerMatrix thesegametes(ngametes, gamploidy);
-  IntegerVector gam1(gamploidy); // genotype of gamete 1
-  IntegerVector gam2(gamploidy); // genotype of gamete 2
-  IntegerVector proggen(ploidy); // genotype of selfed progeny
-  int progindex; // genotype index for a selfed progeny
-  double increment = 1. / ngametes / ngametes;
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_SELFING_MATRIX,
+                                 ploidy, nalleles);
+  ploidyverse::GenotypeTable allgen = ploidyverse::genotypeTable(ploidy, nalleles);
+  int ngen = allgen.ngen;
+  ploidyverse::SparseRow row; // progeny distribution for one parent
   NumericMatrix out(ngen, ngen);
+  timer.addBytes((double)ngen * ngen * sizeof(double));
   
   for(int i = 0; i < ngen; i++){
-    thisgen = allgen(i, _ );
-    thesegametes = makeGametes(thisgen);
-    for(int g1 = 0; g1 < ngametes; g1++){
-      gam1 = thesegametes(g1, _ );
-      for(int g2 = 0; g2 < ngametes; g2++){
-        gam2 = thesegametes(g2, _ );
-        for(int j = 0; j < gamploidy; j++){
-          proggen(j) = gam1(j);
-          proggen(j + gamploidy) = gam2(j);
-        }
-        std::sort(proggen.begin(), proggen.end());
-        progindex = indexGenotype(proggen);
-        out(i, progindex) += increment;
-      }
+    ploidyverse::selfingRow(allgen.row(i), ploidy, row);
+    for(std::size_t e = 0; e < row.size(); e++){
+      out(i, row[e].first) = row[e].second;
     }
   }
   
@@ -0,0 +1,207 @@
+#include <Rcpp.h>
+#include <cmath>
+#include "ploidyverse/instrumentation.h"
+#include "ploidyverse/prob_convert_kernels.h"
+using namespace Rcpp;
+
+// Conversion between allele copy number probabilities and multiallelic
+// genotype probabilities.
+
+// Number of genotype probabilities in a numeric or quantized (raw) vector.
+static double probCount(SEXP genoprobs){
+  if(TYPEOF(genoprobs) == RAWSXP){
+    return (double)XLENGTH(genoprobs) / sizeof(ploidyverse::QuantizedProb);
+  }
+  if(TYPEOF(genoprobs) != REALSXP) stop("genoprobs must be numeric or raw.");
+  return XLENGTH(genoprobs);
+}
+
+static const ploidyverse::QuantizedProb* quantizedPointer(SEXP genoprobs){
+  return reinterpret_cast<const ploidyverse::QuantizedProb*>(RAW(genoprobs));
+}
+
+// Check the allele columns for each locus and return the number of values
+// expected in a flat genotype probability vector.
+static double checkConvertArgs(int ploidy, int nsamples,
+                               IntegerVector alleleCols,
+                               IntegerVector nalleles, R_xlen_t ncols){
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nsamples < 0) stop("Number of samples cannot be negative.");
+  double ngeno = 0;
+  R_xlen_t totalal = 0;
+  for(R_xlen_t L = 0; L < nalleles.size(); L++){
+    if(nalleles[L] == NA_INTEGER || nalleles[L] < 0){
+      stop("Number of alleles cannot be missing or negative.");
+    }
+    if(!ploidyverse::canRankGenotypes(ploidy, nalleles[L])){
+      stop("Too many genotypes for this ploidy and number of alleles.");
+    }
+    totalal += nalleles[L];
+    ngeno += (double)ploidyverse::countGenotypes(ploidy, nalleles[L]) * nsamples;
+  }
+  if(totalal != alleleCols.size()){
+    stop("Length of alleleCols must be the total number of alleles.");
+  }
+  std::vector<bool> used(ncols, false);
+  for(R_xlen_t i = 0; i < alleleCols.size(); i++){
+    int c = alleleCols[i];
+    if(c == NA_INTEGER || c < 0 || c >= ncols) stop("alleleCols out of range.");
+    if(used[c]) stop("Each allele column can only belong to one locus.");
+    used[c] = true;
+  }
+  return ngeno;
+}
+
+// Multiallelic genotype probabilities from allele copy number probabilities.
+// probarray is a (ploidy + 1) x nsamples x alleles array as in polyRAD.
+// alleleCols gives the zero-based position of each allele along the third
+// dimension, grouped by locus, and nalleles the number of alleles per locus.
+// Output is flat, with genotypes in VCF order varying fastest, then samples,
+// then loci, as doubles or, if quantize is true, as quantized probabilities in
+// a raw vector.
+// [[Rcpp::export]]
+SEXP acnToGenoBatch(NumericVector probarray, int ploidy, int nsamples,
+                    IntegerVector alleleCols, IntegerVector nalleles,
+                    int nthreads = 1, bool quantize = false){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_ACN_TO_GENO, ploidy, 0);
+  R_xlen_t blocksize = (R_xlen_t)(ploidy + 1) * nsamples;
+  if(blocksize == 0 || probarray.size() % blocksize != 0){
+    stop("Length of probarray does not match ploidy and nsamples.");
+  }
+  double nout = checkConvertArgs(ploidy, nsamples, alleleCols, nalleles,
+                                 probarray.size() / blocksize);
+  timer.addLoci(nalleles.begin(), nalleles.size());
+  timer.addBytes(nout * (quantize ? sizeof(ploidyverse::QuantizedProb) : sizeof(double)));
+
+  if(quantize){
+    RawVector out(no_init((R_xlen_t)nout * sizeof(ploidyverse::QuantizedProb)));
+    ploidyverse::acnToGenoBatch(probarray.begin(), ploidy, nsamples,
+                                alleleCols.begin(), nalleles.begin(),
+                                nalleles.size(),
+                                reinterpret_cast<ploidyverse::QuantizedProb*>(RAW(out)),
+                                nthreads);
+    return out;
+  }
+  NumericVector out(no_init((R_xlen_t)nout));
+  ploidyverse::acnToGenoBatch(probarray.begin(), ploidy, nsamples,
+                              alleleCols.begin(), nalleles.begin(),
+                              nalleles.size(), out.begin(), nthreads);
+  return out;
+}
+
+// Allele copy number probabilities from multiallelic genotype probabilities.
+// genoprobs is flat as output by acnToGenoBatch, either numeric or quantized.
+// Output is a (ploidy + 1) x nsamples x nAlleleCols array; any allele column
+// not listed in alleleCols is NA.
+// [[Rcpp::export]]
+NumericVector genoToAcnBatch(SEXP genoprobs, int ploidy, int nsamples,
+                             IntegerVector alleleCols, IntegerVector nalleles,
+                             int nAlleleCols, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_GENO_TO_ACN, ploidy, 0);
+  double nin = checkConvertArgs(ploidy, nsamples, alleleCols, nalleles,
+                                nAlleleCols);
+  if(nin != probCount(genoprobs)){
+    stop("Length of genoprobs does not match nalleles and nsamples.");
+  }
+
+  timer.addLoci(nalleles.begin(), nalleles.size());
+  timer.addBytes((ploidy + 1.0) * nsamples * nAlleleCols * sizeof(double));
+  NumericVector out((R_xlen_t)(ploidy + 1) * nsamples * nAlleleCols, NA_REAL);
+  out.attr("dim") = IntegerVector::create(ploidy + 1, nsamples, nAlleleCols);
+  if(TYPEOF(genoprobs) == RAWSXP){
+    ploidyverse::genoToAcnBatch(quantizedPointer(genoprobs), ploidy, nsamples,
+                                alleleCols.begin(), nalleles.begin(),
+                                nalleles.size(), out.begin(), nthreads);
+  } else {
+    ploidyverse::genoToAcnBatch(REAL(genoprobs), ploidy, nsamples,
+                                alleleCols.begin(), nalleles.begin(),
+                                nalleles.size(), out.begin(), nthreads);
+  }
+  return out;
+}
+
+// GT and GN from flat genotype probabilities (as output by acnToGenoBatch,
+// numeric or quantized) for every sample and locus.  Returns GTindex, the
+// zero-based index in VCF order of the most probable genotype, as a nsamples x
+// nloci matrix; GT, its alleles, as a ploidy x nsamples x nloci array;
+// GTstring, e.g. "0/0/1/2", as a nsamples x nloci matrix; and GN, flat with
+// nalleles - 1 values per sample and locus.
+// [[Rcpp::export]]
+List genotypeCallsBatch(SEXP genoprobs, int ploidy, int nsamples,
+                        IntegerVector nalleles, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_GENOTYPE_CALLS, ploidy, 0);
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nsamples < 0) stop("Number of samples cannot be negative.");
+  int nloci = nalleles.size();
+  double nin = 0;
+  R_xlen_t nalt = 0;
+  for(int L = 0; L < nloci; L++){
+    if(nalleles[L] == NA_INTEGER || nalleles[L] < 1){
+      stop("Each locus must have at least one allele.");
+    }
+    if(!ploidyverse::canRankGenotypes(ploidy, nalleles[L]) ||
+       ploidyverse::countGenotypes(ploidy, nalleles[L]) > (unsigned long long)INT_MAX){
+      stop("Too many genotypes for this ploidy and number of alleles.");
+    }
+    nin += (double)ploidyverse::countGenotypes(ploidy, nalleles[L]) * nsamples;
+    nalt += nalleles[L] - 1;
+  }
+  if(nin != probCount(genoprobs)){
+    stop("Length of genoprobs does not match nalleles and nsamples.");
+  }
+  R_xlen_t ncells = (R_xlen_t)nsamples * nloci;
+  R_xlen_t ngn = nalt * nsamples;
+  timer.addLoci(nalleles.begin(), nloci);
+  timer.addBytes((double)ncells * (ploidy + 1) * sizeof(int) +
+                 (double)ngn * sizeof(double));
+
+  IntegerVector index(no_init(ncells));
+  IntegerVector gt(no_init(ncells * ploidy));
+  NumericVector gn(no_init(ngn));
+  if(TYPEOF(genoprobs) == RAWSXP){
+    ploidyverse::genotypeCallsBatch(quantizedPointer(genoprobs), ploidy, nsamples,
+                                    nalleles.begin(), nloci, NA_INTEGER,
+                                    index.begin(), gt.begin(), gn.begin(), nthreads);
+  } else {
+    ploidyverse::genotypeCallsBatch(REAL(genoprobs), ploidy, nsamples,
+                                    nalleles.begin(), nloci, NA_INTEGER,
+                                    index.begin(), gt.begin(), gn.begin(), nthreads);
+  }
+  for(R_xlen_t i = 0; i < gn.size(); i++){
+    if(std::isnan(gn[i])) gn[i] = NA_REAL;
+  }
+
+  // genotype strings, made once for each number of alleles and then shared
+  std::map<int, CharacterVector> strings;
+  for(int L = 0; L < nloci; L++){
+    int nal = nalleles[L];
+    if(strings.find(nal) != strings.end()) continue;
+    ploidyverse::GenotypeTable tab = ploidyverse::genotypeTable(ploidy, nal);
+    CharacterVector s(tab.ngen);
+    std::string buf;
+    for(int g = 0; g < tab.ngen; g++){
+      buf.clear();
+      for(int i = 0; i < ploidy; i++){
+        if(i > 0) buf += '/';
+        buf += std::to_string(tab.row(g)[i]);
+      }
+      SET_STRING_ELT(s, g, Rf_mkChar(buf.c_str()));
+    }
+    strings[nal] = s;
+  }
+  CharacterVector gtstring(ncells);
+  for(int L = 0; L < nloci; L++){
+    SEXP s = strings[nalleles[L]];
+    for(int j = 0; j < nsamples; j++){
+      R_xlen_t cell = (R_xlen_t)L * nsamples + j;
+      SET_STRING_ELT(gtstring, cell, index[cell] == NA_INTEGER ? NA_STRING :
+                       STRING_ELT(s, index[cell]));
+    }
+  }
+
+  index.attr("dim") = IntegerVector::create(nsamples, nloci);
+  gt.attr("dim") = IntegerVector::create(ploidy, nsamples, nloci);
+  gtstring.attr("dim") = IntegerVector::create(nsamples, nloci);
+  return List::create(Named("GTindex") = index, Named("GT") = gt,
+                      Named("GTstring") = gtstring, Named("GN") = gn);
+}
@@ -0,0 +1,41 @@
+#include <Rcpp.h>
+#include <cmath>
+#include "ploidyverse/quantized_gp.h"
+#include "ploidyverse/ragged_array.h"
+using namespace Rcpp;
+
+// Quantized genotype probabilities are held in R as raw vectors with two
+// bytes per value, in the native byte order.
+
+// Quantize a ragged array of probabilities, where cell i has values
+// offsets[i] to offsets[i + 1] - 1, rounding each cell to sum to one.
+// [[Rcpp::export]]
+RawVector quantizeRaggedProbs(NumericVector values, NumericVector offsets,
+                              int nthreads = 1){
+  if(offsets.size() < 1 ||
+     !ploidyverse::validRaggedOffsets(offsets.begin(), offsets.size() - 1,
+                                      values.size())){
+    stop("offsets must increase from zero to the number of values.");
+  }
+  RawVector out(no_init(values.size() * sizeof(ploidyverse::QuantizedProb)));
+  ploidyverse::quantizeRagged(values.begin(), offsets.begin(), offsets.size() - 1,
+                              reinterpret_cast<ploidyverse::QuantizedProb*>(RAW(out)),
+                              nthreads);
+  return out;
+}
+
+// Probabilities from quantized values, with NA for missing.
+// [[Rcpp::export]]
+NumericVector dequantizeProbs(RawVector values, int nthreads = 1){
+  if(values.size() % sizeof(ploidyverse::QuantizedProb) != 0){
+    stop("Quantized probabilities must have an even number of bytes.");
+  }
+  R_xlen_t n = values.size() / sizeof(ploidyverse::QuantizedProb);
+  NumericVector out(no_init(n));
+  ploidyverse::dequantize(reinterpret_cast<const ploidyverse::QuantizedProb*>(RAW(values)),
+                          n, out.begin(), nthreads);
+  for(R_xlen_t i = 0; i < n; i++){
+    if(std::isnan(out[i])) out[i] = NA_REAL;
+  }
+  return out;
+}
@@ -0,0 +1,128 @@
+#include <Rcpp.h>
+#include "ploidyverse/ragged_array.h"
+using namespace Rcpp;
+
+// Conversion between matrix-lists (one R vector per cell) and ragged arrays
+// (one buffer of values plus offsets).
+
+// Zero-copy view of a ragged array held in R vectors.
+template <typename T>
+ploidyverse::RaggedView<T> raggedView(const T* values, NumericVector offsets,
+                                      int nrow, int ncol){
+  ploidyverse::RaggedView<T> out;
+  out.values = values;
+  out.offsets = offsets.begin();
+  out.nrow = nrow;
+  out.ncol = ncol;
+  return out;
+}
+
+// Pack a matrix-list with loci in rows and samples in columns into a ragged
+// array.  Values are integer if every cell is integer or logical, and
+// otherwise numeric.  Pointers to the cells are collected first, and then
+// the values are copied in parallel.
+// [[Rcpp::export]]
+List raggedFromMatrixList(List mat, int nthreads = 1){
+  IntegerVector dim = mat.attr("dim");
+  if(dim.size() != 2) stop("mat must be a matrix-list.");
+  int nrow = dim[0];
+  int ncol = dim[1];
+  std::size_t ncells = (std::size_t)nrow * ncol;
+
+  std::vector<std::size_t> lengths(ncells);
+  std::vector<SEXP> cells(ncells);
+  bool isint = true;
+  for(int r = 0; r < nrow; r++){
+    for(int c = 0; c < ncol; c++){
+      SEXP x = VECTOR_ELT(mat, r + (R_xlen_t)c * nrow);
+      int type = TYPEOF(x);
+      if(type == REALSXP){
+        isint = false;
+      } else if(type != INTSXP && type != LGLSXP && type != NILSXP){
+        stop("Cells of mat must be numeric, integer, logical, or NULL.");
+      }
+      cells[(std::size_t)r * ncol + c] = x;
+      lengths[(std::size_t)r * ncol + c] = type == NILSXP ? 0 : XLENGTH(x);
+    }
+  }
+  NumericVector offsets(no_init(ncells + 1));
+  ploidyverse::raggedOffsets(lengths.data(), ncells, offsets.begin());
+  R_xlen_t nvalues = offsets[ncells];
+
+  if(isint){
+    IntegerVector values(no_init(nvalues));
+    std::vector<const int*> src(ncells);
+    for(std::size_t i = 0; i < ncells; i++){
+      src[i] = lengths[i] == 0 ? NULL :
+        (TYPEOF(cells[i]) == LGLSXP ? LOGICAL(cells[i]) : INTEGER(cells[i]));
+    }
+    ploidyverse::packRagged(src.data(), offsets.begin(), ncells, values.begin(),
+                            nthreads);
+    return List::create(Named("values") = values, Named("offsets") = offsets);
+  }
+
+  // numeric; any integer cells are converted first, keeping NA as NA
+  NumericVector values(no_init(nvalues));
+  std::vector<const double*> src(ncells);
+  std::vector<std::vector<double> > converted;
+  for(std::size_t i = 0; i < ncells; i++){
+    if(lengths[i] == 0){
+      src[i] = NULL;
+    } else if(TYPEOF(cells[i]) == REALSXP){
+      src[i] = REAL(cells[i]);
+    } else {
+      const int* x = TYPEOF(cells[i]) == LGLSXP ? LOGICAL(cells[i]) : INTEGER(cells[i]);
+      converted.push_back(std::vector<double>(lengths[i]));
+      for(std::size_t k = 0; k < lengths[i]; k++){
+        converted.back()[k] = x[k] == NA_INTEGER ? NA_REAL : x[k];
+      }
+      src[i] = NULL;
+    }
+  }
+  // point at the converted copies once the outer vector has stopped growing
+  std::size_t conv = 0;
+  for(std::size_t i = 0; i < ncells; i++){
+    if(src[i] == NULL && lengths[i] > 0) src[i] = converted[conv++].data();
+  }
+  ploidyverse::packRagged(src.data(), offsets.begin(), ncells, values.begin(),
+                          nthreads);
+  return List::create(Named("values") = values, Named("offsets") = offsets);
+}
+
+template <int RTYPE>
+List raggedToMatrixListTyped(Vector<RTYPE> values, NumericVector offsets,
+                             int nrow, int ncol){
+  typedef typename traits::storage_type<RTYPE>::type T;
+  ploidyverse::RaggedView<T> view = raggedView<T>(values.begin(), offsets,
+                                                  nrow, ncol);
+  List out((R_xlen_t)nrow * ncol);
+  for(int r = 0; r < nrow; r++){
+    for(int c = 0; c < ncol; c++){
+      const T* start = view.cell(r, c);
+      out[r + (R_xlen_t)c * nrow] = Vector<RTYPE>(start, start + view.length(r, c));
+    }
+  }
+  out.attr("dim") = IntegerVector::create(nrow, ncol);
+  return out;
+}
+
+// Unpack a ragged array into a matrix-list with loci in rows and samples in
+// columns.  values may be integer or numeric.
+// [[Rcpp::export]]
+List raggedToMatrixList(SEXP values, NumericVector offsets, int nrow, int ncol){
+  if(offsets.size() != (R_xlen_t)nrow * ncol + 1){
+    stop("Length of offsets must be one more than the number of cells.");
+  }
+  if(!ploidyverse::validRaggedOffsets(offsets.begin(), offsets.size() - 1,
+                                      Rf_xlength(values))){
+    stop("offsets must increase from zero to the number of values.");
+  }
+  switch(TYPEOF(values)){
+  case INTSXP:
+    return raggedToMatrixListTyped<INTSXP>(values, offsets, nrow, ncol);
+  case REALSXP:
+    return raggedToMatrixListTyped<REALSXP>(values, offsets, nrow, ncol);
+  default:
+    stop("values must be integer or numeric.");
+  }
+}
@@ -0,0 +1,117 @@
+#include <Rcpp.h>
+#include "ploidyverse/instrumentation.h"
+#include "ploidyverse/selfing_kernels.h"
+using namespace Rcpp;
+
+// Sparse selfing operator for inbreeding-population priors.
+
+static void checkSelfingArgs(int ploidy, int nalleles){
+  if(ploidy < 2 || ploidy % 2 != 0) stop("Ploidy must be a positive even number.");
+  if(nalleles < 1) stop("Number of alleles must be at least 1.");
+  if(!ploidyverse::canRankGenotypes(ploidy, nalleles - 1)){
+    stop("Too many genotypes for this ploidy and number of alleles.");
+  }
+}
+
+// Selfing matrix in compressed sparse row form, as a list with zero-based
+// row pointers (p), zero-based column indices (j), values (x), and the
+// dimensions, i.e. the slots of a Matrix dgRMatrix.  With generations above
+// one, the matrix is raised to that power.  Matrices are cached for each
+// ploidy, number of alleles, and number of generations.
+// [[Rcpp::export]]
+List selfingMatrixCSR(int ploidy, int nalleles, int generations = 1,
+                      int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_SELFING_MATRIX_CSR,
+                                 ploidy, nalleles);
+  checkSelfingArgs(ploidy, nalleles);
+  if(generations < 0) stop("Number of generations cannot be negative.");
+  std::shared_ptr<const ploidyverse::SparseMatrix> mat =
+    ploidyverse::selfingMatrixCSR(ploidy, nalleles, generations, nthreads);
+  if(mat->nnz() > (std::size_t)INT_MAX){
+    stop("Too many non-zero values for a sparse matrix in R.");
+  }
+
+  timer.addBytes((double)mat->nnz() * (sizeof(int) + sizeof(double)) +
+                 (mat->nrow + 1.0) * sizeof(int));
+  IntegerVector p(mat->nrow + 1);
+  for(int i = 0; i <= mat->nrow; i++){
+    p[i] = (int)mat->rowptr[i];
+  }
+  IntegerVector j(mat->col.begin(), mat->col.end());
+  NumericVector x(mat->val.begin(), mat->val.end());
+  return List::create(Named("p") = p, Named("j") = j, Named("x") = x,
+                      Named("Dim") = IntegerVector::create(mat->nrow, mat->ncol));
+}
+
+// Genotype frequencies after one generation of self-fertilization.  freq is
+// a vector of genotype frequencies in VCF order, or a matrix with one such
+// vector per column.  The selfing matrix is never built; each parent genotype's
+// row is computed as needed.
+// [[Rcpp::export]]
+NumericVector applySelfing(NumericVector freq, int ploidy, int nalleles,
+                           int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_APPLY_SELFING,
+                                 ploidy, nalleles);
+  checkSelfingArgs(ploidy, nalleles);
+  unsigned long long ngen = ploidyverse::countGenotypes(ploidy, nalleles);
+  if(ngen > INT_MAX) stop("Too many genotypes for this ploidy and number of alleles.");
+  if(freq.size() % ngen != 0 || freq.size() == 0){
+    stop("Length of freq must be a multiple of the number of genotypes.");
+  }
+  int ncol = freq.size() / ngen;
+
+  NumericVector out(no_init(freq.size()));
+  timer.addBytes((double)freq.size() * sizeof(double));
+  out.attr("dim") = freq.attr("dim");
+  out.attr("dimnames") = freq.attr("dimnames");
+  ploidyverse::applySelfingOnTheFly(freq.begin(), ncol, ploidy, nalleles,
+                                    out.begin(), nthreads);
+  return out;
+}
+
+// Genotype frequencies after each of several numbers of generations of
+// self-fertilization.  freq is as in applySelfing.  For a vector, the output
+// is a matrix with one column per generation count; for a matrix, it is a
+// three-dimensional array with generation counts in the third dimension.
+// [[Rcpp::export]]
+NumericVector selfingGenerations(NumericVector freq, int ploidy, int nalleles,
+                                 IntegerVector generations, int nthreads = 1){
+  ploidyverse::KernelTimer timer(ploidyverse::KERNEL_SELFING_GENERATIONS,
+                                 ploidy, nalleles);
+  checkSelfingArgs(ploidy, nalleles);
+  unsigned long long ngen = ploidyverse::countGenotypes(ploidy, nalleles);
+  if(ngen > INT_MAX) stop("Too many genotypes for this ploidy and number of alleles.");
+  if(freq.size() % ngen != 0 || freq.size() == 0){
+    stop("Length of freq must be a multiple of the number of genotypes.");
+  }
+  int ncol = freq.size() / ngen;
+  int ngens = generations.size();
+  if(ngens == 0) stop("At least one number of generations is needed.");
+  CharacterVector gennames(ngens);
+  for(int g = 0; g < ngens; g++){
+    if(generations[g] == NA_INTEGER || generations[g] < 0){
+      stop("Numbers of generations must be non-negative.");
+    }
+    gennames[g] = "S" + std::to_string(generations[g]);
+  }
+
+  NumericVector out(no_init(freq.size() * ngens));
+  timer.addBytes((double)freq.size() * ngens * sizeof(double));
+  if(Rf_isNull(freq.attr("dim"))){
+    out.attr("dim") = IntegerVector::create((int)ngen, ngens);
+    out.attr("dimnames") = List::create(freq.attr("names"), gennames);
+  } else {
+    out.attr("dim") = IntegerVector::create((int)ngen, ncol, ngens);
+    List dimnames = List::create(R_NilValue, R_NilValue, gennames);
+    if(!Rf_isNull(freq.attr("dimnames"))){
+      List fdn = freq.attr("dimnames");
+      dimnames[0] = fdn[0];
+      dimnames[1] = fdn[1];
+    }
+    out.attr("dimnames") = dimnames;
+  }
+  ploidyverse::selfingGenerationsInto(freq.begin(), ncol, ploidy, nalleles,
+                                      generations.begin(), ngens, out.begin(),
+                                      nthreads);
+  return out;
+}
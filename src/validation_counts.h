@@ -0,0 +1,24 @@
+#ifndef PLOIDYVERSE_VALIDATION_COUNTS_H
+#define PLOIDYVERSE_VALIDATION_COUNTS_H
+
+// Counts from checking VCF records, named as expected by .validityFromChecks.
+// Shared by vcfValidateFile and vcfCacheInfo.
+
+#include <Rcpp.h>
+#include "vcf_validator.h"
+
+inline Rcpp::NumericVector validationCounts(const ploidyverse::VcfValidation& v){
+  using Rcpp::Named;
+  return Rcpp::NumericVector::create(Named("loci") = (double)v.nloci,
+                                     Named("malformed") = (double)v.malformed,
+                                     Named("GT_checked") = (double)v.gtChecked,
+                                     Named("GT_invalid") = (double)v.gtInvalid,
+                                     Named("GT_not_argmax") = (double)v.gtArgmax,
+                                     Named("AD_checked") = (double)v.adChecked,
+                                     Named("AD_length") = (double)v.adLength,
+                                     Named("GP_checked") = (double)v.gpChecked,
+                                     Named("GP_length") = (double)v.gpLength,
+                                     Named("GP_sum") = (double)v.gpSum);
+}
+
+#endif
@@ -0,0 +1,175 @@
+#include <Rcpp.h>
+#include "validation_counts.h"
+#include "vcf_cache.h"
+using namespace Rcpp;
+
+// Building, opening, and reading binary caches of VCFs.  An open cache is held
+// in an external pointer and unmapped when it is garbage collected, or earlier
+// with vcfCacheClose.
+
+// Tag for cache handles, checked as for readers in vcf_reader.cpp.
+SEXP vcfCacheTag(){
+  return Rf_install("ploidyverse::VcfCache");
+}
+
+void checkVcfCache(SEXP cache){
+  if(TYPEOF(cache) != EXTPTRSXP || R_ExternalPtrTag(cache) != vcfCacheTag()){
+    stop("Not a VCF cache.");
+  }
+}
+
+ploidyverse::VcfCache* getVcfCache(SEXP cache){
+  checkVcfCache(cache);
+  XPtr<ploidyverse::VcfCache> ptr(cache);
+  if(ptr.get() == NULL) stop("VCF cache has been closed.");
+  return ptr.get();
+}
+
+// Parse a VCF (plain or gzipped) into a cache file, storing the FORMAT fields
+// listed in fields along with the counts from checking every record as in
+// vcfValidateFile.  Records are read, checked, and written nloci at a time.
+// [[Rcpp::export]]
+void vcfCacheBuild(std::string file, std::string cache, int ploidy,
+                   CharacterVector fields, bool quantizeGP = false,
+                   double tolerance = 0.01, int nloci = 10000, int nthreads = 1){
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nloci < 1) stop("nloci must be at least 1.");
+  if(!(tolerance >= 0)) stop("tolerance must be non-negative.");
+  std::vector<int> fieldIndex;
+  for(R_xlen_t i = 0; i < fields.size(); i++){
+    std::string f = as<std::string>(fields[i]);
+    int index = ploidyverse::vcfFieldIndex(f.c_str(), f.size());
+    if(index < 0) stop("Field " + f + " cannot be cached; use GT, AD, GP, GN, or PS.");
+    fieldIndex.push_back(index);
+  }
+  ploidyverse::VcfReader reader(file, ploidy, fieldIndex, NA_INTEGER, NA_REAL,
+                                nthreads);
+  ploidyverse::VcfValidation validation;
+  ploidyverse::buildVcfCache(reader, cache, nloci, tolerance, quantizeGP, nthreads,
+                             validation);
+}
+
+// Memory-map a cache made by vcfCacheBuild.
+// [[Rcpp::export]]
+SEXP vcfCacheOpen(std::string cache){
+  XPtr<ploidyverse::VcfCache> ptr(new ploidyverse::VcfCache(cache), true,
+                                  vcfCacheTag());
+  return ptr;
+}
+
+// Dimensions, fields, sample names, and header lines of an open cache, with
+// the validation results in the same form as from vcfValidateFile.
+// [[Rcpp::export]]
+List vcfCacheInfo(SEXP cache){
+  ploidyverse::VcfCache* vc = getVcfCache(cache);
+  std::vector<std::string> fields;
+  for(int f = 0; f < ploidyverse::VCF_NFIELDS; f++){
+    if(vc->hasField(f)) fields.push_back(ploidyverse::vcfFieldName(f));
+  }
+  std::size_t mismatches;
+  ploidyverse::VcfValidation result = vc->validation(mismatches);
+  std::vector<std::string> chroms(result.chroms.begin(), result.chroms.end());
+  return List::create(Named("nloci") = (double)vc->nloci(),
+                      Named("ploidy") = vc->ploidy(),
+                      Named("fields") = wrap(fields),
+                      Named("quantizeGP") = vc->gpQuantized(),
+                      Named("samples") = wrap(vc->samples()),
+                      Named("header") = wrap(vc->headerLines()),
+                      Named("chroms") = wrap(chroms),
+                      Named("hasAD") = result.hasAD,
+                      Named("hasGP") = result.hasGP,
+                      Named("counts") = validationCounts(result),
+                      Named("mismatches") = (double)mismatches);
+}
+
+// Read the given loci and samples (1-based indices, in any order) from an
+// open cache, in the same form as from vcfReadChunk.  Only the pages of the
+// file holding the requested values are read.
+// [[Rcpp::export]]
+List vcfCacheRead(SEXP cache, NumericVector loci, IntegerVector samples,
+                  CharacterVector fields, int nthreads = 1){
+  ploidyverse::VcfCache* vc = getVcfCache(cache);
+  const int n = loci.size();
+  const int nsam = samples.size();
+  std::vector<std::size_t> L(n);
+  for(int i = 0; i < n; i++){
+    if(!(loci[i] >= 1 && loci[i] <= (double)vc->nloci())) stop("Locus index out of range.");
+    L[i] = (std::size_t)loci[i] - 1;
+  }
+  std::vector<int> S(nsam);
+  for(int j = 0; j < nsam; j++){
+    if(samples[j] == NA_INTEGER || samples[j] < 1 || samples[j] > (int)vc->nsamples()){
+      stop("Sample index out of range.");
+    }
+    S[j] = samples[j] - 1;
+  }
+  std::vector<int> want;
+  for(R_xlen_t i = 0; i < fields.size(); i++){
+    std::string f = as<std::string>(fields[i]);
+    int index = ploidyverse::vcfFieldIndex(f.c_str(), f.size());
+    if(index < 0 || !vc->hasField(index)) stop("Field " + f + " is not in the cache.");
+    want.push_back(index);
+  }
+
+  CharacterVector chrom(n), id(n), ref(n), alt(n);
+  IntegerVector pos(n), nalleles(n);
+  for(int i = 0; i < n; i++){
+    chrom[i] = vc->chrom(L[i]);
+    pos[i] = vc->pos(L[i]);
+    id[i] = vc->id(L[i]);
+    ref[i] = vc->ref(L[i]);
+    alt[i] = vc->alt(L[i]);
+    nalleles[i] = vc->nalleles(L[i]);
+  }
+  List out = List::create(Named("CHROM") = chrom, Named("POS") = pos,
+                          Named("ID") = id, Named("REF") = ref, Named("ALT") = alt,
+                          Named("nalleles") = nalleles);
+
+  for(std::size_t k = 0; k < want.size(); k++){
+    const int f = want[k];
+    const int sec = ploidyverse::vcfCacheFieldSection(f);
+    ploidyverse::VcfCacheColumn col = vc->column(sec, L.data(), n);
+    const std::size_t total = col.total * nsam;
+    if(f == ploidyverse::VCF_PS){
+      IntegerMatrix ps(n, nsam);
+      ploidyverse::gatherVcfCacheMatrix<int, std::int32_t>(col, S.data(), nsam, ps.begin());
+      out.push_back(ps, "PS");
+      continue;
+    }
+    if(f == ploidyverse::VCF_GP && vc->gpQuantized()){
+      RawVector gp(no_init(total * sizeof(ploidyverse::QuantizedProb)));
+      ploidyverse::gatherVcfCache(col, S.data(), nsam, RAW(gp), nthreads);
+      out.push_back(gp, "GP");
+    } else if(f == ploidyverse::VCF_GP || f == ploidyverse::VCF_GN){
+      NumericVector values(no_init(total));
+      ploidyverse::gatherVcfCache(col, S.data(), nsam, REAL(values), nthreads);
+      out.push_back(values, ploidyverse::vcfFieldName(f));
+    } else if(f == ploidyverse::VCF_AD){
+      IntegerVector ad(no_init(total));
+      ploidyverse::gatherVcfCache(col, S.data(), nsam, INTEGER(ad), nthreads);
+      out.push_back(ad, "AD");
+    } else {
+      IntegerVector gt(no_init(total));
+      ploidyverse::gatherVcfCache(col, S.data(), nsam, INTEGER(gt), nthreads);
+      gt.attr("dim") = IntegerVector::create(vc->ploidy(), nsam, n);
+      out.push_back(gt, "GT");
+      ploidyverse::VcfCacheColumn ph = vc->column(ploidyverse::CACHE_PHASED, L.data(), n);
+      LogicalMatrix phased(n, nsam);
+      ploidyverse::gatherVcfCacheMatrix<int, std::uint8_t>(ph, S.data(), nsam,
+                                                           phased.begin());
+      out.push_back(phased, "phased");
+    }
+  }
+  return out;
+}
+
+// Unmap the file now rather than waiting for garbage collection.
+// [[Rcpp::export]]
+void vcfCacheClose(SEXP cache){
+  checkVcfCache(cache);
+  XPtr<ploidyverse::VcfCache> ptr(cache);
+  if(ptr.get() != NULL){
+    delete ptr.get();
+    R_ClearExternalPtr(cache);
+  }
+}
@@ -0,0 +1,668 @@
+#ifndef PLOIDYVERSE_VCF_CACHE_H
+#define PLOIDYVERSE_VCF_CACHE_H
+
+// A binary cache of the parsed records of a ploidyverse VCF.  It is built once
+// by streaming through the text, and afterwards memory-mapped, so that opening
+// it only reads a small index, and reading a subset of loci or samples only
+// touches the pages that hold them.
+//
+// The file begins with a fixed header, followed by blocks of loci as read by
+// VcfReader, then sections describing the whole file (header lines, samples,
+// and the counts from validateVcfRecord), then an index giving the offset and
+// size in bytes of every section.  Within a block each column is contiguous:
+// the fixed VCF columns, the number of alleles, running totals of alleles and
+// genotypes over loci, and each genotype field, with values varying fastest,
+// then samples, then loci, as in VcfChunk.  A list of n strings is stored as
+// n, then n + 1 byte offsets, then the characters.  Numbers are in the byte
+// order of the machine that built the cache; missing integers and reals are
+// the NA values given to the reader.  GP may be stored as doubles or quantized
+// (see quantized_gp.h).
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "ploidyverse/genotype_tables.h"
+#include "ploidyverse/quantized_gp.h"
+#include "ploidyverse/threads.h"
+#include "vcf_reader.h"
+#include "vcf_validator.h"
+
+namespace ploidyverse {
+
+static const char vcfCacheMagic[8] = {'P', 'V', 'C', 'A', 'C', 'H', 'E', '\0'};
+static const std::uint32_t vcfCacheVersion = 1;
+static const std::uint32_t vcfCacheByteOrder = 0x01020304;
+static const std::size_t vcfCacheAlign = 64;
+
+// Columns stored for each block of loci.
+enum VcfCacheSection {
+  CACHE_CHROM = 0, CACHE_POS, CACHE_ID, CACHE_REF, CACHE_ALT, CACHE_NALLELES,
+  CACHE_ALLELE_TOTALS, CACHE_GENOTYPE_TOTALS, CACHE_GT, CACHE_PHASED, CACHE_AD,
+  CACHE_GP, CACHE_GN, CACHE_PS, CACHE_NSECTIONS
+};
+
+// Sections stored once for the whole file.
+enum VcfCacheGlobal {
+  CACHE_HEADER_LINES = 0, CACHE_SAMPLES, CACHE_CHROMS, CACHE_VALIDATION,
+  CACHE_NGLOBALS
+};
+
+static const std::size_t vcfCacheValidationCounts = 16;
+
+struct VcfCacheHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint64_t nloci;
+  std::uint64_t nblocks;
+  std::uint64_t indexOffset;
+  std::uint32_t nsamples;
+  std::int32_t ploidy;
+  std::uint32_t fields;      // bit f is set if VcfField f is stored
+  std::uint32_t gpQuantized;
+  std::uint32_t reserved[2];
+};
+
+struct VcfCacheSpan {
+  std::uint64_t offset;
+  std::uint64_t size;
+};
+
+struct VcfCacheBlock {
+  std::uint64_t nloci;
+  std::uint64_t reserved;
+  VcfCacheSpan sections[CACHE_NSECTIONS];
+};
+
+// Section of the genotype field f.
+inline int vcfCacheFieldSection(int f){
+  static const int sections[VCF_NFIELDS] = {CACHE_GT, CACHE_AD, CACHE_GP,
+                                            CACHE_GN, CACHE_PS};
+  return sections[f];
+}
+
+// Writes a cache one block of loci at a time.  The header is only written by
+// finish(), so an unfinished file is never mistaken for a cache.
+class VcfCacheWriter {
+public:
+  VcfCacheWriter(const std::string& file, int ploidy, std::size_t nsamples,
+                 std::uint32_t fields, bool gpQuantized)
+    : offset_(0) {
+    std::memset(&header_, 0, sizeof(header_));
+    header_.version = vcfCacheVersion;
+    header_.byteOrder = vcfCacheByteOrder;
+    header_.nsamples = nsamples;
+    header_.ploidy = ploidy;
+    header_.fields = fields;
+    header_.gpQuantized = gpQuantized;
+    fp_ = std::fopen(file.c_str(), "wb");
+    if(fp_ == NULL) throw std::runtime_error("Unable to open " + file + " for writing.");
+    write(&header_, sizeof(header_));
+    pad();
+  }
+
+  ~VcfCacheWriter(){
+    if(fp_ != NULL) std::fclose(fp_);
+  }
+
+  // Write one block.  gpq holds the quantized GP if the cache stores it that
+  // way, and is otherwise ignored.
+  void writeBlock(const VcfChunk& chunk, const std::vector<QuantizedProb>& gpq){
+    const std::size_t n = chunk.nloci;
+    VcfCacheBlock block;
+    std::memset(&block, 0, sizeof(block));
+    block.nloci = n;
+    std::vector<std::uint64_t> alleles(n + 1, 0);
+    std::vector<std::uint64_t> genotypes(n + 1, 0);
+    for(std::size_t L = 0; L < n; L++){
+      alleles[L + 1] = alleles[L] + chunk.nalleles[L];
+      genotypes[L + 1] = genotypes[L] + countGenotypes(header_.ploidy, chunk.nalleles[L]);
+    }
+    block.sections[CACHE_CHROM] = writeStrings(chunk.chrom);
+    block.sections[CACHE_POS] = writeVector(chunk.pos);
+    block.sections[CACHE_ID] = writeStrings(chunk.id);
+    block.sections[CACHE_REF] = writeStrings(chunk.ref);
+    block.sections[CACHE_ALT] = writeStrings(chunk.alt);
+    block.sections[CACHE_NALLELES] = writeVector(chunk.nalleles);
+    block.sections[CACHE_ALLELE_TOTALS] = writeVector(alleles);
+    block.sections[CACHE_GENOTYPE_TOTALS] = writeVector(genotypes);
+    if(stores(VCF_GT)){
+      std::vector<std::uint8_t> phased(chunk.phased.begin(), chunk.phased.end());
+      block.sections[CACHE_GT] = writeVector(chunk.gt);
+      block.sections[CACHE_PHASED] = writeVector(phased);
+    }
+    if(stores(VCF_AD)) block.sections[CACHE_AD] = writeVector(chunk.ad);
+    if(stores(VCF_GP)){
+      block.sections[CACHE_GP] = header_.gpQuantized ? writeVector(gpq) :
+        writeVector(chunk.gp);
+    }
+    if(stores(VCF_GN)) block.sections[CACHE_GN] = writeVector(chunk.gn);
+    if(stores(VCF_PS)) block.sections[CACHE_PS] = writeVector(chunk.ps);
+    blocks_.push_back(block);
+    header_.nloci += n;
+  }
+
+  // Write the sections for the whole file, the index, and the header, and
+  // close the file.
+  void finish(const std::vector<std::string>& headerLines,
+              const std::vector<std::string>& samples,
+              const VcfValidation& validation, std::size_t mismatches){
+    VcfCacheSpan globals[CACHE_NGLOBALS];
+    globals[CACHE_HEADER_LINES] = writeStrings(headerLines);
+    globals[CACHE_SAMPLES] = writeStrings(samples);
+    globals[CACHE_CHROMS] =
+      writeStrings(std::vector<std::string>(validation.chroms.begin(),
+                                            validation.chroms.end()));
+    std::vector<std::uint64_t> counts(vcfCacheValidationCounts, 0);
+    counts[0] = validation.nloci;
+    counts[1] = validation.malformed;
+    counts[2] = validation.gpChecked;
+    counts[3] = validation.gpLength;
+    counts[4] = validation.gpSum;
+    counts[5] = validation.adChecked;
+    counts[6] = validation.adLength;
+    counts[7] = validation.gtChecked;
+    counts[8] = validation.gtInvalid;
+    counts[9] = validation.gtArgmax;
+    counts[10] = validation.hasAD;
+    counts[11] = validation.hasGP;
+    counts[12] = mismatches;
+    globals[CACHE_VALIDATION] = writeVector(counts);
+
+    header_.nblocks = blocks_.size();
+    header_.indexOffset = offset_;
+    write(globals, sizeof(globals));
+    if(!blocks_.empty()) write(&blocks_[0], blocks_.size() * sizeof(VcfCacheBlock));
+    std::memcpy(header_.magic, vcfCacheMagic, sizeof(vcfCacheMagic));
+    if(std::fflush(fp_) != 0 || std::fseek(fp_, 0, SEEK_SET) != 0){
+      throw std::runtime_error("Error writing cache.");
+    }
+    write(&header_, sizeof(header_));
+    int err = std::fclose(fp_);
+    fp_ = NULL;
+    if(err != 0) throw std::runtime_error("Error writing cache.");
+  }
+
+private:
+  VcfCacheWriter(const VcfCacheWriter&);
+  VcfCacheWriter& operator=(const VcfCacheWriter&);
+
+  bool stores(int field) const { return (header_.fields >> field) & 1; }
+
+  void write(const void* data, std::size_t size){
+    if(size > 0 && std::fwrite(data, 1, size, fp_) != size){
+      throw std::runtime_error("Error writing cache.");
+    }
+    offset_ += size;
+  }
+
+  // Pad to the next multiple of vcfCacheAlign, so that every section is
+  // aligned for its type once mapped.
+  void pad(){
+    static const char zeros[vcfCacheAlign] = {0};
+    write(zeros, (vcfCacheAlign - offset_ % vcfCacheAlign) % vcfCacheAlign);
+  }
+
+  template <typename T>
+  VcfCacheSpan writeVector(const std::vector<T>& x){
+    VcfCacheSpan span = {offset_, x.size() * sizeof(T)};
+    if(!x.empty()) write(&x[0], span.size);
+    pad();
+    return span;
+  }
+
+  VcfCacheSpan writeStrings(const std::vector<std::string>& x){
+    std::vector<std::uint64_t> offsets(x.size() + 2, 0);
+    offsets[0] = x.size();
+    for(std::size_t i = 0; i < x.size(); i++){
+      offsets[i + 2] = offsets[i + 1] + x[i].size();
+    }
+    VcfCacheSpan span = {offset_, offsets.size() * sizeof(std::uint64_t) + offsets.back()};
+    write(&offsets[0], offsets.size() * sizeof(std::uint64_t));
+    for(std::size_t i = 0; i < x.size(); i++) write(x[i].data(), x[i].size());
+    pad();
+    return span;
+  }
+
+  std::FILE* fp_;
+  std::uint64_t offset_;
+  VcfCacheHeader header_;
+  std::vector<VcfCacheBlock> blocks_;
+};
+
+// Build a cache from the remaining records of a VCF, reading blockLoci lines at
+// a time.  Each block is checked in parallel as in validateVcf, with the
+// counts added to validation and stored in the cache, then parsed.  If
+// quantizeGP is true, GP is stored quantized.
+inline void buildVcfCache(VcfReader& reader, const std::string& file,
+                          std::size_t blockLoci, double tolerance, bool quantizeGP,
+                          int nthreads, VcfValidation& validation){
+  const int ploidy = reader.ploidy();
+  const int nsam = reader.samples().size();
+  std::uint32_t fields = 0;
+  for(int f = 0; f < VCF_NFIELDS; f++) if(reader.wants(f)) fields |= 1u << f;
+  quantizeGP = quantizeGP && reader.wants(VCF_GP);
+  VcfCacheWriter writer(file, ploidy, nsam, fields, quantizeGP);
+
+  std::vector<std::string> lines;
+  VcfChunk chunk;
+  std::vector<QuantizedProb> gpq;
+  std::vector<double> offsets;
+  std::size_t n;
+  while((n = reader.readLines(blockLoci, lines)) > 0){
+    validateVcfLines(lines, n, ploidy, nsam, tolerance, nthreads, validation);
+    reader.parseLines(lines, n, chunk);
+    if(quantizeGP){
+      offsets.assign((std::size_t)n * nsam + 1, 0);
+      for(std::size_t L = 0; L < n; L++){
+        double ngen = countGenotypes(ploidy, chunk.nalleles[L]);
+        for(int s = 0; s < nsam; s++){
+          std::size_t cell = L * nsam + s;
+          offsets[cell + 1] = offsets[cell] + ngen;
+        }
+      }
+      gpq.resize(chunk.gp.size());
+      quantizeRagged(chunk.gp.data(), offsets.data(), offsets.size() - 1, gpq.data(),
+                     nthreads);
+    }
+    writer.writeBlock(chunk, gpq);
+  }
+  writer.finish(reader.headerLines(), reader.samples(), validation,
+                reader.mismatches());
+}
+
+// A read-only memory-mapped file.
+class MappedFile {
+public:
+  explicit MappedFile(const std::string& file) : data_(NULL), size_(0) {
+#ifdef _WIN32
+    handle_ = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(handle_ == INVALID_HANDLE_VALUE) throw std::runtime_error("Unable to open " + file);
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(handle_, &size) || size.QuadPart == 0){
+      CloseHandle(handle_);
+      throw std::runtime_error("Unable to map " + file);
+    }
+    size_ = size.QuadPart;
+    mapping_ = CreateFileMappingA(handle_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(mapping_ != NULL){
+      data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    }
+    if(data_ == NULL){
+      if(mapping_ != NULL) CloseHandle(mapping_);
+      CloseHandle(handle_);
+      throw std::runtime_error("Unable to map " + file);
+    }
+#else
+    int fd = open(file.c_str(), O_RDONLY);
+    if(fd < 0) throw std::runtime_error("Unable to open " + file);
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size == 0){
+      close(fd);
+      throw std::runtime_error("Unable to map " + file);
+    }
+    size_ = st.st_size;
+    void* p = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED) throw std::runtime_error("Unable to map " + file);
+    data_ = static_cast<const char*>(p);
+#endif
+  }
+
+  ~MappedFile(){
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    CloseHandle(handle_);
+#else
+    munmap(const_cast<char*>(data_), size_);
+#endif
+  }
+
+  const char* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+
+  const char* data_;
+  std::size_t size_;
+#ifdef _WIN32
+  HANDLE handle_;
+  HANDLE mapping_;
+#endif
+};
+
+// Where the values of one genotype field are, for a selection of loci.  Each
+// sample has width[i] values at locus i, starting at data[i], each of
+// elementSize bytes; total is the sum of width.
+struct VcfCacheColumn {
+  std::size_t elementSize;
+  std::size_t total;
+  std::vector<const char*> data;
+  std::vector<std::size_t> width;
+};
+
+// A cache opened for reading.  Opening checks the header and the index, so
+// that every later read can be checked against the sizes of the sections.
+class VcfCache {
+public:
+  explicit VcfCache(const std::string& file) : map_(file) {
+    const char* base = map_.data();
+    const std::size_t size = map_.size();
+    if(size < sizeof(VcfCacheHeader)) throw notCache(file);
+    std::memcpy(&header_, base, sizeof(header_));
+    if(std::memcmp(header_.magic, vcfCacheMagic, sizeof(vcfCacheMagic)) != 0){
+      throw notCache(file);
+    }
+    if(header_.version != vcfCacheVersion){
+      throw std::runtime_error(file + " was made by another version of ploidyverseVcf.");
+    }
+    if(header_.byteOrder != vcfCacheByteOrder){
+      throw std::runtime_error(file + " was made on a machine with another byte order.");
+    }
+    const std::uint64_t indexSize = sizeof(VcfCacheSpan) * CACHE_NGLOBALS +
+      sizeof(VcfCacheBlock) * header_.nblocks;
+    if(header_.nblocks > size || header_.indexOffset > size ||
+       indexSize > size - header_.indexOffset){
+      throw corrupt();
+    }
+    std::memcpy(globals_, base + header_.indexOffset, sizeof(globals_));
+    blocks_.resize(header_.nblocks);
+    if(header_.nblocks > 0){
+      std::memcpy(&blocks_[0], base + header_.indexOffset + sizeof(globals_),
+                  sizeof(VcfCacheBlock) * header_.nblocks);
+    }
+    for(int g = 0; g < CACHE_NGLOBALS; g++) checkSpan(globals_[g]);
+    stringCount(globals_[CACHE_HEADER_LINES]);
+    stringCount(globals_[CACHE_SAMPLES]);
+    stringCount(globals_[CACHE_CHROMS]);
+    if(globals_[CACHE_VALIDATION].size !=
+       vcfCacheValidationCounts * sizeof(std::uint64_t)){
+      throw corrupt();
+    }
+
+    const std::uint64_t nsam = header_.nsamples;
+    const std::uint64_t ploidy = header_.ploidy;
+    if(header_.ploidy < 1) throw corrupt();
+    start_.assign(1, 0);
+    for(std::size_t b = 0; b < blocks_.size(); b++){
+      const VcfCacheBlock& block = blocks_[b];
+      const std::uint64_t n = block.nloci;
+      for(int k = 0; k < CACHE_NSECTIONS; k++) checkSpan(block.sections[k]);
+      if(block.sections[CACHE_POS].size != n * 4 ||
+         block.sections[CACHE_NALLELES].size != n * 4 ||
+         block.sections[CACHE_ALLELE_TOTALS].size != (n + 1) * 8 ||
+         block.sections[CACHE_GENOTYPE_TOTALS].size != (n + 1) * 8){
+        throw corrupt();
+      }
+      const int strings[4] = {CACHE_CHROM, CACHE_ID, CACHE_REF, CACHE_ALT};
+      for(int k = 0; k < 4; k++){
+        if(stringCount(block.sections[strings[k]]) != n) throw corrupt();
+      }
+      const std::uint64_t alleles =
+        section<std::uint64_t>(b, CACHE_ALLELE_TOTALS)[n];
+      const std::uint64_t genotypes =
+        section<std::uint64_t>(b, CACHE_GENOTYPE_TOTALS)[n];
+      const std::uint64_t expected[CACHE_NSECTIONS] = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        n * nsam * ploidy * 4, n * nsam, alleles * nsam * 4,
+        genotypes * nsam * (header_.gpQuantized ? 2 : 8),
+        (alleles - n) * nsam * 8, n * nsam * 4};
+      for(int f = 0; f < VCF_NFIELDS; f++){
+        int k = vcfCacheFieldSection(f);
+        std::uint64_t want = hasField(f) ? expected[k] : 0;
+        if(block.sections[k].size != want) throw corrupt();
+        if(f == VCF_GT && block.sections[CACHE_PHASED].size !=
+           (hasField(f) ? expected[CACHE_PHASED] : 0)) throw corrupt();
+      }
+      start_.push_back(start_.back() + n);
+    }
+    if(start_.back() != header_.nloci) throw corrupt();
+  }
+
+  std::size_t nloci() const { return header_.nloci; }
+  std::size_t nsamples() const { return header_.nsamples; }
+  int ploidy() const { return header_.ploidy; }
+  bool hasField(int field) const { return (header_.fields >> field) & 1; }
+  bool gpQuantized() const { return header_.gpQuantized != 0; }
+
+  std::vector<std::string> headerLines() const { return globalStrings(CACHE_HEADER_LINES); }
+  std::vector<std::string> samples() const { return globalStrings(CACHE_SAMPLES); }
+
+  // Validation counts stored when the cache was built, and the number of
+  // sample values that the reader set to missing because their count did not
+  // match.
+  VcfValidation validation(std::size_t& mismatches) const {
+    const std::uint64_t* counts = reinterpret_cast<const std::uint64_t*>(
+      map_.data() + globals_[CACHE_VALIDATION].offset);
+    VcfValidation out;
+    out.nloci = counts[0];
+    out.malformed = counts[1];
+    out.gpChecked = counts[2];
+    out.gpLength = counts[3];
+    out.gpSum = counts[4];
+    out.adChecked = counts[5];
+    out.adLength = counts[6];
+    out.gtChecked = counts[7];
+    out.gtInvalid = counts[8];
+    out.gtArgmax = counts[9];
+    out.hasAD = counts[10] != 0;
+    out.hasGP = counts[11] != 0;
+    mismatches = counts[12];
+    std::vector<std::string> chroms = globalStrings(CACHE_CHROMS);
+    out.chroms.insert(chroms.begin(), chroms.end());
+    return out;
+  }
+
+  // Fixed columns of locus L, which must be less than nloci().
+  std::string chrom(std::size_t L) const { return stringColumn(CACHE_CHROM, L); }
+  std::string id(std::size_t L) const { return stringColumn(CACHE_ID, L); }
+  std::string ref(std::size_t L) const { return stringColumn(CACHE_REF, L); }
+  std::string alt(std::size_t L) const { return stringColumn(CACHE_ALT, L); }
+
+  int pos(std::size_t L) const {
+    std::size_t b, i;
+    locate(L, b, i);
+    return section<std::int32_t>(b, CACHE_POS)[i];
+  }
+
+  int nalleles(std::size_t L) const {
+    std::size_t b, i;
+    locate(L, b, i);
+    return section<std::int32_t>(b, CACHE_NALLELES)[i];
+  }
+
+  // Locate the values of a genotype section (CACHE_GT, CACHE_PHASED,
+  // CACHE_AD, CACHE_GP, CACHE_GN, or CACHE_PS) at each of n loci, checking
+  // that they lie within the section.  The section must be stored.
+  VcfCacheColumn column(int sec, const std::size_t* loci, std::size_t n) const {
+    VcfCacheColumn out;
+    out.elementSize = elementSize(sec);
+    out.total = 0;
+    out.data.resize(n);
+    out.width.resize(n);
+    const std::uint64_t nsam = header_.nsamples;
+    for(std::size_t j = 0; j < n; j++){
+      std::size_t b, i;
+      locate(loci[j], b, i);
+      const std::uint64_t* alleles = section<std::uint64_t>(b, CACHE_ALLELE_TOTALS);
+      const std::uint64_t* genotypes = section<std::uint64_t>(b, CACHE_GENOTYPE_TOTALS);
+      const std::uint64_t nal = alleles[i + 1] - alleles[i];
+      if(alleles[i + 1] < alleles[i] || genotypes[i + 1] < genotypes[i] || nal < 1 ||
+         (int)nal != section<std::int32_t>(b, CACHE_NALLELES)[i]){
+        throw corrupt();
+      }
+      std::uint64_t first, width;
+      switch(sec){
+      case CACHE_GT:
+        width = header_.ploidy;
+        first = i * width * nsam;
+        break;
+      case CACHE_AD:
+        width = nal;
+        first = alleles[i] * nsam;
+        break;
+      case CACHE_GP:
+        width = genotypes[i + 1] - genotypes[i];
+        first = genotypes[i] * nsam;
+        if(width != countGenotypes(header_.ploidy, nal)) throw corrupt();
+        break;
+      case CACHE_GN:
+        width = nal - 1;
+        first = (alleles[i] - i) * nsam;
+        break;
+      default: // one value per sample
+        width = 1;
+        first = i * nsam;
+        break;
+      }
+      const VcfCacheSpan& span = blocks_[b].sections[sec];
+      if((first + width * nsam) * out.elementSize > span.size) throw corrupt();
+      out.data[j] = map_.data() + span.offset + first * out.elementSize;
+      out.width[j] = width;
+      out.total += width;
+    }
+    return out;
+  }
+
+private:
+  VcfCache(const VcfCache&);
+  VcfCache& operator=(const VcfCache&);
+
+  static std::runtime_error notCache(const std::string& file){
+    return std::runtime_error(file + " is not a ploidyverse VCF cache.");
+  }
+
+  static std::runtime_error corrupt(){
+    return std::runtime_error("VCF cache is damaged or incomplete.");
+  }
+
+  void checkSpan(const VcfCacheSpan& span) const {
+    if(span.offset > map_.size() || span.size > map_.size() - span.offset){
+      throw corrupt();
+    }
+  }
+
+  std::size_t elementSize(int sec) const {
+    switch(sec){
+    case CACHE_PHASED: return 1;
+    case CACHE_GP: return header_.gpQuantized ? 2 : 8;
+    case CACHE_GN: return 8;
+    default: return 4;
+    }
+  }
+
+  template <typename T>
+  const T* section(std::size_t block, int sec) const {
+    return reinterpret_cast<const T*>(map_.data() + blocks_[block].sections[sec].offset);
+  }
+
+  void locate(std::size_t L, std::size_t& block, std::size_t& index) const {
+    if(L >= header_.nloci) throw std::runtime_error("Locus index out of range.");
+    block = std::upper_bound(start_.begin(), start_.end(), L) - start_.begin() - 1;
+    index = L - start_[block];
+  }
+
+  // Number of strings in a string section, checking that it fits.
+  std::uint64_t stringCount(const VcfCacheSpan& span) const {
+    if(span.size < 16) throw corrupt();
+    const std::uint64_t n =
+      *reinterpret_cast<const std::uint64_t*>(map_.data() + span.offset);
+    if(n > span.size / 8 - 2) throw corrupt();
+    return n;
+  }
+
+  // String i of a string section.
+  std::string stringAt(const VcfCacheSpan& span, std::size_t i) const {
+    const std::uint64_t* header =
+      reinterpret_cast<const std::uint64_t*>(map_.data() + span.offset);
+    const std::uint64_t n = header[0];
+    const std::uint64_t* offsets = header + 1;
+    const std::uint64_t chars = span.size - (n + 2) * 8;
+    if(offsets[i] > offsets[i + 1] || offsets[i + 1] > chars) throw corrupt();
+    const char* text = reinterpret_cast<const char*>(offsets + n + 1);
+    return std::string(text + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+
+  std::string stringColumn(int sec, std::size_t L) const {
+    std::size_t b, i;
+    locate(L, b, i);
+    return stringAt(blocks_[b].sections[sec], i);
+  }
+
+  std::vector<std::string> globalStrings(int g) const {
+    const std::uint64_t n = stringCount(globals_[g]);
+    std::vector<std::string> out(n);
+    for(std::size_t i = 0; i < n; i++) out[i] = stringAt(globals_[g], i);
+    return out;
+  }
+
+  MappedFile map_;
+  VcfCacheHeader header_;
+  VcfCacheSpan globals_[CACHE_NGLOBALS];
+  std::vector<VcfCacheBlock> blocks_;
+  std::vector<std::size_t> start_; // first locus of each block, then nloci
+};
+
+// Copy the values in col for the given samples into out, with values varying
+// fastest, then samples, then loci.  out has col.total * nsamples elements.
+// Parallel over loci.
+inline void gatherVcfCache(const VcfCacheColumn& col, const int* samples,
+                           std::size_t nsamples, void* out, int nthreads){
+  std::vector<std::size_t> dest(col.data.size() + 1, 0);
+  for(std::size_t j = 0; j < col.data.size(); j++){
+    dest[j + 1] = dest[j] + col.width[j] * nsamples * col.elementSize;
+  }
+  char* o = static_cast<char*>(out);
+  const long long nl = col.data.size();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(dynamic, 16)
+#endif
+  for(long long j = 0; j < nl; j++){
+    const std::size_t bytes = col.width[j] * col.elementSize;
+    for(std::size_t s = 0; s < nsamples; s++){
+      std::memcpy(o + dest[j] + s * bytes, col.data[j] + samples[s] * bytes, bytes);
+    }
+  }
+}
+
+// Copy a field with one value per sample (CACHE_PHASED or CACHE_PS) into a
+// loci x samples matrix in column-major order, converting to T.
+template <typename T, typename S>
+void gatherVcfCacheMatrix(const VcfCacheColumn& col, const int* samples,
+                          std::size_t nsamples, T* out){
+  const std::size_t nl = col.data.size();
+  for(std::size_t s = 0; s < nsamples; s++){
+    for(std::size_t j = 0; j < nl; j++){
+      S v;
+      std::memcpy(&v, col.data[j] + samples[s] * sizeof(S), sizeof(S));
+      out[j + s * nl] = v;
+    }
+  }
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_VCF_CACHE_H
@@ -0,0 +1,237 @@
+#ifndef PLOIDYVERSE_VCF_INDEX_H
+#define PLOIDYVERSE_VCF_INDEX_H
+
+// Tabix (.tbi) and CSI (.csi) indices of bgzipped VCFs, used to find the
+// parts of the file that may hold records overlapping a region without
+// reading the rest.  Both divide each sequence into a hierarchy of bins, the
+// smallest 2^minShift bases wide and each level eight times wider than the
+// one below, and list for each bin the chunks of the file (pairs of BGZF
+// virtual offsets) holding the records that fit in that bin and no smaller
+// one.  Tabix adds a linear index of the first record overlapping each
+// window of 2^14 bases; CSI stores the same thing for each bin.
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ploidyverse {
+
+struct BgzfChunk {
+  std::uint64_t begin;
+  std::uint64_t end;
+};
+
+inline bool operator<(const BgzfChunk& a, const BgzfChunk& b){
+  return a.begin < b.begin;
+}
+
+class VcfIndex {
+public:
+  // Load an index.  contigs gives the sequence names, in order, for a CSI
+  // index that does not store them, as from the ##contig header lines.
+  VcfIndex(const std::string& file, const std::vector<std::string>& contigs){
+    std::string d = readAll(file);
+    std::size_t p = 0;
+    int nref;
+    std::vector<std::string> names;
+    if(d.compare(0, 4, std::string("TBI\1", 4)) == 0){
+      csi_ = false;
+      minShift_ = 14;
+      depth_ = 5;
+      p = 4;
+      nref = int32(d, p);
+      names = tabixNames(d, p);
+      if((int)names.size() != nref) throw damaged();
+    } else if(d.compare(0, 4, std::string("CSI\1", 4)) == 0){
+      csi_ = true;
+      p = 4;
+      minShift_ = int32(d, p);
+      depth_ = int32(d, p);
+      int laux = int32(d, p);
+      if(minShift_ < 1 || depth_ < 0 || depth_ > 10 || minShift_ + 3 * depth_ > 62 ||
+         laux < 0 || (std::size_t)laux > d.size() - p) throw damaged();
+      if(laux >= 28){
+        std::size_t q = p;
+        names = tabixNames(d.substr(0, p + laux), q);
+      }
+      p += laux;
+      nref = int32(d, p);
+    } else {
+      throw std::runtime_error(file + " is not a tabix or CSI index.");
+    }
+    if(nref < 0) throw damaged();
+    if(names.empty()) names = contigs;
+    if((int)names.size() < nref){
+      throw std::runtime_error("Sequence names for the index were not found.");
+    }
+    const std::uint64_t maxBin = (((std::uint64_t)1 << (3 * (depth_ + 1))) - 1) / 7;
+    refs_.resize(nref);
+    for(int r = 0; r < nref; r++){
+      names_[names[r]] = r;
+      Reference& ref = refs_[r];
+      const int nbin = int32(d, p);
+      if(nbin < 0) throw damaged();
+      for(int b = 0; b < nbin; b++){
+        const std::uint32_t bin = int32(d, p);
+        Bin entry;
+        entry.loffset = csi_ ? uint64(d, p) : 0;
+        const int nchunk = int32(d, p);
+        if(nchunk < 0 || (std::size_t)nchunk > (d.size() - p) / 16) throw damaged();
+        entry.chunks.resize(nchunk);
+        for(int c = 0; c < nchunk; c++){
+          entry.chunks[c].begin = uint64(d, p);
+          entry.chunks[c].end = uint64(d, p);
+        }
+        // bins above maxBin hold metadata rather than records
+        if(bin <= maxBin) ref.bins[bin].swap(entry);
+      }
+      if(!csi_){
+        const int nintv = int32(d, p);
+        if(nintv < 0 || (std::size_t)nintv > (d.size() - p) / 8) throw damaged();
+        ref.linear.resize(nintv);
+        for(int i = 0; i < nintv; i++) ref.linear[i] = uint64(d, p);
+      }
+    }
+  }
+
+  // Chunks of the file that may hold records overlapping bases begin to
+  // end - 1 (counting from zero) of chrom, sorted with overlaps merged.
+  // Empty if chrom has no records.
+  std::vector<BgzfChunk> query(const std::string& chrom, std::int64_t begin,
+                               std::int64_t end) const {
+    std::vector<BgzfChunk> out;
+    std::map<std::string, int>::const_iterator name = names_.find(chrom);
+    if(name == names_.end()) return out;
+    const Reference& ref = refs_[name->second];
+    const std::int64_t maxPos = (std::int64_t)1 << (minShift_ + 3 * depth_);
+    if(begin < 0) begin = 0;
+    if(end > maxPos) end = maxPos;
+    if(end <= begin) return out;
+
+    // the first record that could overlap begin
+    std::uint64_t minOffset = 0;
+    if(csi_){
+      std::uint32_t bin = binAt(depth_, begin);
+      std::map<std::uint32_t, Bin>::const_iterator it;
+      while((it = ref.bins.find(bin)) == ref.bins.end() && bin > 0) bin = (bin - 1) >> 3;
+      if(it != ref.bins.end()) minOffset = it->second.loffset;
+    } else if(!ref.linear.empty()){
+      std::size_t i = begin >> minShift_;
+      minOffset = i < ref.linear.size() ? ref.linear[i] : ref.linear.back();
+    }
+
+    for(int level = 0; level <= depth_; level++){
+      const std::uint32_t first = binAt(level, begin);
+      const std::uint32_t last = binAt(level, end - 1);
+      std::map<std::uint32_t, Bin>::const_iterator it = ref.bins.lower_bound(first);
+      for(; it != ref.bins.end() && it->first <= last; ++it){
+        const std::vector<BgzfChunk>& chunks = it->second.chunks;
+        for(std::size_t c = 0; c < chunks.size(); c++){
+          if(chunks[c].end > minOffset) out.push_back(chunks[c]);
+        }
+      }
+    }
+    std::sort(out.begin(), out.end());
+    std::size_t n = 0;
+    for(std::size_t c = 0; c < out.size(); c++){
+      if(n > 0 && out[c].begin <= out[n - 1].end){
+        out[n - 1].end = std::max(out[n - 1].end, out[c].end);
+      } else {
+        out[n++] = out[c];
+      }
+    }
+    out.resize(n);
+    return out;
+  }
+
+private:
+  struct Bin {
+    std::uint64_t loffset;  // CSI only
+    std::vector<BgzfChunk> chunks;
+
+    void swap(Bin& x){
+      std::swap(loffset, x.loffset);
+      chunks.swap(x.chunks);
+    }
+  };
+
+  struct Reference {
+    std::map<std::uint32_t, Bin> bins;
+    std::vector<std::uint64_t> linear;  // tabix only
+  };
+
+  static std::runtime_error damaged(){
+    return std::runtime_error("VCF index is damaged or truncated.");
+  }
+
+  // Decompress a whole (BGZF-compressed) index into memory.
+  static std::string readAll(const std::string& file){
+    gzFile fp = gzopen(file.c_str(), "rb");
+    if(fp == NULL) throw std::runtime_error("Unable to open " + file);
+    std::string out;
+    char buf[1 << 16];
+    int n;
+    while((n = gzread(fp, buf, sizeof(buf))) > 0) out.append(buf, n);
+    gzclose(fp);
+    if(n < 0) throw damaged();
+    return out;
+  }
+
+  static std::uint64_t uint64(const std::string& d, std::size_t& p){
+    if(d.size() < 8 || p > d.size() - 8) throw damaged();
+    std::uint64_t x = 0;
+    for(int i = 7; i >= 0; i--) x = (x << 8) | (unsigned char)d[p + i];
+    p += 8;
+    return x;
+  }
+
+  static std::int32_t int32(const std::string& d, std::size_t& p){
+    if(d.size() < 4 || p > d.size() - 4) throw damaged();
+    std::uint32_t x = 0;
+    for(int i = 3; i >= 0; i--) x = (x << 8) | (unsigned char)d[p + i];
+    p += 4;
+    return (std::int32_t)x;
+  }
+
+  // Sequence names from the tabix configuration (format, the columns of the
+  // sequence, start, and end, the comment character, lines to skip, and the
+  // length of the names, each an int32), then the names, each ending in NUL.
+  static std::vector<std::string> tabixNames(const std::string& d, std::size_t& p){
+    for(int i = 0; i < 6; i++) int32(d, p);
+    const int len = int32(d, p);
+    if(len < 0 || (std::size_t)len > d.size() - p) throw damaged();
+    std::vector<std::string> out;
+    const std::size_t end = p + len;
+    while(p < end){
+      const char* s = d.data() + p;
+      const char* nul = static_cast<const char*>(std::memchr(s, '\0', end - p));
+      std::size_t n = nul == NULL ? end - p : nul - s;
+      out.push_back(std::string(s, n));
+      p += n + 1;
+    }
+    p = end;
+    return out;
+  }
+
+  // Bin at the given level containing a position.
+  std::uint32_t binAt(int level, std::int64_t pos) const {
+    const std::uint32_t first = (((std::uint64_t)1 << (3 * level)) - 1) / 7;
+    return first + (std::uint32_t)(pos >> (minShift_ + 3 * (depth_ - level)));
+  }
+
+  bool csi_;
+  int minShift_;
+  int depth_;
+  std::map<std::string, int> names_;
+  std::vector<Reference> refs_;
+};
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_VCF_INDEX_H
@@ -0,0 +1,149 @@
+#include <Rcpp.h>
+#include "ploidyverse/quantized_gp.h"
+#include "vcf_reader.h"
+using namespace Rcpp;
+
+// Streaming access to the genotype fields of a VCF, one block of loci at a
+// time.  The reader is held in an external pointer and closed when it is
+// garbage collected, or earlier with vcfReaderClose.
+
+// Readers are tagged when opened, so that any other external pointer passed
+// as one, such as a writer or cache, is refused rather than dereferenced.
+SEXP vcfReaderTag(){
+  return Rf_install("ploidyverse::VcfReader");
+}
+
+void checkVcfReader(SEXP reader){
+  if(TYPEOF(reader) != EXTPTRSXP || R_ExternalPtrTag(reader) != vcfReaderTag()){
+    stop("Not a VCF reader.");
+  }
+}
+
+ploidyverse::VcfReader* getVcfReader(SEXP reader){
+  checkVcfReader(reader);
+  XPtr<ploidyverse::VcfReader> ptr(reader);
+  if(ptr.get() == NULL) stop("VCF reader has been closed.");
+  return ptr.get();
+}
+
+// Transpose per-sample scalars (samples varying fastest, then loci) into a
+// loci x samples matrix.
+template <int RTYPE, typename T>
+Matrix<RTYPE> lociBySamples(const std::vector<T>& x, int nloci, int nsamples){
+  Matrix<RTYPE> out(nloci, nsamples);
+  for(int L = 0; L < nloci; L++){
+    for(int s = 0; s < nsamples; s++){
+      out(L, s) = x[(std::size_t)L * nsamples + s];
+    }
+  }
+  return out;
+}
+
+// Open a VCF (plain or gzipped) for reading the FORMAT fields listed in
+// fields, any of "GT", "AD", "GP", "GN", and "PS".  ploidy is used to size
+// GT and GP.  A bgzipped file is decompressed with nthreads threads.
+// [[Rcpp::export]]
+SEXP vcfReaderOpen(std::string file, int ploidy, CharacterVector fields,
+                   int nthreads = 1){
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  std::vector<int> fieldIndex;
+  for(R_xlen_t i = 0; i < fields.size(); i++){
+    std::string f = as<std::string>(fields[i]);
+    int index = ploidyverse::vcfFieldIndex(f.c_str(), f.size());
+    if(index < 0) stop("Field " + f + " cannot be read; use GT, AD, GP, GN, or PS.");
+    fieldIndex.push_back(index);
+  }
+  XPtr<ploidyverse::VcfReader>
+    ptr(new ploidyverse::VcfReader(file, ploidy, fieldIndex, NA_INTEGER, NA_REAL,
+                                   nthreads),
+        true, vcfReaderTag());
+  return ptr;
+}
+
+// Restrict an open bgzipped VCF to the records of chrom overlapping positions
+// start to end, using a tabix or CSI index.  Reading continues from the
+// start of the region.
+// [[Rcpp::export]]
+void vcfReaderSetRegion(SEXP reader, std::string index, std::string chrom,
+                        double start, double end){
+  if(!(start >= 1) || !(end >= start)) stop("Invalid region.");
+  ploidyverse::VcfReader* vcf = getVcfReader(reader);
+  vcf->setRegion(index, chrom, (long long)start, (long long)std::min(end, 9e18));
+}
+
+// Sample names and ## header lines of an open VCF.
+// [[Rcpp::export]]
+List vcfReaderInfo(SEXP reader){
+  ploidyverse::VcfReader* vcf = getVcfReader(reader);
+  return List::create(Named("samples") = wrap(vcf->samples()),
+                      Named("header") = wrap(vcf->headerLines()),
+                      Named("mismatches") = (double)vcf->mismatches());
+}
+
+// Read the next block of up to nloci loci.  Returns the fixed columns and the
+// number of alleles at each locus, along with the requested fields.  GT is an
+// allele x sample x locus integer array, with a loci x samples logical matrix
+// "phased"; PS is a loci x samples integer matrix; AD, GP, and GN are flat
+// vectors with values varying fastest, then samples, then loci; if quantizeGP
+// is true, GP is returned as quantized probabilities in a raw vector.  At the
+// end of the file, zero loci are returned.
+// [[Rcpp::export]]
+List vcfReadChunk(SEXP reader, int nloci, bool quantizeGP = false){
+  if(nloci < 1) stop("nloci must be at least 1.");
+  ploidyverse::VcfReader* vcf = getVcfReader(reader);
+  ploidyverse::VcfChunk chunk;
+  vcf->readChunk(nloci, chunk);
+  int n = chunk.nloci;
+  int nsam = vcf->samples().size();
+
+  List out = List::create(Named("CHROM") = wrap(chunk.chrom),
+                          Named("POS") = wrap(chunk.pos),
+                          Named("ID") = wrap(chunk.id),
+                          Named("REF") = wrap(chunk.ref),
+                          Named("ALT") = wrap(chunk.alt),
+                          Named("nalleles") = wrap(chunk.nalleles));
+  if(vcf->wants(ploidyverse::VCF_GT)){
+    IntegerVector gt(chunk.gt.begin(), chunk.gt.end());
+    gt.attr("dim") = IntegerVector::create(vcf->ploidy(), nsam, n);
+    out.push_back(gt, "GT");
+    out.push_back(lociBySamples<LGLSXP>(chunk.phased, n, nsam), "phased");
+  }
+  if(vcf->wants(ploidyverse::VCF_AD)){
+    out.push_back(IntegerVector(chunk.ad.begin(), chunk.ad.end()), "AD");
+  }
+  if(vcf->wants(ploidyverse::VCF_GP) && quantizeGP){
+    std::vector<double> offsets((std::size_t)n * nsam + 1, 0);
+    for(int L = 0; L < n; L++){
+      double ngen = ploidyverse::countGenotypes(vcf->ploidy(), chunk.nalleles[L]);
+      for(int s = 0; s < nsam; s++){
+        std::size_t cell = (std::size_t)L * nsam + s;
+        offsets[cell + 1] = offsets[cell] + ngen;
+      }
+    }
+    RawVector gp(no_init(chunk.gp.size() * sizeof(ploidyverse::QuantizedProb)));
+    ploidyverse::quantizeRagged(chunk.gp.data(), offsets.data(), offsets.size() - 1,
+                                reinterpret_cast<ploidyverse::QuantizedProb*>(RAW(gp)),
+                                1);
+    out.push_back(gp, "GP");
+  } else if(vcf->wants(ploidyverse::VCF_GP)){
+    out.push_back(NumericVector(chunk.gp.begin(), chunk.gp.end()), "GP");
+  }
+  if(vcf->wants(ploidyverse::VCF_GN)){
+    out.push_back(NumericVector(chunk.gn.begin(), chunk.gn.end()), "GN");
+  }
+  if(vcf->wants(ploidyverse::VCF_PS)){
+    out.push_back(lociBySamples<INTSXP>(chunk.ps, n, nsam), "PS");
+  }
+  return out;
+}
+
+// Close the file now rather than waiting for garbage collection.
+// [[Rcpp::export]]
+void vcfReaderClose(SEXP reader){
+  checkVcfReader(reader);
+  XPtr<ploidyverse::VcfReader> ptr(reader);
+  if(ptr.get() != NULL){
+    delete ptr.get();
+    R_ClearExternalPtr(reader);
+  }
+}
@@ -0,0 +1,505 @@
+#ifndef PLOIDYVERSE_VCF_READER_H
+#define PLOIDYVERSE_VCF_READER_H
+
+// A streaming reader for the genotype fields of ploidyverse VCFs.  Records
+// are parsed a block of loci at a time, straight into flat typed buffers, so
+// that memory use depends on the block size rather than the file size.
+// Plain and gzipped files are read through zlib.  Bgzipped files are read
+// with BgzfReader, decompressing several blocks at once in parallel, and may
+// be restricted to the records overlapping a region using a tabix or CSI
+// index.
+//
+// Within a block, per-sample values are stored with values varying fastest,
+// then samples, then loci, as in the batch kernels and RaggedArray.  Each
+// sample has ploidy values for GT, nalleles for AD, nGen(ploidy, nalleles)
+// for GP, nalleles - 1 for GN, and one for PS.  Missing values, and samples
+// whose number of values does not match, are filled with the NA values given
+// to the reader.
+
+#include <zlib.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bgzf.h"
+#include "ploidyverse/genotype_tables.h"
+#include "vcf_index.h"
+
+namespace ploidyverse {
+
+enum VcfField { VCF_GT = 0, VCF_AD, VCF_GP, VCF_GN, VCF_PS, VCF_NFIELDS };
+
+inline const char* vcfFieldName(int field){
+  static const char* const names[VCF_NFIELDS] = {"GT", "AD", "GP", "GN", "PS"};
+  return names[field];
+}
+
+// Index of a FORMAT field by name, or -1 if the reader does not parse it.
+inline int vcfFieldIndex(const char* name, std::size_t len){
+  for(int f = 0; f < VCF_NFIELDS; f++){
+    if(std::strlen(vcfFieldName(f)) == len &&
+       std::strncmp(vcfFieldName(f), name, len) == 0) return f;
+  }
+  return -1;
+}
+
+// One block of loci.
+struct VcfChunk {
+  std::size_t nloci;
+  std::vector<std::string> chrom;
+  std::vector<int> pos;
+  std::vector<std::string> id;
+  std::vector<std::string> ref;
+  std::vector<std::string> alt;
+  std::vector<int> nalleles;
+  std::vector<int> gt;     // allele indices
+  std::vector<int> phased; // one per sample and locus, 0 or 1
+  std::vector<int> ad;
+  std::vector<double> gp;
+  std::vector<double> gn;
+  std::vector<int> ps;
+
+  VcfChunk() : nloci(0) {}
+
+  void clear(){
+    nloci = 0;
+    chrom.clear();
+    pos.clear();
+    id.clear();
+    ref.clear();
+    alt.clear();
+    nalleles.clear();
+    gt.clear();
+    phased.clear();
+    ad.clear();
+    gp.clear();
+    gn.clear();
+    ps.clear();
+  }
+};
+
+// Parse one number at p, which must not be at the end of the field.
+inline bool parseVcfValue(const char* p, int& out){
+  char* stop;
+  long v = std::strtol(p, &stop, 10);
+  out = (int)v;
+  return stop != p;
+}
+
+inline bool parseVcfValue(const char* p, double& out){
+  char* stop;
+  out = std::strtod(p, &stop);
+  return stop != p;
+}
+
+inline bool isVcfMissing(const char* begin, const char* end){
+  return begin == end || (end - begin == 1 && *begin == '.');
+}
+
+// Parse comma-separated values in [begin, end) into out, which has n values
+// already set to na.  "." is missing.  If the number of values is not n, all
+// are set to na and false is returned.
+template <typename T>
+bool parseVcfList(const char* begin, const char* end, T* out, std::size_t n, T na){
+  if(isVcfMissing(begin, end)) return true;
+  std::size_t count = 0;
+  for(const char* p = begin; p <= end; ){
+    const char* q = p;
+    while(q < end && *q != ',') q++;
+    T v;
+    if(count < n && q > p && !isVcfMissing(p, q) && parseVcfValue(p, v)){
+      out[count] = v;
+    }
+    count++;
+    p = q + 1;
+  }
+  if(count != n){
+    for(std::size_t i = 0; i < n; i++) out[i] = na;
+    return false;
+  }
+  return true;
+}
+
+// Parse a GT value such as 0/0/1/2 or 0|1 into ploidy allele indices, already
+// set to na.  If the number of alleles is not the ploidy, all are set to na
+// and false is returned.
+inline bool parseVcfGenotype(const char* begin, const char* end, int* out,
+                             int ploidy, int na, int* phased){
+  *phased = 0;
+  if(isVcfMissing(begin, end)) return true;
+  int count = 0;
+  for(const char* p = begin; p <= end; ){
+    const char* q = p;
+    while(q < end && *q != '/' && *q != '|') q++;
+    if(q < end && *q == '|') *phased = 1;
+    int v;
+    if(count < ploidy && q > p && !isVcfMissing(p, q) && parseVcfValue(p, v)){
+      out[count] = v;
+    }
+    count++;
+    p = q + 1;
+  }
+  if(count != ploidy){
+    for(int i = 0; i < ploidy; i++) out[i] = na;
+    return false;
+  }
+  return true;
+}
+
+class VcfReader {
+public:
+  // fields lists the VcfField values to parse.  nthreads is the number of
+  // threads for decompressing bgzipped files.  Throws std::runtime_error if
+  // the file cannot be opened or has no #CHROM line.
+  VcfReader(const std::string& file, int ploidy, const std::vector<int>& fields,
+            int naInteger, double naReal, int nthreads = 1)
+    : ploidy_(ploidy), naInteger_(naInteger), naReal_(naReal),
+      eof_(false), lineNumber_(0), mismatches_(0), gz_(NULL), bgzf_(NULL),
+      index_(NULL), region_(false) {
+    for(int f = 0; f < VCF_NFIELDS; f++) want_[f] = false;
+    for(std::size_t i = 0; i < fields.size(); i++) want_[fields[i]] = true;
+    if(BgzfReader::isBgzf(file)){
+      bgzf_ = new BgzfReader(file, nthreads);
+    } else {
+      gz_ = gzopen(file.c_str(), "rb");
+      if(gz_ == NULL) throw std::runtime_error("Unable to open " + file);
+      gzbuffer(gz_, 1 << 17);
+    }
+    try {
+      readHeader();
+    } catch(...) {
+      close();
+      throw;
+    }
+  }
+
+  ~VcfReader(){
+    close();
+  }
+
+  const std::vector<std::string>& headerLines() const { return header_; }
+  const std::vector<std::string>& samples() const { return samples_; }
+  int ploidy() const { return ploidy_; }
+  bool wants(int field) const { return want_[field]; }
+  bool eof() const { return eof_; }
+  // number of sample values whose count did not match what was expected
+  std::size_t mismatches() const { return mismatches_; }
+
+  // Read up to maxLoci records into out, replacing its contents.  Returns the
+  // number of loci read, which is zero at the end of the file.
+  std::size_t readChunk(std::size_t maxLoci, VcfChunk& out){
+    out.clear();
+    while(out.nloci < maxLoci && getLine(line_)){
+      if(line_.empty() || line_[0] == '#') continue;
+      parseRecord(line_, lineNumber_, out);
+    }
+    return out.nloci;
+  }
+
+  // Read up to maxLoci records as unparsed lines, so that they can be
+  // processed in parallel.  lines is grown as needed and its strings are
+  // reused; returns the number of lines filled.
+  std::size_t readLines(std::size_t maxLoci, std::vector<std::string>& lines){
+    std::size_t n = 0;
+    while(n < maxLoci && getLine(line_)){
+      if(line_.empty() || line_[0] == '#') continue;
+      if(n == lines.size()) lines.push_back(std::string());
+      lines[n].swap(line_);
+      n++;
+    }
+    return n;
+  }
+
+  // Restrict reading to the records of chrom that overlap positions start to
+  // end (counting from one, inclusive), using a tabix or CSI index.  The
+  // index is loaded once and kept for later regions.  Only the blocks of the
+  // file that the index lists for the region are read.
+  void setRegion(const std::string& indexFile, const std::string& chrom,
+                 long long start, long long end){
+    if(bgzf_ == NULL){
+      throw std::runtime_error("Regions can only be read from bgzipped files.");
+    }
+    if(index_ == NULL || indexFile != indexFile_){
+      VcfIndex* index = new VcfIndex(indexFile, contigs());
+      delete index_;
+      index_ = index;
+      indexFile_ = indexFile;
+    }
+    chunks_ = index_->query(chrom, start - 1, end);
+    region_ = true;
+    regionChrom_ = chrom;
+    regionStart_ = start;
+    regionEnd_ = end;
+    chunk_ = 0;
+    eof_ = chunks_.empty();
+    if(!eof_) bgzf_->seek(chunks_[0].begin);
+  }
+
+  // Parse the first n lines from readLines into out, replacing its contents.
+  // Line numbers in errors assume that there were no blank lines among them.
+  void parseLines(const std::vector<std::string>& lines, std::size_t n,
+                  VcfChunk& out){
+    out.clear();
+    for(std::size_t i = 0; i < n; i++){
+      parseRecord(lines[i], lineNumber_ - n + 1 + i, out);
+    }
+  }
+
+private:
+  VcfReader(const VcfReader&);
+  VcfReader& operator=(const VcfReader&);
+
+  void close(){
+    if(gz_ != NULL) gzclose(gz_);
+    delete bgzf_;
+    delete index_;
+    gz_ = NULL;
+    bgzf_ = NULL;
+    index_ = NULL;
+  }
+
+  // Read one line, without the newline, from the file, or within a region,
+  // the next record overlapping it.
+  bool getLine(std::string& line){
+    line.clear();
+    if(eof_) return false;
+    bool ok = region_ ? regionLine(line) : rawLine(line);
+    if(!ok){
+      eof_ = true;
+      return false;
+    }
+    lineNumber_++;
+    return true;
+  }
+
+  bool rawLine(std::string& line){
+    if(bgzf_ != NULL) return bgzf_->getLine(line);
+    bool end = false;
+    for(;;){
+      if(gzgets(gz_, buf_, sizeof(buf_)) == NULL){
+        int err;
+        gzerror(gz_, &err);
+        if(err != Z_OK && err != Z_STREAM_END){
+          throw std::runtime_error("Error decompressing VCF.");
+        }
+        end = true;
+        break;
+      }
+      std::size_t len = std::strlen(buf_);
+      line.append(buf_, len);
+      if(len > 0 && buf_[len - 1] == '\n') break;
+    }
+    if(!line.empty() && line[line.size() - 1] == '\n') line.resize(line.size() - 1);
+    if(!line.empty() && line[line.size() - 1] == '\r') line.resize(line.size() - 1);
+    return !(line.empty() && end);
+  }
+
+  // Read through the chunks listed by the index, skipping records that do not
+  // overlap the region.  Records are sorted, so reading stops at the first one
+  // past the end of the region.
+  bool regionLine(std::string& line){
+    for(;;){
+      if(chunk_ >= chunks_.size()) return false;
+      if(bgzf_->tell() >= chunks_[chunk_].end){
+        chunk_++;
+        if(chunk_ < chunks_.size() && bgzf_->tell() < chunks_[chunk_].begin){
+          bgzf_->seek(chunks_[chunk_].begin);
+        }
+        continue;
+      }
+      if(!bgzf_->getLine(line)) return false;
+      if(line.empty() || line[0] == '#') continue;
+      const std::size_t tab1 = line.find('\t');
+      if(tab1 == std::string::npos || line.compare(0, tab1, regionChrom_) != 0 ||
+         tab1 != regionChrom_.size()) continue;
+      const long long pos = std::atoll(line.c_str() + tab1 + 1);
+      if(pos > regionEnd_) return false;
+      // the record spans the length of REF, in the fourth column
+      std::size_t tab = tab1;
+      for(int col = 1; col < 3 && tab != std::string::npos; col++){
+        tab = line.find('\t', tab + 1);
+      }
+      if(tab == std::string::npos) return true; // malformed, for the parser to report
+      std::size_t refEnd = line.find('\t', tab + 1);
+      if(refEnd == std::string::npos) refEnd = line.size();
+      const long long len = refEnd - tab - 1;
+      if(pos + (len > 0 ? len : 1) - 1 >= regionStart_) return true;
+    }
+  }
+
+  // IDs from the ##contig header lines, in order.
+  std::vector<std::string> contigs() const {
+    std::vector<std::string> out;
+    const std::string prefix = "##contig=<ID=";
+    for(std::size_t i = 0; i < header_.size(); i++){
+      if(header_[i].compare(0, prefix.size(), prefix) != 0) continue;
+      std::size_t end = header_[i].find_first_of(",>", prefix.size());
+      if(end == std::string::npos) end = header_[i].size();
+      out.push_back(header_[i].substr(prefix.size(), end - prefix.size()));
+    }
+    return out;
+  }
+
+  void readHeader(){
+    while(getLine(line_)){
+      if(line_.compare(0, 2, "##") == 0){
+        header_.push_back(line_);
+      } else if(line_.compare(0, 6, "#CHROM") == 0){
+        std::size_t start = 0;
+        int col = 0;
+        while(start <= line_.size()){
+          std::size_t tab = line_.find('\t', start);
+          if(tab == std::string::npos) tab = line_.size();
+          if(col >= 9) samples_.push_back(line_.substr(start, tab - start));
+          col++;
+          start = tab + 1;
+        }
+        return;
+      } else {
+        break;
+      }
+    }
+    throw std::runtime_error("No #CHROM line found in VCF header.");
+  }
+
+  static std::runtime_error recordError(const char* msg, std::size_t lineNumber){
+    char num[32];
+    std::snprintf(num, sizeof(num), "%lu", (unsigned long)lineNumber);
+    return std::runtime_error(std::string(msg) + " on line " + num + " of VCF.");
+  }
+
+  void parseRecord(const std::string& line, std::size_t lineNumber, VcfChunk& out){
+    const int nsam = samples_.size();
+    const char* p = line.c_str();
+    const char* end = p + line.size();
+
+    // the eight fixed columns, then FORMAT
+    const char* col[9];
+    const char* colEnd[9];
+    int ncol = 0;
+    while(ncol < 9 && p <= end){
+      const char* q = p;
+      while(q < end && *q != '\t') q++;
+      col[ncol] = p;
+      colEnd[ncol] = q;
+      ncol++;
+      p = q + 1;
+    }
+    if(ncol < 8 || (nsam > 0 && ncol < 9)) throw recordError("Too few columns", lineNumber);
+
+    int nal = 1;
+    if(!(colEnd[4] - col[4] == 1 && *col[4] == '.')){
+      for(const char* c = col[4]; c < colEnd[4]; c++) if(*c == ',') nal++;
+      nal++;
+    }
+    const unsigned long long ngenl = countGenotypes(ploidy_, nal);
+    if(want_[VCF_GP] && ngenl > (unsigned long long)INT_MAX / (nsam > 0 ? nsam : 1)){
+      throw recordError("Too many genotypes for GP", lineNumber);
+    }
+    const std::size_t ngen = ngenl;
+
+    out.chrom.push_back(std::string(col[0], colEnd[0]));
+    out.pos.push_back(std::atoi(col[1]));
+    out.id.push_back(std::string(col[2], colEnd[2]));
+    out.ref.push_back(std::string(col[3], colEnd[3]));
+    out.alt.push_back(std::string(col[4], colEnd[4]));
+    out.nalleles.push_back(nal);
+    out.nloci++;
+
+    // pre-fill this locus with missing values
+    std::size_t gtStart = out.gt.size();
+    std::size_t phStart = out.phased.size();
+    std::size_t adStart = out.ad.size();
+    std::size_t gpStart = out.gp.size();
+    std::size_t gnStart = out.gn.size();
+    std::size_t psStart = out.ps.size();
+    if(want_[VCF_GT]){
+      out.gt.resize(gtStart + (std::size_t)ploidy_ * nsam, naInteger_);
+      out.phased.resize(phStart + nsam, 0);
+    }
+    if(want_[VCF_AD]) out.ad.resize(adStart + (std::size_t)nal * nsam, naInteger_);
+    if(want_[VCF_GP]) out.gp.resize(gpStart + ngen * nsam, naReal_);
+    if(want_[VCF_GN]) out.gn.resize(gnStart + (std::size_t)(nal - 1) * nsam, naReal_);
+    if(want_[VCF_PS]) out.ps.resize(psStart + nsam, naInteger_);
+    if(nsam == 0) return;
+
+    // which parsed field, if any, is at each position in FORMAT
+    keys_.clear();
+    for(const char* k = col[8]; k <= colEnd[8]; ){
+      const char* q = k;
+      while(q < colEnd[8] && *q != ':') q++;
+      int f = vcfFieldIndex(k, q - k);
+      keys_.push_back(f >= 0 && want_[f] ? f : -1);
+      k = q + 1;
+    }
+
+    for(int s = 0; s < nsam; s++){
+      if(p > end) throw recordError("Too few samples", lineNumber);
+      const char* q = p;
+      while(q < end && *q != '\t') q++;
+      const char* sub = p;
+      for(std::size_t k = 0; k < keys_.size() && sub <= q; k++){
+        const char* subEnd = sub;
+        while(subEnd < q && *subEnd != ':') subEnd++;
+        bool ok = true;
+        switch(keys_[k]){
+        case VCF_GT:
+          ok = parseVcfGenotype(sub, subEnd, &out.gt[gtStart + (std::size_t)s * ploidy_],
+                                ploidy_, naInteger_, &out.phased[phStart + s]);
+          break;
+        case VCF_AD:
+          ok = parseVcfList<int>(sub, subEnd, &out.ad[adStart + (std::size_t)s * nal],
+                                 nal, naInteger_);
+          break;
+        case VCF_GP:
+          ok = parseVcfList<double>(sub, subEnd, &out.gp[gpStart + s * ngen],
+                                    ngen, naReal_);
+          break;
+        case VCF_GN:
+          ok = nal < 2 ||
+            parseVcfList<double>(sub, subEnd, &out.gn[gnStart + (std::size_t)s * (nal - 1)],
+                                 nal - 1, naReal_);
+          break;
+        case VCF_PS:
+          ok = parseVcfList<int>(sub, subEnd, &out.ps[psStart + s], 1, naInteger_);
+          break;
+        default:
+          break;
+        }
+        if(!ok) mismatches_++;
+        sub = subEnd + 1;
+      }
+      p = q + 1;
+    }
+  }
+
+  int ploidy_;
+  int naInteger_;
+  double naReal_;
+  bool want_[VCF_NFIELDS];
+  bool eof_;
+  std::size_t lineNumber_;
+  std::size_t mismatches_;
+  std::vector<std::string> header_;
+  std::vector<std::string> samples_;
+  std::vector<int> keys_;
+  std::string line_;
+  char buf_[1 << 16];
+  gzFile gz_;
+  BgzfReader* bgzf_;
+  VcfIndex* index_;
+  std::string indexFile_;
+  bool region_;
+  std::string regionChrom_;
+  long long regionStart_;
+  long long regionEnd_;
+  std::vector<BgzfChunk> chunks_;
+  std::size_t chunk_;
+};
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_VCF_READER_H
@@ -0,0 +1,27 @@
+#include <Rcpp.h>
+#include "validation_counts.h"
+#include "vcf_validator.h"
+using namespace Rcpp;
+
+// Check every record of a VCF (plain or gzipped) without loading it, reading
+// nloci lines at a time and checking them in parallel.  Returns the header,
+// samples, chromosome names seen in the records, and counts of violations.
+// [[Rcpp::export]]
+List vcfValidateFile(std::string file, int ploidy, double tolerance = 0.01,
+                     int nloci = 10000, int nthreads = 1){
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  if(nloci < 1) stop("nloci must be at least 1.");
+  if(!(tolerance >= 0)) stop("tolerance must be non-negative.");
+  ploidyverse::VcfReader reader(file, ploidy, std::vector<int>(), NA_INTEGER,
+                                NA_REAL, nthreads);
+  ploidyverse::VcfValidation result;
+  ploidyverse::validateVcf(reader, nloci, tolerance, nthreads, result);
+
+  std::vector<std::string> chroms(result.chroms.begin(), result.chroms.end());
+  return List::create(Named("samples") = wrap(reader.samples()),
+                      Named("header") = wrap(reader.headerLines()),
+                      Named("chroms") = wrap(chroms),
+                      Named("hasAD") = result.hasAD,
+                      Named("hasGP") = result.hasGP,
+                      Named("counts") = validationCounts(result));
+}
@@ -0,0 +1,240 @@
+#ifndef PLOIDYVERSE_VCF_VALIDATOR_H
+#define PLOIDYVERSE_VCF_VALIDATOR_H
+
+// Record-level checks of ploidyverse VCFs, for files too large to load.  Lines
+// are read a block at a time by VcfReader and checked in parallel, each
+// thread counting violations separately before the counts are added up.
+// For every sample:
+//   - GP, unless missing, has nGen(ploidy, nalleles) values summing to one;
+//   - AD, unless missing, has one value per allele;
+//   - GT has ploidy alleles, each an index into REF and ALT, and where GT
+//     and GP are both present, GT is a genotype with the highest GP.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+#include "ploidyverse/genotype_tables.h"
+#include "ploidyverse/threads.h"
+#include "vcf_reader.h"
+
+namespace ploidyverse {
+
+struct VcfValidation {
+  std::size_t nloci;
+  std::size_t malformed;  // records with too few columns or samples
+  std::size_t gpChecked;  // non-missing GP values examined
+  std::size_t gpLength;   // GP with the wrong number of values
+  std::size_t gpSum;      // GP not summing to one, or partly missing
+  std::size_t adChecked;
+  std::size_t adLength;   // AD with the wrong number of values
+  std::size_t gtChecked;
+  std::size_t gtInvalid;  // GT with the wrong ploidy or unknown alleles
+  std::size_t gtArgmax;   // GT that is not a most probable genotype in GP
+  bool hasAD;             // AD in FORMAT of at least one record
+  bool hasGP;
+  std::set<std::string> chroms;
+
+  VcfValidation() : nloci(0), malformed(0), gpChecked(0), gpLength(0), gpSum(0),
+    adChecked(0), adLength(0), gtChecked(0), gtInvalid(0), gtArgmax(0),
+    hasAD(false), hasGP(false) {}
+
+  void add(const VcfValidation& x){
+    nloci += x.nloci;
+    malformed += x.malformed;
+    gpChecked += x.gpChecked;
+    gpLength += x.gpLength;
+    gpSum += x.gpSum;
+    adChecked += x.adChecked;
+    adLength += x.adLength;
+    gtChecked += x.gtChecked;
+    gtInvalid += x.gtInvalid;
+    gtArgmax += x.gtArgmax;
+    hasAD = hasAD || x.hasAD;
+    hasGP = hasGP || x.hasGP;
+    chroms.insert(x.chroms.begin(), x.chroms.end());
+  }
+};
+
+// Working space for checking one record at a time.
+struct VcfValidationBuffers {
+  std::vector<int> keys;
+  std::vector<int> gt;
+  std::vector<int> ad;
+  std::vector<double> gp;
+};
+
+// Check one record, adding to the counts in out.  GP sums may differ from one
+// by up to tolerance.  Genotype fields other than GT, AD, and GP are ignored.
+inline void validateVcfRecord(const std::string& line, int ploidy, int nsam,
+                              double tolerance, VcfValidation& out,
+                              VcfValidationBuffers& buf){
+  const int naInteger = INT_MIN;
+  const double naReal = NAN;
+  const char* p = line.c_str();
+  const char* end = p + line.size();
+  out.nloci++;
+
+  const char* col[9];
+  const char* colEnd[9];
+  int ncol = 0;
+  while(ncol < 9 && p <= end){
+    const char* q = p;
+    while(q < end && *q != '\t') q++;
+    col[ncol] = p;
+    colEnd[ncol] = q;
+    ncol++;
+    p = q + 1;
+  }
+  if(ncol < 8 || (nsam > 0 && ncol < 9)){
+    out.malformed++;
+    return;
+  }
+  if(out.chroms.size() < 100000) out.chroms.insert(std::string(col[0], colEnd[0]));
+  if(nsam == 0) return;
+
+  int nal = 1;
+  if(!(colEnd[4] - col[4] == 1 && *col[4] == '.')){
+    for(const char* c = col[4]; c < colEnd[4]; c++) if(*c == ',') nal++;
+    nal++;
+  }
+  // GP is only checked where the genotypes can be ranked
+  const bool rankable = canRankGenotypes(ploidy, nal - 1) &&
+    countGenotypes(ploidy, nal) <= 10000000ULL;
+  const std::size_t ngen = rankable ? countGenotypes(ploidy, nal) : 0;
+
+  buf.keys.clear();
+  for(const char* k = col[8]; k <= colEnd[8]; ){
+    const char* q = k;
+    while(q < colEnd[8] && *q != ':') q++;
+    int f = vcfFieldIndex(k, q - k);
+    if(f == VCF_AD) out.hasAD = true;
+    if(f == VCF_GP) out.hasGP = true;
+    buf.keys.push_back(f == VCF_GT || f == VCF_AD || (f == VCF_GP && rankable) ? f : -1);
+    k = q + 1;
+  }
+  buf.gt.resize(ploidy);
+  buf.ad.resize(nal);
+  buf.gp.resize(ngen);
+
+  for(int s = 0; s < nsam; s++){
+    if(p > end){
+      out.malformed++;
+      return;
+    }
+    const char* q = p;
+    while(q < end && *q != '\t') q++;
+    const char* sub = p;
+    bool gtComplete = false;
+    bool gpComplete = false;
+    for(std::size_t k = 0; k < buf.keys.size() && sub <= q; k++){
+      const char* subEnd = sub;
+      while(subEnd < q && *subEnd != ':') subEnd++;
+      if(isVcfMissing(sub, subEnd)){
+        sub = subEnd + 1;
+        continue;
+      }
+      switch(buf.keys[k]){
+      case VCF_GT: {
+        int phased;
+        std::fill(buf.gt.begin(), buf.gt.end(), naInteger);
+        out.gtChecked++;
+        if(!parseVcfGenotype(sub, subEnd, buf.gt.data(), ploidy, naInteger, &phased)){
+          out.gtInvalid++;
+          break;
+        }
+        gtComplete = true;
+        for(int i = 0; i < ploidy; i++){
+          if(buf.gt[i] == naInteger){
+            gtComplete = false;
+          } else if(buf.gt[i] < 0 || buf.gt[i] >= nal){
+            out.gtInvalid++;
+            gtComplete = false;
+            break;
+          }
+        }
+        break;
+      }
+      case VCF_AD:
+        std::fill(buf.ad.begin(), buf.ad.end(), naInteger);
+        out.adChecked++;
+        if(!parseVcfList<int>(sub, subEnd, buf.ad.data(), nal, naInteger)){
+          out.adLength++;
+        }
+        break;
+      case VCF_GP: {
+        std::fill(buf.gp.begin(), buf.gp.end(), naReal);
+        out.gpChecked++;
+        if(!parseVcfList<double>(sub, subEnd, buf.gp.data(), ngen, naReal)){
+          out.gpLength++;
+          break;
+        }
+        double total = 0;
+        for(std::size_t g = 0; g < ngen; g++) total += buf.gp[g];
+        // a missing value makes the total NaN, which fails this test
+        if(!(std::fabs(total - 1) <= tolerance)){
+          out.gpSum++;
+        } else {
+          gpComplete = true;
+        }
+        break;
+      }
+      default:
+        break;
+      }
+      sub = subEnd + 1;
+    }
+    if(gtComplete && gpComplete){
+      std::sort(buf.gt.begin(), buf.gt.end());
+      std::size_t index = rankGenotype(buf.gt.data(), ploidy);
+      double best = *std::max_element(buf.gp.begin(), buf.gp.end());
+      if(buf.gp[index] < best) out.gtArgmax++;
+    }
+    p = q + 1;
+  }
+}
+
+// Check the first n of a block of records in parallel, adding to the counts in
+// out.
+inline void validateVcfLines(const std::vector<std::string>& lines, std::size_t n,
+                             int ploidy, int nsam, double tolerance, int nthreads,
+                             VcfValidation& out){
+  const long long nn = n;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount(nthreads))
+#endif
+  {
+    VcfValidation part;
+    VcfValidationBuffers buf;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+    for(long long i = 0; i < nn; i++){
+      validateVcfRecord(lines[i], ploidy, nsam, tolerance, part, buf);
+    }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    {
+      out.add(part);
+    }
+  }
+}
+
+// Check every remaining record of a VCF, reading blockLoci lines at a time.
+inline void validateVcf(VcfReader& reader, std::size_t blockLoci, double tolerance,
+                        int nthreads, VcfValidation& out){
+  const int ploidy = reader.ploidy();
+  const int nsam = reader.samples().size();
+  std::vector<std::string> lines;
+  std::size_t n;
+  while((n = reader.readLines(blockLoci, lines)) > 0){
+    validateVcfLines(lines, n, ploidy, nsam, tolerance, nthreads, out);
+  }
+}
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_VCF_VALIDATOR_H
@@ -0,0 +1,126 @@
+#include <Rcpp.h>
+#include "vcf_writer.h"
+using namespace Rcpp;
+
+// Writing ploidyverse VCFs one block of loci at a time.  The writer is held in
+// an external pointer; the file is finished when vcfWriterClose is called or
+// when the writer is garbage collected.
+
+// Tag for writer handles, checked as for readers in vcf_reader.cpp.
+SEXP vcfWriterTag(){
+  return Rf_install("ploidyverse::VcfWriter");
+}
+
+void checkVcfWriter(SEXP writer){
+  if(TYPEOF(writer) != EXTPTRSXP || R_ExternalPtrTag(writer) != vcfWriterTag()){
+    stop("Not a VCF writer.");
+  }
+}
+
+ploidyverse::VcfWriter* getVcfWriter(SEXP writer){
+  checkVcfWriter(writer);
+  XPtr<ploidyverse::VcfWriter> ptr(writer);
+  if(ptr.get() == NULL) stop("VCF writer has been closed.");
+  return ptr.get();
+}
+
+// Open file for writing and write the header, given as lines without the
+// trailing newline.  If bgzf is true, the output is compressed as BGZF at the
+// given zlib compression level.
+// [[Rcpp::export]]
+SEXP vcfWriterOpen(std::string file, std::vector<std::string> header,
+                   bool bgzf = false, int level = 6, int nthreads = 1){
+  if(level < 0 || level > 9) stop("level must be from 0 to 9.");
+  ploidyverse::VcfWriter* vcf = new ploidyverse::VcfWriter(file, bgzf, level);
+  XPtr<ploidyverse::VcfWriter> ptr(vcf, true, vcfWriterTag());
+  vcf->writeHeader(header, nthreads);
+  return ptr;
+}
+
+// Check that a field has the expected length, returning NULL if it was not
+// supplied.
+template <int RTYPE>
+const typename traits::storage_type<RTYPE>::type*
+fieldPointer(SEXP x, std::size_t expected, const char* name){
+  if(Rf_isNull(x)) return NULL;
+  if(TYPEOF(x) != RTYPE) stop(std::string(name) + " has the wrong type.");
+  if((std::size_t)XLENGTH(x) != expected){
+    stop(std::string(name) + " does not match the number of loci, samples, and alleles.");
+  }
+  Vector<RTYPE> v(x);
+  return v.begin();
+}
+
+// Write a block of loci.  GT is an integer array of allele x sample x locus;
+// phased and PS have one value per sample and locus, with samples varying
+// fastest; AD, GP, and GN are flat vectors with values varying fastest, then
+// samples, then loci.  Any of the genotype fields may be NULL to leave it
+// out.  GP may be numeric or quantized (raw).  GP and GN are rounded to digits
+// decimal places.
+// [[Rcpp::export]]
+void vcfWriteChunk(SEXP writer, std::vector<std::string> chrom, IntegerVector pos,
+                   std::vector<std::string> id, std::vector<std::string> ref,
+                   std::vector<std::string> alt, IntegerVector nalleles,
+                   int nsamples, int ploidy, SEXP GT = R_NilValue,
+                   SEXP phased = R_NilValue, SEXP AD = R_NilValue,
+                   SEXP GP = R_NilValue, SEXP GN = R_NilValue,
+                   SEXP PS = R_NilValue, int digits = 3, int nthreads = 1){
+  ploidyverse::VcfWriter* vcf = getVcfWriter(writer);
+  std::size_t nloci = pos.size();
+  if(chrom.size() != nloci || id.size() != nloci || ref.size() != nloci ||
+     alt.size() != nloci || (std::size_t)nalleles.size() != nloci){
+    stop("CHROM, POS, ID, REF, ALT, and nalleles must all have one value per locus.");
+  }
+  if(digits < 0 || digits > 15) stop("digits must be from 0 to 15.");
+  if(ploidy < 1) stop("Ploidy must be at least 1.");
+  std::size_t nad = 0, ngp = 0, ngn = 0;
+  for(std::size_t L = 0; L < nloci; L++){
+    if(nalleles[L] < 1) stop("Each locus must have at least one allele.");
+    nad += nalleles[L];
+    ngp += ploidyverse::countGenotypes(ploidy, nalleles[L]);
+    ngn += nalleles[L] - 1;
+  }
+  std::size_t ncells = nloci * nsamples;
+
+  ploidyverse::VcfBlock block;
+  block.nloci = nloci;
+  block.nsamples = nsamples;
+  block.ploidy = ploidy;
+  block.chrom = chrom.data();
+  block.pos = pos.begin();
+  block.id = id.data();
+  block.ref = ref.data();
+  block.alt = alt.data();
+  block.nalleles = nalleles.begin();
+  block.gt = fieldPointer<INTSXP>(GT, ncells * ploidy, "GT");
+  block.phased = fieldPointer<LGLSXP>(phased, ncells, "phased");
+  block.ad = fieldPointer<INTSXP>(AD, nad * nsamples, "AD");
+  if(!Rf_isNull(GP) && TYPEOF(GP) == RAWSXP){
+    const unsigned char* raw =
+      fieldPointer<RAWSXP>(GP, ngp * nsamples * sizeof(ploidyverse::QuantizedProb), "GP");
+    block.gpq = reinterpret_cast<const ploidyverse::QuantizedProb*>(raw);
+  } else {
+    block.gp = fieldPointer<REALSXP>(GP, ngp * nsamples, "GP");
+  }
+  block.gn = fieldPointer<REALSXP>(GN, ngn * nsamples, "GN");
+  block.ps = fieldPointer<INTSXP>(PS, ncells, "PS");
+  vcf->writeBlock(block, digits, NA_INTEGER, nthreads);
+}
+
+// Finish and close the file.
+// [[Rcpp::export]]
+void vcfWriterClose(SEXP writer){
+  checkVcfWriter(writer);
+  XPtr<ploidyverse::VcfWriter> ptr(writer);
+  if(ptr.get() != NULL){
+    ploidyverse::VcfWriter* vcf = ptr.get();
+    R_ClearExternalPtr(writer);
+    try {
+      vcf->close();
+    } catch(...) {
+      delete vcf;
+      throw;
+    }
+    delete vcf;
+  }
+}
@@ -0,0 +1,350 @@
+#ifndef PLOIDYVERSE_VCF_WRITER_H
+#define PLOIDYVERSE_VCF_WRITER_H
+
+// A writer for ploidyverse VCFs.  Genotype fields are taken from flat buffers
+// in the same layout that VcfReader produces (values varying fastest, then
+// samples, then loci).  Each block of loci is formatted into text by several
+// threads at once, each filling its own buffer, and the buffers are written
+// in order, either as plain text or as BGZF (blocked gzip, readable by gzip
+// and indexable by tabix).  Numbers are formatted by hand into fixed-size
+// character buffers, without allocation or locale lookups.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bgzf.h"
+#include "ploidyverse/genotype_tables.h"
+#include "ploidyverse/quantized_gp.h"
+#include "ploidyverse/threads.h"
+
+namespace ploidyverse {
+
+// Write a non-negative integer to buf, returning the number of characters.
+inline int formatUnsigned(unsigned long long x, char* buf){
+  char tmp[24];
+  int n = 0;
+  do {
+    tmp[n++] = '0' + (char)(x % 10);
+    x /= 10;
+  } while(x > 0);
+  for(int i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+  return n;
+}
+
+// Write an integer to buf, with "." for na.
+inline int formatInt(int x, int na, char* buf){
+  if(x == na){
+    buf[0] = '.';
+    return 1;
+  }
+  if(x < 0){
+    buf[0] = '-';
+    return 1 + formatUnsigned(-(long long)x, buf + 1);
+  }
+  return formatUnsigned(x, buf);
+}
+
+// Write x rounded to the given number of decimal places (at most 15), without
+// trailing zeros, e.g. 0.25 and 1 rather than 0.250 and 1.000.  Missing or
+// infinite values are written as ".".  buf must hold at least 40 characters;
+// larger values fall back to %g.
+inline int formatFixed(double x, int digits, char* buf){
+  static const double scales[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+                                 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  if(!std::isfinite(x)){
+    buf[0] = '.';
+    return 1;
+  }
+  double scaled = std::fabs(x) * scales[digits];
+  if(scaled >= 9e15) return std::snprintf(buf, 40, "%g", x);
+  unsigned long long r = (unsigned long long)(scaled + 0.5);
+  const unsigned long long scale = (unsigned long long)scales[digits];
+  int n = 0;
+  if(x < 0 && r > 0) buf[n++] = '-';
+  n += formatUnsigned(r / scale, buf + n);
+  unsigned long long frac = r % scale;
+  if(frac > 0){
+    int d = digits;
+    while(frac % 10 == 0){
+      frac /= 10;
+      d--;
+    }
+    buf[n++] = '.';
+    int len = formatUnsigned(frac, buf + n + d);
+    // pad with leading zeros, then move the digits into place
+    for(int i = 0; i < d - len; i++) buf[n + i] = '0';
+    for(int i = 0; i < len; i++) buf[n + d - len + i] = buf[n + d + i];
+    n += d;
+  }
+  return n;
+}
+
+// Write a quantized probability, exactly, with "." if missing.  Fewer than
+// three digits means rounding further.
+inline int formatQuantized(QuantizedProb q, int digits, char* buf){
+  if(q == quantizedMissing){
+    buf[0] = '.';
+    return 1;
+  }
+  if(digits < 3) return formatFixed(probValue(q), digits, buf);
+  int n = formatUnsigned(q / quantizedSteps, buf);
+  int frac = q % quantizedSteps;
+  if(frac > 0){
+    buf[n++] = '.';
+    for(int div = quantizedSteps / 10; frac > 0; div /= 10){
+      buf[n++] = '0' + (char)(frac / div);
+      frac %= div;
+    }
+  }
+  return n;
+}
+
+// Flat genotype data for one block of loci, any of which may be NULL.  GP
+// may be given as doubles (gp) or quantized (gpq).
+struct VcfBlock {
+  std::size_t nloci;
+  int nsamples;
+  int ploidy;
+  const std::string* chrom;
+  const int* pos;
+  const std::string* id;
+  const std::string* ref;
+  const std::string* alt;
+  const int* nalleles;
+  const int* gt;
+  const int* phased; // one per sample and locus, samples fastest
+  const int* ad;
+  const double* gp;
+  const QuantizedProb* gpq;
+  const double* gn;
+  const int* ps;
+
+  VcfBlock() : nloci(0), nsamples(0), ploidy(0), chrom(NULL), pos(NULL), id(NULL),
+    ref(NULL), alt(NULL), nalleles(NULL), gt(NULL), phased(NULL), ad(NULL),
+    gp(NULL), gpq(NULL), gn(NULL), ps(NULL) {}
+};
+
+// Append the text of loci [first, last) of a block to out.  Offsets give the
+// start of each locus in the AD, GP, and GN buffers.
+inline void formatVcfRecords(const VcfBlock& b, std::size_t first, std::size_t last,
+                             const std::vector<std::size_t>& adOffset,
+                             const std::vector<std::size_t>& gpOffset,
+                             const std::vector<std::size_t>& gnOffset,
+                             int digits, int naInteger, std::string& out){
+  char num[48];
+  std::string format;
+  if(b.gt != NULL) format += "GT:";
+  if(b.ad != NULL) format += "AD:";
+  if(b.gp != NULL || b.gpq != NULL) format += "GP:";
+  if(b.gn != NULL) format += "GN:";
+  if(b.ps != NULL) format += "PS:";
+  if(!format.empty()) format.resize(format.size() - 1);
+
+  for(std::size_t L = first; L < last; L++){
+    const int nal = b.nalleles[L];
+    const std::size_t ngen = countGenotypes(b.ploidy, nal);
+    out += b.chrom[L];
+    out += '\t';
+    out.append(num, formatInt(b.pos[L], naInteger, num));
+    out += '\t';
+    out += b.id[L];
+    out += '\t';
+    out += b.ref[L];
+    out += '\t';
+    out += b.alt[L];
+    out += "\t.\t.\t.";
+    if(b.nsamples > 0){
+      out += '\t';
+      out += format;
+    }
+    for(int s = 0; s < b.nsamples; s++){
+      const std::size_t cell = L * b.nsamples + s;
+      bool firstField = true;
+      out += '\t';
+      if(b.gt != NULL){
+        const int* g = b.gt + cell * b.ploidy;
+        char sep = b.phased != NULL && b.phased[cell] ? '|' : '/';
+        for(int i = 0; i < b.ploidy; i++){
+          if(i > 0) out += sep;
+          out.append(num, formatInt(g[i], naInteger, num));
+        }
+        firstField = false;
+      }
+      if(b.ad != NULL){
+        if(!firstField) out += ':';
+        const int* a = b.ad + adOffset[L] + (std::size_t)s * nal;
+        for(int i = 0; i < nal; i++){
+          if(i > 0) out += ',';
+          out.append(num, formatInt(a[i], naInteger, num));
+        }
+        firstField = false;
+      }
+      if(b.gp != NULL){
+        if(!firstField) out += ':';
+        const double* p = b.gp + gpOffset[L] + s * ngen;
+        for(std::size_t i = 0; i < ngen; i++){
+          if(i > 0) out += ',';
+          out.append(num, formatFixed(p[i], digits, num));
+        }
+        firstField = false;
+      }
+      if(b.gpq != NULL){
+        if(!firstField) out += ':';
+        const QuantizedProb* p = b.gpq + gpOffset[L] + s * ngen;
+        for(std::size_t i = 0; i < ngen; i++){
+          if(i > 0) out += ',';
+          out.append(num, formatQuantized(p[i], digits, num));
+        }
+        firstField = false;
+      }
+      if(b.gn != NULL){
+        if(!firstField) out += ':';
+        const double* p = b.gn + gnOffset[L] + (std::size_t)s * (nal - 1);
+        if(nal < 2) out += '.';
+        for(int i = 0; i < nal - 1; i++){
+          if(i > 0) out += ',';
+          out.append(num, formatFixed(p[i], digits, num));
+        }
+        firstField = false;
+      }
+      if(b.ps != NULL){
+        if(!firstField) out += ':';
+        out.append(num, formatInt(b.ps[cell], naInteger, num));
+      }
+    }
+    out += '\n';
+  }
+}
+
+class VcfWriter {
+public:
+  VcfWriter(const std::string& file, bool bgzf, int level)
+    : bgzf_(bgzf), level_(level) {
+    fp_ = std::fopen(file.c_str(), "wb");
+    if(fp_ == NULL) throw std::runtime_error("Unable to open " + file);
+  }
+
+  ~VcfWriter(){
+    if(fp_ != NULL){
+      try {
+        close();
+      } catch(...) {}
+    }
+  }
+
+  bool isOpen() const { return fp_ != NULL; }
+
+  // Write header lines, each without its trailing newline.
+  void writeHeader(const std::vector<std::string>& lines, int nthreads){
+    std::string text;
+    for(std::size_t i = 0; i < lines.size(); i++){
+      text += lines[i];
+      text += '\n';
+    }
+    std::vector<std::string> parts(1, text);
+    writeParts(parts, nthreads);
+  }
+
+  // Format and write a block of loci.  The block is divided into ranges of
+  // loci that are formatted in parallel, and then written in order.
+  void writeBlock(const VcfBlock& b, int digits, int naInteger, int nthreads){
+    std::vector<std::size_t> adOffset(b.nloci + 1, 0);
+    std::vector<std::size_t> gpOffset(b.nloci + 1, 0);
+    std::vector<std::size_t> gnOffset(b.nloci + 1, 0);
+    for(std::size_t L = 0; L < b.nloci; L++){
+      const int nal = b.nalleles[L];
+      adOffset[L + 1] = adOffset[L] + (std::size_t)nal * b.nsamples;
+      gpOffset[L + 1] = gpOffset[L] + countGenotypes(b.ploidy, nal) * b.nsamples;
+      gnOffset[L + 1] = gnOffset[L] + (std::size_t)(nal - 1) * b.nsamples;
+    }
+
+    const int nt = threadCount(nthreads);
+    const long long nparts = std::min<std::size_t>(b.nloci, (std::size_t)nt * 4);
+    std::vector<std::string> parts(nparts);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic, 1)
+#endif
+    for(long long i = 0; i < nparts; i++){
+      std::size_t first = b.nloci * i / nparts;
+      std::size_t last = b.nloci * (i + 1) / nparts;
+      formatVcfRecords(b, first, last, adOffset, gpOffset, gnOffset, digits,
+                       naInteger, parts[i]);
+    }
+    writeParts(parts, nthreads);
+  }
+
+  // Finish the file, adding the BGZF end-of-file marker if needed.
+  void close(){
+    if(fp_ == NULL) return;
+    bool eofWritten = true;
+    if(bgzf_){
+      static const unsigned char eofBlock[28] = {
+        0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0, 'B', 'C', 2, 0,
+        0x1b, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+      eofWritten = std::fwrite(eofBlock, 1, sizeof(eofBlock), fp_) ==
+        sizeof(eofBlock);
+    }
+    int err = std::fclose(fp_);
+    fp_ = NULL;
+    if(!eofWritten) throw std::runtime_error("Error writing VCF.");
+    if(err != 0) throw std::runtime_error("Error closing VCF.");
+  }
+
+private:
+  VcfWriter(const VcfWriter&);
+  VcfWriter& operator=(const VcfWriter&);
+
+  // Write text in order.  For BGZF, the text is cut into blocks that are
+  // compressed in parallel.
+  void writeParts(const std::vector<std::string>& parts, int nthreads){
+    if(fp_ == NULL) throw std::runtime_error("VCF writer has been closed.");
+    if(!bgzf_){
+      for(std::size_t i = 0; i < parts.size(); i++){
+        write(parts[i].data(), parts[i].size());
+      }
+      return;
+    }
+    std::string text;
+    for(std::size_t i = 0; i < parts.size(); i++) text += parts[i];
+    const long long nblocks = (text.size() + bgzfBlockData - 1) / bgzfBlockData;
+    std::vector<std::string> blocks(nblocks);
+    int failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threadCount(nthreads)) schedule(dynamic, 1)
+#endif
+    for(long long i = 0; i < nblocks; i++){
+      std::size_t start = i * bgzfBlockData;
+      std::size_t len = std::min(bgzfBlockData, text.size() - start);
+      try {
+        bgzfCompressBlock(text.data() + start, len, level_, blocks[i]);
+      } catch(...) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+        failed = 1;
+      }
+    }
+    if(failed) throw std::runtime_error("Error compressing VCF.");
+    for(long long i = 0; i < nblocks; i++){
+      write(blocks[i].data(), blocks[i].size());
+    }
+  }
+
+  void write(const char* data, std::size_t len){
+    if(std::fwrite(data, 1, len, fp_) != len){
+      throw std::runtime_error("Error writing VCF.");
+    }
+  }
+
+  std::FILE* fp_;
+  bool bgzf_;
+  int level_;
+};
+
+} // namespace ploidyverse
+
+#endif // PLOIDYVERSE_VCF_WRITER_H